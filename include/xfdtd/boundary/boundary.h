@@ -11,6 +11,8 @@ namespace xfdtd {
 
 class Corrector;
 
+class Checkpoint;
+
 class XFDTDBoundaryException : public XFDTDException {
  public:
   explicit XFDTDBoundaryException(
@@ -43,6 +45,16 @@ class Boundary {
   virtual std::unique_ptr<Corrector> generateDomainCorrector(
       const Task<std::size_t>& task) = 0;
 
+  /**
+   * @brief Add the state that changes during the run to `checkpoint`, with
+   * names starting with `prefix`. The default has no state.
+   */
+  virtual auto saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void;
+
+  virtual auto loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void;
+
  protected:
   void defaultInit(std::shared_ptr<const GridSpace> grid_space,
                    std::shared_ptr<CalculationParam> calculation_param,
@@ -67,6 +67,12 @@ class PML : public Boundary {
   std::unique_ptr<Corrector> generateDomainCorrector(
       const Task<std::size_t>& task) override;
 
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
   auto task() const -> IndexTask {
     return _pml_global_task;
   }
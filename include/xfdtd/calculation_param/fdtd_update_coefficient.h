@@ -6,10 +6,30 @@
 #include "xfdtd/electromagnetic_field/electromagnetic_field.h"
 #include "xfdtd/util/transform.h"
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 namespace xfdtd {
 
 class FDTDUpdateCoefficient {
  public:
+  /**
+   * @brief Index into the coefficient table of a field component in the
+   * compressed mode.
+   */
+  using ClassIndex = std::uint16_t;
+
+  /**
+   * @brief Coefficients of one node: the field itself, the dual field along
+   * the tangential a axis and along the tangential b axis.
+   */
+  struct ClassCoefficient {
+    Real _c;
+    Real _c_a;
+    Real _c_b;
+  };
+
   template <EMF::Attribute c, Axis::XYZ xyz>
   auto coeff() const -> const Array3D<Real>&;
 
@@ -26,6 +46,37 @@ class FDTDUpdateCoefficient {
 
   auto save(const std::string& dir) const -> void;
 
+  /**
+   * @brief Replace the 18 coefficient grids by a class index grid and a small
+   * table of distinct coefficients for each field component. Call it after all
+   * coefficients are corrected, coeff() is empty afterwards.
+   *
+   * @return false if a component has more classes than ClassIndex can address.
+   * Nothing is changed in that case.
+   */
+  auto compress() -> bool;
+
+  auto compressed() const { return _compressed; }
+
+  template <EMF::Attribute c, Axis::XYZ xyz>
+  auto classIndex() const -> const Array3D<ClassIndex>&;
+
+  template <EMF::Attribute c, Axis::XYZ xyz>
+  auto classTable() const -> const std::vector<ClassCoefficient>&;
+
+  /**
+   * @brief Coefficients of node (i, j, k) in either mode.
+   */
+  template <EMF::Attribute c, Axis::XYZ xyz>
+  auto at(Index i, Index j, Index k) const -> ClassCoefficient;
+
+  /**
+   * @brief Call f on every per-node grid: the 18 coefficient grids, or the 6
+   * class index grids if compressed.
+   */
+  template <typename F>
+  auto forEachGrid(F&& f) -> void;
+
  public:
   const Array3D<Real>& cexe() const;
 
@@ -119,6 +170,26 @@ class FDTDUpdateCoefficient {
   Array3D<Real> _chzh;
   Array3D<Real> _chzex;
   Array3D<Real> _chzey;
+
+  bool _compressed{false};
+  std::array<Array3D<ClassIndex>, 6> _class_index;
+  std::array<std::vector<ClassCoefficient>, 6> _class_table;
+
+  template <EMF::Attribute c, Axis::XYZ xyz>
+  static constexpr auto componentIndex() -> std::size_t {
+    constexpr std::size_t offset = c == EMF::Attribute::E ? 0 : 3;
+    if constexpr (xyz == Axis::XYZ::X) {
+      return offset;
+    } else if constexpr (xyz == Axis::XYZ::Y) {
+      return offset + 1;
+    } else {
+      return offset + 2;
+    }
+  }
+
+  template <EMF::Attribute c, Axis::XYZ xyz>
+  auto compressComponent(Array3D<ClassIndex>& index,
+                         std::vector<ClassCoefficient>& table) const -> bool;
 };
 
 template <EMF::Attribute c, Axis::XYZ xyz>
@@ -193,6 +264,48 @@ auto FDTDUpdateCoefficient::coeff() -> Array3D<Real>& {
           ->coeff<a, xyz_a, b, xyz_b>());
 }
 
+template <EMF::Attribute c, Axis::XYZ xyz>
+inline auto FDTDUpdateCoefficient::classIndex() const
+    -> const Array3D<ClassIndex>& {
+  return _class_index[componentIndex<c, xyz>()];
+}
+
+template <EMF::Attribute c, Axis::XYZ xyz>
+inline auto FDTDUpdateCoefficient::classTable() const
+    -> const std::vector<ClassCoefficient>& {
+  return _class_table[componentIndex<c, xyz>()];
+}
+
+template <EMF::Attribute c, Axis::XYZ xyz>
+inline auto FDTDUpdateCoefficient::at(Index i, Index j, Index k) const
+    -> ClassCoefficient {
+  if (_compressed) {
+    return classTable<c, xyz>()[classIndex<c, xyz>()(i, j, k)];
+  }
+
+  constexpr auto dual = EMF::dualAttribute(c);
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+  return {coeff<c, xyz>()(i, j, k), coeff<c, xyz, dual, xyz_a>()(i, j, k),
+          coeff<c, xyz, dual, xyz_b>()(i, j, k)};
+}
+
+template <typename F>
+inline auto FDTDUpdateCoefficient::forEachGrid(F&& f) -> void {
+  if (_compressed) {
+    for (auto&& index : _class_index) {
+      f(index);
+    }
+    return;
+  }
+
+  for (auto* arr : {&_cexe, &_cexhy, &_cexhz, &_ceye, &_ceyhz, &_ceyhx,
+                    &_ceze, &_cezhx, &_cezhy, &_chxh, &_chxey, &_chxez,
+                    &_chyh, &_chyez, &_chyex, &_chzh, &_chzex, &_chzey}) {
+    f(*arr);
+  }
+}
+
 }  // namespace xfdtd
 
 #endif  // __XFDTD_CORE_FDTD_UPDATE_COEFFICIENT_H__
@@ -100,6 +100,14 @@ class MaterialParam {
 
   void allocate(std::size_t nx, std::size_t ny, std::size_t nz);
 
+  /**
+   * @brief Free the per-node grids once the update coefficients no longer need
+   * them. The material array is kept.
+   */
+  auto release() -> void;
+
+  auto released() const { return _released; }
+
  private:
   Array3D<Real> _eps_x;
   Array3D<Real> _eps_y;
@@ -115,6 +123,8 @@ class MaterialParam {
   Array3D<Real> _sigma_m_z;
 
   std::vector<std::shared_ptr<Material>> _materials;
+
+  bool _released{false};
 };
 
 inline const auto& MaterialParam::materialArray() const { return _materials; }
@@ -50,6 +50,11 @@ class TimeParam {
   void setTimeParamRunRange(std::size_t end_time_step,
                             std::size_t start_time_step = 0);
 
+  /**
+   * @brief Continue from `time_step` of the run range, e.g. after a restart.
+   */
+  void setCurrentTimeStep(std::size_t time_step);
+
   Array1D<Real> eTime() const;
 
   Array1D<Real> hTime() const;
@@ -22,6 +22,9 @@ inline constexpr Real NEG_INF{-1 * std::numeric_limits<Real>::infinity()};
 
 constexpr auto II = std::complex<Real>(0.0, 1.0);
 
+// PI of the DFT kernels, which run in the accumulator precision.
+inline constexpr AccReal ACC_PI{std::numbers::pi_v<AccReal>};
+
 }  // namespace xfdtd::constant
 
 #endif  // _XFDTD_CORE_CONSTANT_H_
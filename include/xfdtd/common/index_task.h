@@ -4,6 +4,7 @@
 #include <xfdtd/common/type_define.h>
 
 #include <optional>
+#include <vector>
 
 namespace xfdtd {
 
@@ -119,6 +120,41 @@ inline std::optional<Task<T>> taskIntersection(const Task<T>& task1,
   return Task<T>{x_range, y_range, z_range};
 }
 
+/**
+ * @brief Split the part of `task` outside `hole` into at most six disjoint
+ * boxes.
+ */
+template <typename T>
+inline auto taskDifference(const Task<T>& task,
+                           const Task<T>& hole) -> std::vector<Task<T>> {
+  const auto inner = taskIntersection(task, hole);
+  if (!inner.has_value()) {
+    return {task};
+  }
+
+  const auto x = task.xRange();
+  const auto y = task.yRange();
+  const auto z = task.zRange();
+  const auto ix = inner->xRange();
+  const auto iy = inner->yRange();
+  const auto iz = inner->zRange();
+
+  std::vector<Task<T>> boxes;
+  auto add = [&boxes](const Task<T>& t) {
+    if (t.valid()) {
+      boxes.emplace_back(t);
+    }
+  };
+
+  add(Task<T>{Range<T>{x.start(), ix.start()}, y, z});
+  add(Task<T>{Range<T>{ix.end(), x.end()}, y, z});
+  add(Task<T>{ix, Range<T>{y.start(), iy.start()}, z});
+  add(Task<T>{ix, Range<T>{iy.end(), y.end()}, z});
+  add(Task<T>{ix, iy, Range<T>{z.start(), iz.start()}});
+  add(Task<T>{ix, iy, Range<T>{iz.end(), z.end()}});
+  return boxes;
+}
+
 }  // namespace xfdtd
 
 #endif  // __XFDTD_CORE_INDEX_TASK_H__
@@ -7,12 +7,23 @@
 
 namespace xfdtd {
 
-#if defined XFDTD_CORE_SINGLE_PRECISION
+#if defined XFDTD_CORE_SINGLE_PRECISION || defined XFDTD_CORE_MIXED_PRECISION
 using Real = float;
 #else
 using Real = double;
 #endif
 
+/**
+ * @brief Type of the sums that run over the whole simulation: the NF2FF
+ * surface currents and potentials and the DFTs of ports. The mixed precision
+ * build keeps fields and coefficients in float and these in double.
+ */
+#if defined XFDTD_CORE_MIXED_PRECISION
+using AccReal = double;
+#else
+using AccReal = Real;
+#endif
+
 using Index = std::size_t;
 
 template <typename T>
@@ -18,6 +18,18 @@ class GridSpaceGenerator {
       const std::vector<const Boundary*>& boundaries, Real based_dx,
       Real based_dy, Real based_dz);
 
+  /**
+   * @brief Graded mesh: cells are `min_dl` wide at the faces of the bounding
+   * box of every shape and grow by about `max_ratio` per cell up to
+   * `based_dl`. Every face lies on a node. The faces of the domain itself
+   * don't refine, and the PML is added outside with cells of `based_dl`.
+   */
+  static std::unique_ptr<GridSpace> generateGradedGridSpace(
+      const std::vector<const Shape*>& shapes,
+      const std::vector<const Boundary*>& boundaries, Real based_dx,
+      Real based_dy, Real based_dz, Real min_dx, Real min_dy, Real min_dz,
+      Real max_ratio);
+
  private:
   static std::unique_ptr<Cube> extendDomain(
       std::unique_ptr<Cube> domain,
@@ -35,6 +47,16 @@ class GridSpaceGenerator {
                                                         Real dz);
 
   static GridSpace::Dimension decideDimension(const Shape* shape);
+
+  /**
+   * @brief E nodes of one axis: graded from `start` to `end` around `lines`,
+   * then cells of `based_dl` out to `padded_start` and `padded_end`.
+   */
+  static Array1D<Real> generateGradedNode(Real start, Real end,
+                                          Real padded_start, Real padded_end,
+                                          std::vector<Real> lines,
+                                          Real based_dl, Real min_dl,
+                                          Real max_ratio);
 };
 
 }  // namespace xfdtd
@@ -0,0 +1,160 @@
+#ifndef _XFDTD_CORE_SUBGRID_H_
+#define _XFDTD_CORE_SUBGRID_H_
+
+#include <xfdtd/calculation_param/calculation_param.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/electromagnetic_field/electromagnetic_field.h>
+#include <xfdtd/exception/exception.h>
+#include <xfdtd/grid_space/grid_box.h>
+#include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/object/object.h>
+#include <xfdtd/shape/cube.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xfdtd {
+
+class Checkpoint;
+
+class XFDTDSubgridException : public XFDTDException {
+ public:
+  explicit XFDTDSubgridException(std::string message = "XFDTD Subgrid Exception")
+      : XFDTDException(std::move(message)) {}
+};
+
+/**
+ * @brief A box of the coarse grid refined by `ratio` in space and time.
+ *
+ * The box holds its own Yee grid with cells `ratio` times smaller and runs
+ * `ratio` steps of dt / ratio per coarse step, so both grids keep the same
+ * Courant number. The coarse grid is updated everywhere as before. After its
+ * E update:
+ *
+ * 1. the tangential E on the faces of the fine box is interpolated from the
+ *    coarse E, trilinear in space and linear in time between the last two
+ *    coarse steps;
+ * 2. the fine grid runs its `ratio` steps;
+ * 3. the coarse E strictly inside the box is replaced by the average of the
+ *    fine E on the same edge.
+ *
+ * The material of the fine grid is sampled from the objects of the
+ * simulation at every fine edge and face center, the last object that
+ * contains the point wins, as in the coarse grid. Only non-dispersive
+ * materials are supported. Lumped elements, sources and monitors act on the
+ * coarse grid only, so the box should hold geometry and stay away from them,
+ * from the PML and from the TFSF surface; Simulation::init() checks it.
+ */
+class Subgrid {
+ public:
+  /**
+   * @brief Refine `region`, snapped outwards to the coarse cells.
+   */
+  Subgrid(std::string name, std::unique_ptr<Cube> region, Index ratio);
+
+  /**
+   * @brief Refine the bounding box of `object` and `margin` coarse cells
+   * around it.
+   */
+  Subgrid(std::string name, const Object& object, Index ratio,
+          Index margin = 2);
+
+  Subgrid(const Subgrid&) = delete;
+
+  Subgrid& operator=(const Subgrid&) = delete;
+
+  ~Subgrid() = default;
+
+  auto name() const -> const std::string& { return _name; }
+
+  auto ratio() const { return _ratio; }
+
+  /**
+   * @brief The coarse cells of the box. Valid after init().
+   */
+  auto box() const -> const GridBox& { return _box; }
+
+  auto init(std::shared_ptr<const GridSpace> grid_space,
+            std::shared_ptr<CalculationParam> calculation_param,
+            std::shared_ptr<EMF> emf,
+            const std::vector<std::shared_ptr<Object>>& objects) -> void;
+
+  /**
+   * @brief Advance the fine grid by one coarse step. Called after the coarse E
+   * update.
+   */
+  auto correctE() -> void;
+
+  auto hx() const -> const Array3D<Real>& { return _hx; }
+
+  auto hy() const -> const Array3D<Real>& { return _hy; }
+
+  auto hz() const -> const Array3D<Real>& { return _hz; }
+
+  auto ex() const -> const Array3D<Real>& { return _ex; }
+
+  auto ey() const -> const Array3D<Real>& { return _ey; }
+
+  auto ez() const -> const Array3D<Real>& { return _ez; }
+
+  auto toString() const -> std::string;
+
+  /**
+   * @brief Save the fine fields and the coarse E the boundary interpolated in
+   * the last step.
+   */
+  auto saveState(Checkpoint& checkpoint, const std::string& prefix) const
+      -> void;
+
+  auto loadState(const Checkpoint& checkpoint, const std::string& prefix)
+      -> void;
+
+ private:
+  // A tangential E node on a face of the fine box and the coarse E it is
+  // interpolated from
+  struct BoundaryNode {
+    Real* _fine;
+    const Array3D<Real>* _coarse;
+    Index _i, _j, _k;
+    Real _wx, _wy, _wz;
+    Real _old, _new;
+  };
+
+  std::string _name;
+  std::unique_ptr<Cube> _region;
+  Index _ratio;
+  Index _margin;
+
+  std::shared_ptr<EMF> _emf;
+  GridBox _box;
+  Index _nx{0}, _ny{0}, _nz{0};
+  Real _dx{0}, _dy{0}, _dz{0};
+
+  Array3D<Real> _ex, _ey, _ez, _hx, _hy, _hz;
+  // E = c_e * E + c_eh * curl H, H = c_h * H + c_he * curl E
+  Array3D<Real> _cexe, _cexh, _ceye, _ceyh, _ceze, _cezh;
+  Array3D<Real> _chxh, _chxe, _chyh, _chye, _chzh, _chze;
+
+  std::vector<BoundaryNode> _boundary;
+
+  auto allocate() -> void;
+
+  auto sampleMaterial(const GridSpace& grid_space,
+                      const std::vector<std::shared_ptr<Object>>& objects,
+                      Real dt) -> void;
+
+  auto collectBoundary() -> void;
+
+  auto interpolate(const BoundaryNode& node) const -> Real;
+
+  auto updateH() -> void;
+
+  auto updateE() -> void;
+
+  auto restrictE() -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // _XFDTD_CORE_SUBGRID_H_
@@ -5,11 +5,57 @@
 #include <xfdtd/coordinate_system/coordinate_system.h>
 #include <xfdtd/material/dispersive_material.h>
 
+#include <array>
+#include <string>
+#include <vector>
+
 namespace xfdtd {
 
+class Checkpoint;
+
+/**
+ * @brief ADE coefficients of one material, written in the modified Lorentz
+ * form. Drude and Debye media leave the E^{n-1} and J^{n-1} terms zero.
+ *
+ * J_p^{n+1} = j_e_n E^{n+1} + j_e E^n + j_e_p E^{n-1} + j_j J_p^n +
+ *             j_j_p J_p^{n-1}
+ * E^{n+1} = cece E^n + ceh curl(H) + e_e_p E^{n-1} +
+ *           e_j_sum sum_p(j_sum_j J_p^n + j_sum_j_p J_p^{n-1})
+ *
+ * with cecha = -ceh / db and cechb = ceh / da. The modified Lorentz form
+ * keeps ceh = 1 / ceh_den and uses cecha = -1 / (ceh_den * db), cechb =
+ * 1 / (ceh_den * da), so its E coefficients round as they always did.
+ */
+struct ADEMaterialCoefficient {
+  Real _cece{}, _ceh{};
+  Real _ceh_den{};
+  Real _coeff_e_j_sum{}, _coeff_e_e_p{};
+  std::vector<Real> _coeff_j_e_n, _coeff_j_e, _coeff_j_e_p, _coeff_j_j,
+      _coeff_j_j_p, _coeff_j_sum_j, _coeff_j_sum_j_p;
+};
+
 class ADEMethodStorage {
  public:
-  ADEMethodStorage(Index num_pole);
+  /**
+   * @brief Dispersive cells of one E component in sparse mode, as a structure
+   * of arrays. The node of cell c is (_i[c], _j[c], _k[c]), its pole currents
+   * are at [c * numPole(), (c + 1) * numPole()) of `_j_pole` and
+   * `_j_pole_prev`.
+   */
+  struct SparseCells {
+    std::vector<Index> _i, _j, _k;
+    std::vector<std::size_t> _material;  // row of sparseCoeff()
+    std::vector<Real> _e_prev, _e_cur, _e_extra;
+    std::vector<Real> _j_pole, _j_pole_prev;
+
+    auto size() const { return _i.size(); }
+  };
+
+  /**
+   * @param sparse keep the state of the dispersive cells only. The dense
+   * per-node arrays stay empty.
+   */
+  explicit ADEMethodStorage(Index num_pole, bool sparse = false);
 
   virtual ~ADEMethodStorage() = default;
 
@@ -23,6 +69,35 @@ class ADEMethodStorage {
 
   auto numPole() const { return _num_pole; }
 
+  auto sparse() const { return _sparse; }
+
+  /**
+   * @brief Coefficients of a material supported by this method.
+   */
+  virtual auto coefficient(
+      const LinearDispersiveMaterial& linear_dispersive_material,
+      Real dt) const -> ADEMaterialCoefficient = 0;
+
+  /**
+   * @brief Sparse mode: add the cell (i, j, k) filled with material
+   * `material_index` to the lists of the E components updated there.
+   */
+  auto addSparseCell(Index i, Index j, Index k, Index material_index,
+                     const LinearDispersiveMaterial& linear_dispersive_material,
+                     Real dt) -> void;
+
+  auto& sparseCoeff() const { return _sparse_coeff; }
+
+  template <Axis::XYZ xyz>
+  auto& sparseCells() {
+    return _sparse_cells[static_cast<std::size_t>(xyz)];
+  }
+
+  template <Axis::XYZ xyz>
+  auto& sparseCells() const {
+    return _sparse_cells[static_cast<std::size_t>(xyz)];
+  }
+
   auto& coeffJJ() { return _coeff_j_j; }
 
   auto& coeffJJ() const { return _coeff_j_j; }
@@ -146,6 +221,16 @@ class ADEMethodStorage {
     }
   }
 
+  /**
+   * @brief Add the previous E and the polarization currents to `checkpoint`,
+   * with names starting with `prefix`.
+   */
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void;
+
   virtual auto correctCoeff(
       Index i, Index j, Index k,
       const LinearDispersiveMaterial& linear_dispersive_material,
@@ -154,6 +239,7 @@ class ADEMethodStorage {
 
  protected:
   Index _num_pole{};
+  bool _sparse{false};
   Array4D<Real> _coeff_j_j{}, _coeff_j_j_p{}, _coeff_j_e_n{}, _coeff_j_e{},
       _coeff_j_e_p{}, _coeff_j_sum_j{}, _coeff_j_sum_j_p{};
   Array3D<Real> _coeff_e_j_sum{}, _coeff_e_e_p{};
@@ -161,6 +247,22 @@ class ADEMethodStorage {
   Array3D<Real> _ex_prev{}, _ey_prev{}, _ez_prev{};
   Array4D<Real> _jx_arr{}, _jy_arr{}, _jz_arr{}, _jx_prev_arr{}, _jy_prev_arr{},
       _jz_prev_arr{};
+
+  std::vector<Index> _sparse_material;
+  std::vector<ADEMaterialCoefficient> _sparse_coeff;
+  std::array<SparseCells, 3> _sparse_cells;
+
+  auto checkNumPole(
+      const LinearDispersiveMaterial& linear_dispersive_material) const
+      -> void;
+
+  /**
+   * @brief Write the E update coefficients of the node (i, j, k).
+   */
+  static auto correctEUpdateCoeff(
+      Index i, Index j, Index k, const ADEMaterialCoefficient& coeff,
+      const std::shared_ptr<const GridSpace>& grid_space,
+      const std::shared_ptr<CalculationParam>& calculation_param) -> void;
 };
 
 }  // namespace xfdtd
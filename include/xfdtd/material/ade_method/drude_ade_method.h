@@ -7,7 +7,8 @@ namespace xfdtd {
 
 class DrudeADEMethodStorage : public ADEMethodStorage {
  public:
-  DrudeADEMethodStorage(Index num_pole, Index nx, Index ny, Index nz);
+  DrudeADEMethodStorage(Index num_pole, Index nx, Index ny, Index nz,
+                        bool sparse = false);
 
   auto correctCoeff(Index i, Index j, Index k,
                     const LinearDispersiveMaterial& linear_dispersive_material,
@@ -15,6 +16,9 @@ class DrudeADEMethodStorage : public ADEMethodStorage {
                     const std::shared_ptr<CalculationParam>& calculation_param)
       -> void override;
 
+  auto coefficient(const LinearDispersiveMaterial& linear_dispersive_material,
+                   Real dt) const -> ADEMaterialCoefficient override;
+
  private:
 };
 
@@ -36,6 +36,12 @@ class CurrentMonitor : public TimeMonitor {
 
   auto toString() const -> std::string override;
 
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
  private:
   Axis::Direction _direction;
   std::size_t _is, _ie, _js, _je, _ks, _ke;
@@ -44,6 +50,8 @@ class CurrentMonitor : public TimeMonitor {
 
   Array1D<Real> _node_data;
   IndexRange _ha_range_bn, _ha_range_bp, _hb_range_an, _hb_range_ap;
+
+  auto record(Index t, Real value) -> void;
 };
 
 }  // namespace xfdtd
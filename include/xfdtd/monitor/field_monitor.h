@@ -38,11 +38,26 @@ class FieldMonitor : public Monitor {
 
   auto initParallelizedConfig() -> void override;
 
+  /**
+   * @brief The field is only read in output(), so there is nothing to do per
+   * step. A MovieMonitor still uses the shard hooks to copy a frame on all
+   * threads.
+   */
+  auto shardable() const -> bool override { return false; }
+
+  auto initShards(std::size_t num_shards) -> void override;
+
+  auto updateShard(std::size_t shard, const IndexTask& task) -> void override;
+
+  auto reduceShards() -> void override;
+
  protected:
   auto gatherData() -> void override;
 
  private:
   EMF::Field _field;
+  bool _sharded{false};
+  bool _snapshot{false};
 
   std::vector<MpiSupport::Block::Profile> _profiles;
   std::vector<MpiSupport::Block> _blocks_mpi;
@@ -11,11 +11,16 @@
 #include <xfdtd/parallel/parallelized_config.h>
 #include <xfdtd/shape/shape.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 namespace xfdtd {
 
+class Checkpoint;
+
+class AsyncOutputWriter;
+
 class XFDTDMonitorException : public XFDTDException {
  public:
   explicit XFDTDMonitorException(
@@ -46,6 +51,43 @@ class Monitor {
 
   virtual auto initParallelizedConfig() -> void = 0;
 
+  /**
+   * @brief Whether the per step work can be split over the domain threads.
+   * If so, every domain calls updateShard() with its own task and the master
+   * calls reduceShards() once all of them are done, instead of update().
+   */
+  virtual auto shardable() const -> bool;
+
+  /**
+   * @brief Prepare `num_shards` slots for the partial results of the threads.
+   * Called after initTimeDependentVariable().
+   */
+  virtual auto initShards(std::size_t num_shards) -> void;
+
+  /**
+   * @brief Record the part of the monitor inside `task` (node index, the
+   * thread task of domain `shard`). It runs concurrently with the other
+   * shards, so it may only write to its own slot or to cells inside `task`.
+   */
+  virtual auto updateShard(std::size_t shard, const IndexTask& task) -> void;
+
+  /**
+   * @brief Combine the slots in shard order, so the result doesn't depend on
+   * the thread timing. The default does all the work here by calling
+   * update().
+   */
+  virtual auto reduceShards() -> void;
+
+  /**
+   * @brief Add the recorded data to `checkpoint`, with names starting with
+   * `prefix`.
+   */
+  virtual auto saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void;
+
+  virtual auto loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void;
+
   const std::unique_ptr<Shape>& shape() const;
 
   const std::string& name() const;
@@ -64,6 +106,18 @@ class Monitor {
 
   virtual void output();
 
+  /**
+   * @brief Let output() copy the data into a buffer and leave the file to a
+   * background thread, with at most `queue_depth` files waiting. output()
+   * blocks while the queue is full. 0 writes synchronously again.
+   */
+  virtual auto setAsyncOutput(std::size_t queue_depth) -> void;
+
+  /**
+   * @brief Wait until every file of output() is written.
+   */
+  virtual auto flushOutput() -> void;
+
   virtual void initTimeDependentVariable();
 
   GridBox globalGridBox() const;
@@ -135,6 +189,8 @@ class Monitor {
   IndexTask _node_task;
 
   MpiConfig _monitor_mpi_config;
+
+  std::shared_ptr<AsyncOutputWriter> _output_writer;
 };
 
 }  // namespace xfdtd
@@ -32,6 +32,13 @@ class MovieMonitor : public xfdtd::Monitor {
 
   void output() override;
 
+  /**
+   * @brief Frames are written by the frame monitor, so it gets the queue.
+   */
+  auto setAsyncOutput(std::size_t queue_depth) -> void override;
+
+  auto flushOutput() -> void override;
+
   std::size_t frameInterval() const;
 
   std::size_t frameCount() const;
@@ -50,6 +57,23 @@ class MovieMonitor : public xfdtd::Monitor {
 
   auto valid() const -> bool override;
 
+  /**
+   * @brief A frame is copied by all threads, then written by the master.
+   */
+  auto shardable() const -> bool override { return true; }
+
+  auto initShards(std::size_t num_shards) -> void override;
+
+  auto updateShard(std::size_t shard, const IndexTask& task) -> void override;
+
+  auto reduceShards() -> void override;
+
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
  private:
   std::unique_ptr<xfdtd::Monitor> _frame;
 
@@ -3,6 +3,7 @@
 
 #include <xfdtd/monitor/monitor.h>
 
+#include <complex>
 #include <memory>
 #include <string>
 
@@ -21,13 +22,70 @@ class TimeMonitor : public Monitor {
 
   auto time() const -> const Array1D<Real>&;
 
+  /**
+   * @brief Accumulate the DFT at `frequencies` while running, with one complex
+   * multiply per frequency and step. Sample n adds
+   * x(n) * exp(-j 2 pi f (n + 1) dt) * dt, the kernel of dft(). Without
+   * `keep_time_series` the samples aren't stored and output() writes the
+   * frequencies and the real and imaginary part of the DFT instead.
+   */
+  auto enableRunningDFT(Array1D<Real> frequencies,
+                        bool keep_time_series = true) -> void;
+
+  auto runningDFTEnabled() const -> bool {
+    return _dft_frequencies.size() != 0;
+  }
+
+  auto keepTimeSeries() const -> bool { return _keep_time_series; }
+
+  auto dftFrequencies() const -> const Array1D<Real>& {
+    return _dft_frequencies;
+  }
+
+  /**
+   * @brief The DFT of the whole monitor. Set by gatherData() on the root of
+   * the monitor communicator.
+   */
+  auto runningDFT() const -> const Array1D<std::complex<AccReal>>& {
+    return _dft;
+  }
+
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
  protected:
   auto time() -> Array1D<Real>&;
 
   auto setTime(Array1D<Real> time) -> void;
 
+  /**
+   * @brief Zero the running DFT. Called by initTimeDependentVariable().
+   */
+  auto initRunningDFT() -> void;
+
+  /**
+   * @brief Add the sample of time step `t` of this node to the running DFT.
+   */
+  auto accumulateDFT(Index t, Real value) -> void;
+
+  /**
+   * @brief Sum the running DFT of the nodes. Called by gatherData().
+   */
+  auto gatherDFT() -> void;
+
  private:
   Array1D<Real> _time;
+
+  Array1D<Real> _dft_frequencies;
+  bool _keep_time_series{true};
+  Array1D<std::complex<AccReal>> _dft_step;
+  Array1D<std::complex<AccReal>> _dft_kernel;
+  Array1D<std::complex<AccReal>> _node_dft;
+  Array1D<std::complex<AccReal>> _dft;
+  Index _dft_next_step{0};
 };
 
 }  // namespace xfdtd
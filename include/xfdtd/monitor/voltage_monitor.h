@@ -4,6 +4,8 @@
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/monitor/time_monitor.h>
 
+#include <vector>
+
 namespace xfdtd {
 
 class VoltageMonitor : public TimeMonitor {
@@ -35,12 +37,31 @@ class VoltageMonitor : public TimeMonitor {
 
   auto toString() const -> std::string override;
 
+  auto shardable() const -> bool override { return true; }
+
+  auto initShards(std::size_t num_shards) -> void override;
+
+  auto updateShard(std::size_t shard, const IndexTask& task) -> void override;
+
+  auto reduceShards() -> void override;
+
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
  private:
   Axis::Direction _direction;
   std::size_t _is, _ie, _js, _je, _ks, _ke;
   Array1D<Real> _dc, _coff;
 
   Array<Real> _node_data;
+  std::vector<Real> _shard_sum;
+
+  auto integrate(const IndexTask& task) const -> Real;
+
+  auto record(Index t, Real value) -> void;
 };
 
 }  // namespace xfdtd
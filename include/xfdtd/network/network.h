@@ -51,13 +51,22 @@ class Network {
 
   void setOutputDir(std::string output_dir);
 
+  /**
+   * @brief Let the monitors of every port accumulate the DFT at the network
+   * frequencies while running, instead of transforming the whole time series
+   * in output(). Without `keep_time_series` the monitors store no samples.
+   */
+  void enableRunningDFT(bool keep_time_series = false);
+
  private:
   std::vector<std::shared_ptr<Port>> _ports;
   Array1D<Real> _frequencies;
   std::string _output_dir;
+  bool _running_dft{false};
+  bool _keep_time_series{true};
 
   std::set<std::size_t> _port_set;
-  std::unordered_map<int, Array1D<std::complex<Real>>> _s_parameters;
+  std::unordered_map<int, Array1D<std::complex<AccReal>>> _s_parameters;
 };
 
 }  // namespace xfdtd
@@ -42,9 +42,9 @@ class Port {
 
   const std::shared_ptr<VoltageMonitor>& voltageMonitor() const;
 
-  const Array1D<std::complex<Real>>& a() const;
+  const Array1D<std::complex<AccReal>>& a() const;
 
-  const Array1D<std::complex<Real>>& b() const;
+  const Array1D<std::complex<AccReal>>& b() const;
 
   void calculateSParameters(const Array1D<Real>& frequencies);
 
@@ -61,7 +61,7 @@ class Port {
 
   Real _dt;
 
-  Array1D<std::complex<Real>> _a, _b;
+  Array1D<std::complex<AccReal>> _a, _b;
 };
 
 }  // namespace xfdtd
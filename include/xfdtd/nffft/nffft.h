@@ -9,11 +9,14 @@
 #include <xfdtd/grid_space/grid_space.h>
 #include <xfdtd/parallel/mpi_config.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 namespace xfdtd {
 
+class Checkpoint;
+
 class XFDTDNFFFTException : public XFDTDException {
  public:
   explicit XFDTDNFFFTException(const std::string& message)
@@ -47,6 +50,29 @@ class NFFFT {
 
   virtual auto update() -> void = 0;
 
+  /**
+   * @brief Same contract as Monitor::shardable(): if true, every domain calls
+   * updateShard() with its own task and the master then calls reduceShards()
+   * instead of update().
+   */
+  virtual auto shardable() const -> bool;
+
+  virtual auto initShards(std::size_t num_shards) -> void;
+
+  virtual auto updateShard(std::size_t shard, const IndexTask& task) -> void;
+
+  virtual auto reduceShards() -> void;
+
+  /**
+   * @brief Add the accumulated surface data to `checkpoint`, with names
+   * starting with `prefix`. The default has no state.
+   */
+  virtual auto saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void;
+
+  virtual auto loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void;
+
   auto outputDir() const -> std::string;
 
   auto distanceX() const -> Index;
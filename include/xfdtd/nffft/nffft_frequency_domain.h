@@ -8,6 +8,8 @@ namespace xfdtd {
 
 class FDPlaneData;
 
+struct FDSurfaceSample;
+
 class XFDTDNFFFTFrequencyDomainException : public XFDTDNFFFTException {
  public:
   explicit XFDTDNFFFTFrequencyDomainException(const std::string& message)
@@ -32,6 +34,24 @@ class NFFFTFrequencyDomain : public NFFFT {
 
   auto update() -> void override;
 
+  auto shardable() const -> bool override { return true; }
+
+  auto initShards(std::size_t num_shards) -> void override;
+
+  auto updateShard(std::size_t shard, const IndexTask& task) -> void override;
+
+  /**
+   * @brief Nothing to combine: every surface cell has its own DFT entry. Only
+   * moves the DFT kernels to the next step.
+   */
+  auto reduceShards() -> void override;
+
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
   auto processFarField(const Array1D<Real>& theta, Real phi,
                        const std::string& sub_dir,
                        const Vector& origin = Vector{0.0, 0.0,
@@ -42,15 +62,28 @@ class NFFFTFrequencyDomain : public NFFFT {
                        const Vector& origin = Vector{0.0, 0.0,
                                                      0.0}) const -> void;
 
+  /**
+   * @brief The potentials on the full grid theta x phi, e.g. a whole sphere,
+   * for all frequencies in one pass over the surface. The files are named as
+   * in processFarField and hold arrays of shape (theta.size(), phi.size()).
+   *
+   * @param num_thread threads of the evaluation, 0 uses all hardware threads.
+   */
+  auto processFarFieldPattern(const Array1D<Real>& theta,
+                              const Array1D<Real>& phi,
+                              const std::string& sub_dir,
+                              const Vector& origin = Vector{0.0, 0.0, 0.0},
+                              std::size_t num_thread = 0) const -> void;
+
   auto outputRadiationPower() -> void;
 
   template <Axis::Direction D, EMF::Attribute A, Axis::XYZ XYZ>
   auto equivalentSurfaceCurrent(Index freq_index) const
-      -> const Array3D<std::complex<Real>>&;
+      -> const Array3D<std::complex<AccReal>>&;
 
-  auto transformE(Index freq_index) const -> const Array1D<std::complex<Real>>&;
+  auto transformE(Index freq_index) const -> Array1D<std::complex<AccReal>>;
 
-  auto transformH(Index freq_index) const -> const Array1D<std::complex<Real>>&;
+  auto transformH(Index freq_index) const -> Array1D<std::complex<AccReal>>;
 
   auto freqCount() const { return _frequencies.size(); }
 
@@ -58,6 +91,8 @@ class NFFFTFrequencyDomain : public NFFFT {
   Array1D<Real> _frequencies;
 
   std::vector<FDPlaneData> _fd_plane_data;
+  // scratch of every shard, see FDPlaneData::sample()
+  std::vector<FDSurfaceSample> _surface_samples;
 
   auto processFarField(const Array1D<Real>& theta, const Array1D<Real>& phi,
                        const std::string& sub_dir,
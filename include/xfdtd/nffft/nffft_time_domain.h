@@ -22,6 +22,8 @@ class TDPlaneData;
 /**
  * @brief Near Field Far Field Transform in Time Domain
  *
+ * Observes one direction, or a list of (theta(d), phi(d)) directions. The
+ * surface is interpolated once per step for all of them.
  */
 class NFFFTTimeDomain : public NFFFT {
  public:
@@ -31,6 +33,17 @@ class NFFFTTimeDomain : public NFFFT {
   NFFFTTimeDomain(Index distance_x, Index distance_y, Index distance_z,
                   std::string_view output_dir, Real theta, Real phi);
 
+  /**
+   * @brief Observe the directions (theta(d), phi(d)). theta and phi must have
+   * the same, non-zero size.
+   */
+  NFFFTTimeDomain(Index distance_x, Index distance_y, Index distance_z,
+                  Array1D<Real> theta, Array1D<Real> phi);
+
+  NFFFTTimeDomain(Index distance_x, Index distance_y, Index distance_z,
+                  std::string_view output_dir, Array1D<Real> theta,
+                  Array1D<Real> phi);
+
   ~NFFFTTimeDomain() override;
 
   auto init(std::shared_ptr<const GridSpace> grid_space,
@@ -41,33 +54,56 @@ class NFFFTTimeDomain : public NFFFT {
 
   auto update() -> void override;
 
+  auto shardable() const -> bool override { return true; }
+
+  auto initShards(std::size_t num_shards) -> void override;
+
+  auto updateShard(std::size_t shard, const IndexTask& task) -> void override;
+
+  auto reduceShards() -> void override;
+
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
+  /**
+   * @brief Write w_theta, w_phi, u_theta and u_phi. With one direction they
+   * are 1D, with several they have shape (numDirection(), steps).
+   */
   auto processFarField() const -> void;
 
-  auto observationDirection() const -> Vector;
+  auto numDirection() const -> Index { return _theta.size(); }
+
+  auto observationDirection(Index direction = 0) const -> Vector;
 
-  auto wx() const -> Array1D<Real>;
+  auto wx(Index direction = 0) const -> Array1D<Real>;
 
-  auto wy() const -> Array1D<Real>;
+  auto wy(Index direction = 0) const -> Array1D<Real>;
 
-  auto wz() const -> Array1D<Real>;
+  auto wz(Index direction = 0) const -> Array1D<Real>;
 
-  auto ux() const -> Array1D<Real>;
+  auto ux(Index direction = 0) const -> Array1D<Real>;
 
-  auto uy() const -> Array1D<Real>;
+  auto uy(Index direction = 0) const -> Array1D<Real>;
 
-  auto uz() const -> Array1D<Real>;
+  auto uz(Index direction = 0) const -> Array1D<Real>;
 
+  /**
+   * @brief The potentials of all directions, one after the other.
+   */
   template <Axis::Direction D, EMF::Attribute A, Axis::XYZ XYZ>
-  auto equivalentSurfaceCurrent() const -> const Array1D<Real>&;
+  auto equivalentSurfaceCurrent() const -> const Array1D<AccReal>&;
 
   template <Axis::Direction D, EMF::Attribute A, Axis::XYZ XYZ>
   auto fieldPrev() const -> const Array2D<Real>&;
 
   template <EMF::Attribute A>
-  auto distanceRange() const -> Range<Real>;
+  auto distanceRange(Index direction = 0) const -> Range<Real>;
 
  private:
-  Real _theta, _phi;
+  Array1D<Real> _theta, _phi;
 
   std::shared_ptr<TDPlaneData<Axis::Direction::XN>> _td_plane_xn;
   std::shared_ptr<TDPlaneData<Axis::Direction::XP>> _td_plane_xp;
@@ -76,13 +112,13 @@ class NFFFTTimeDomain : public NFFFT {
   std::shared_ptr<TDPlaneData<Axis::Direction::ZN>> _td_plane_zn;
   std::shared_ptr<TDPlaneData<Axis::Direction::ZP>> _td_plane_zp;
 
-  auto cosTheta() const -> Real;
+  auto cosTheta(Index direction) const -> Real;
 
-  auto sinTheta() const -> Real;
+  auto sinTheta(Index direction) const -> Real;
 
-  auto cosPhi() const -> Real;
+  auto cosPhi(Index direction) const -> Real;
 
-  auto sinPhi() const -> Real;
+  auto sinPhi(Index direction) const -> Real;
 };
 
 }  // namespace xfdtd
@@ -36,6 +36,12 @@ class Inductor : public LumpedElement {
   std::unique_ptr<Corrector> generateCorrector(
       const Task<std::size_t>& task) override;
 
+  auto saveState(Checkpoint& checkpoint,
+                 const std::string& prefix) const -> void override;
+
+  auto loadState(const Checkpoint& checkpoint,
+                 const std::string& prefix) -> void override;
+
  private:
   Real _inductance;
   Real _inductance_factor;
@@ -10,6 +10,7 @@
 #include <xfdtd/shape/shape.h>
 
 #include <memory>
+#include <vector>
 
 namespace xfdtd {
 
@@ -23,6 +24,18 @@ class XFDTDObjectException : public XFDTDException {
 
 class Corrector;
 
+class Checkpoint;
+
+/**
+ * @brief The cells (i, j, k) with k in [k_start, k_end) are inside a shape.
+ */
+struct VoxelRow {
+  Index _i;
+  Index _j;
+  Index _k_start;
+  Index _k_end;
+};
+
 class Object {
  public:
   Object(std::string name, std::unique_ptr<Shape> shape,
@@ -57,8 +70,23 @@ class Object {
 
   virtual void correctH();
 
+  /**
+   * @brief The corrector of this object for one thread. It is called once per
+   * thread task and must only correct the E nodes with index in [start, end)
+   * of the task, so the threads don't correct a shared node twice.
+   */
   virtual std::unique_ptr<Corrector> generateCorrector(const Task<Index>& task);
 
+  /**
+   * @brief Add the state that changes during the run to `checkpoint`, with
+   * names starting with `prefix`. The default has no state.
+   */
+  virtual auto saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void;
+
+  virtual auto loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void;
+
   std::string name() const;
 
   const std::unique_ptr<Shape>& shape() const;
@@ -79,6 +107,15 @@ class Object {
 
   auto materialIndex() const -> Index;
 
+  /**
+   * @brief The cells of the grid space inside the shape. Simulation voxelizes
+   * all objects together before correctMaterialSpace(); otherwise they are
+   * found on first use.
+   */
+  auto voxelRows() -> const std::vector<VoxelRow>&;
+
+  auto setVoxelRows(std::vector<VoxelRow> rows) -> void;
+
  protected:
 
   auto setMaterialIndex(Index index) -> void;
@@ -111,6 +148,9 @@ class Object {
   Index _material_index;
   std::unique_ptr<GridBox> _grid_box;
   GridBox _global_grid_box;
+
+  std::vector<VoxelRow> _voxel_rows;
+  bool _voxelized{false};
 };
 
 inline const auto& Object::material() const { return _material; }
@@ -42,6 +42,12 @@ class MpiSupport {
 
   static auto globalSize() -> int;
 
+  /**
+   * @brief Whether MPI was initialized with MPI_THREAD_MULTIPLE, so several
+   * threads of a process may call MPI at the same time.
+   */
+  static auto threadMultiple() -> bool { return thread_multiple; }
+
  public:
   class Block {
    public:
@@ -328,6 +334,7 @@ class MpiSupport {
   inline static int config_nx{1};
   inline static int config_ny{1};
   inline static int config_nz{1};
+  inline static bool thread_multiple{false};
 
  private:
   explicit MpiSupport(int argc = 0, char** argv = nullptr);
@@ -2,6 +2,7 @@
 #define __XFDTD_CORE_PARALLELIZED_CONFIG_H__
 
 #include <string>
+#include <vector>
 
 namespace xfdtd {
 
@@ -89,6 +90,19 @@ class ThreadConfig : private ParallelizedConfig {
   static constexpr int ANY_ID = -1;
   static constexpr int INVALID_ID = -2;
 
+  /**
+   * @brief How the worker threads are pinned to CPUs.
+   * NONE: not pinned.
+   * CLOSE: thread i on the i-th CPU of the rank.
+   * SPREAD: threads evenly spread over the CPUs of the rank, so neighbor
+   * threads stay on the same socket and every socket gets the same share.
+   * LIST: thread i on the i-th CPU of the list set by setCpuList().
+   *
+   * The CPUs of a rank are those of its affinity mask. Ranks on one node that
+   * were started with the same mask split it in rank order.
+   */
+  enum class Affinity { NONE, CLOSE, SPREAD, LIST };
+
   explicit ThreadConfig(int num_x = 1, int num_y = 1, int num_z = 1,
                         int root = 0);
 
@@ -106,9 +120,32 @@ class ThreadConfig : private ParallelizedConfig {
 
   auto setId(int id) -> void;
 
+  auto affinity() const -> Affinity;
+
+  auto setAffinity(Affinity affinity) -> void;
+
+  auto setCpuList(std::vector<int> cpu_list) -> void;
+
+  /**
+   * @brief The CPU the thread `id` is pinned to. -1 means not pinned.
+   */
+  auto cpuOf(int id) const -> int;
+
+  auto firstTouch() const -> bool;
+
+  /**
+   * @brief Let every thread be the first to write its slab of the field and
+   * coefficient arrays, so the pages are placed in its NUMA node.
+   */
+  auto setFirstTouch(bool first_touch) -> void;
+
   auto toString() const -> std::string override;
 
  private:
+  Affinity _affinity{Affinity::NONE};
+  std::vector<int> _cpu_list;
+  bool _first_touch{true};
+
   auto xPrev() const -> int override;
 
   auto xNext() const -> int override;
@@ -66,6 +66,9 @@ class Cube : public Shape {
 
   std::unique_ptr<Cube> wrappedCube() const override;
 
+  bool spanZ(Real x, Real y, Real eps, Real& start,
+             Real& end) const override;
+
  private:
   Vector _origin{};
   Vector _size{};
@@ -38,6 +38,9 @@ class Cylinder : public Shape {
 
   std::unique_ptr<Cube> wrappedCube() const override;
 
+  bool spanZ(Real x, Real y, Real eps, Real& start,
+             Real& end) const override;
+
  private:
   Vector _center;
   Real _radius;
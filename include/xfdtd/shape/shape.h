@@ -59,6 +59,16 @@ class Shape {
 
   virtual std::unique_ptr<Cube> wrappedCube() const = 0;
 
+  /**
+   * @brief Fast path of the voxelizer. A shape whose intersection with every
+   * line parallel to z is one interval returns true and sets [start, end] to
+   * an interval that contains the part of the line through (x, y) inside the
+   * shape, with start > end if the line misses it. The interval may be wider:
+   * the cells at its ends are checked with isInside(). The default returns
+   * false and the voxelizer tests every cell.
+   */
+  virtual bool spanZ(Real x, Real y, Real eps, Real& start, Real& end) const;
+
   static std::unique_ptr<Cube> makeWrappedCube(
       const std::vector<const Shape*>& shapes);
 };
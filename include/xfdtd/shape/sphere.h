@@ -29,6 +29,9 @@ class Sphere : public Shape {
 
   std::unique_ptr<Cube> wrappedCube() const override;
 
+  bool spanZ(Real x, Real y, Real eps, Real &start,
+             Real &end) const override;
+
   Vector center() const;
 
   Real radius() const;
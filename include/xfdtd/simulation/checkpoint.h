@@ -0,0 +1,169 @@
+#ifndef __XFDTD_CORE_CHECKPOINT_H__
+#define __XFDTD_CORE_CHECKPOINT_H__
+
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/exception/exception.h>
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xfdtd {
+
+class XFDTDCheckpointException : public XFDTDException {
+ public:
+  explicit XFDTDCheckpointException(
+      std::string message = "XFDTD Checkpoint Exception")
+      : XFDTDException(std::move(message)) {}
+};
+
+/**
+ * @brief Named arrays holding the solver state of one rank.
+ *
+ * The file is in host byte order. Every offset is a multiple of ALIGNMENT, so
+ * an entry can be used in place from a memory map:
+ *
+ *   header: "XFDTDCKP", u32 version, u32 sizeof(Real), u64 time step,
+ *           u64 number of entries, u64 offset of the entry table
+ *   data:   the entries in insertion order, each padded to ALIGNMENT
+ *   table:  per entry u32 name size, name, u32 type, u32 dimension,
+ *           u64 shape[dimension], u64 offset, u64 size in bytes
+ */
+class Checkpoint {
+ public:
+  static constexpr std::uint32_t VERSION{1};
+  static constexpr std::size_t ALIGNMENT{64};
+
+  // ACC_REAL and ACC_COMPLEX only occur in the mixed precision build, where
+  // AccReal differs from Real.
+  enum class Type : std::uint32_t {
+    REAL,
+    COMPLEX,
+    INDEX,
+    ACC_REAL,
+    ACC_COMPLEX
+  };
+
+  struct Entry {
+    std::string _name;
+    Type _type;
+    std::vector<std::uint64_t> _shape;
+    std::vector<char> _data;
+  };
+
+  auto step() const { return _step; }
+
+  auto setStep(Index step) -> void { _step = step; }
+
+  auto entries() const -> const std::vector<Entry>& { return _entries; }
+
+  auto contains(const std::string& name) const -> bool {
+    return _index.find(name) != _index.end();
+  }
+
+  /**
+   * @brief Copy `container` (an xtensor container or a std::vector of Real,
+   * AccReal, their std::complex or Index) into the entry `name`.
+   */
+  template <typename C>
+  auto save(const std::string& name, const C& container) -> void;
+
+  /**
+   * @brief Copy the entry `name` back into `container`. The container must
+   * already have the size of the saved one, so a checkpoint of a different
+   * setup is refused instead of silently loaded.
+   */
+  template <typename C>
+  auto load(const std::string& name, C& container) const -> void;
+
+  template <typename T>
+  auto saveValue(const std::string& name, T value) -> void {
+    save(name, std::vector<T>{value});
+  }
+
+  template <typename T>
+  auto loadValue(const std::string& name) const -> T {
+    auto value = std::vector<T>(1);
+    load(name, value);
+    return value.front();
+  }
+
+  auto write(const std::string& path) const -> void;
+
+  static auto read(const std::string& path) -> Checkpoint;
+
+ private:
+  Index _step{0};
+  std::vector<Entry> _entries;
+  std::unordered_map<std::string, std::size_t> _index;
+
+  template <typename T>
+  static constexpr auto typeOf() -> Type {
+    if constexpr (std::is_same_v<T, Real>) {
+      return Type::REAL;
+    } else if constexpr (std::is_same_v<T, std::complex<Real>>) {
+      return Type::COMPLEX;
+    } else if constexpr (std::is_same_v<T, AccReal>) {
+      return Type::ACC_REAL;
+    } else if constexpr (std::is_same_v<T, std::complex<AccReal>>) {
+      return Type::ACC_COMPLEX;
+    } else {
+      static_assert(std::is_same_v<T, Index>,
+                    "Checkpoint stores Real, AccReal, complex and Index");
+      return Type::INDEX;
+    }
+  }
+
+  auto entry(const std::string& name) const -> const Entry&;
+
+  auto add(Entry entry) -> void;
+};
+
+template <typename C>
+inline auto Checkpoint::save(const std::string& name,
+                             const C& container) -> void {
+  using T = typename C::value_type;
+  Entry e{name, typeOf<T>(), {}, {}};
+  if constexpr (std::is_same_v<C, std::vector<T>>) {
+    e._shape.emplace_back(container.size());
+  } else {
+    for (auto s : container.shape()) {
+      e._shape.emplace_back(s);
+    }
+  }
+
+  e._data.resize(container.size() * sizeof(T));
+  if (!e._data.empty()) {
+    std::memcpy(e._data.data(), container.data(), e._data.size());
+  }
+  add(std::move(e));
+}
+
+template <typename C>
+inline auto Checkpoint::load(const std::string& name,
+                             C& container) const -> void {
+  using T = typename C::value_type;
+  const auto& e = entry(name);
+  if (e._type != typeOf<T>() ||
+      e._data.size() != container.size() * sizeof(T)) {
+    std::stringstream ss;
+    ss << "Checkpoint entry " << name << " doesn't match the simulation: "
+       << e._data.size() << " bytes saved, " << container.size() * sizeof(T)
+       << " bytes expected";
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  if (!e._data.empty()) {
+    std::memcpy(container.data(), e._data.data(), e._data.size());
+  }
+}
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_CHECKPOINT_H__
@@ -6,18 +6,24 @@
 #include <xfdtd/electromagnetic_field/electromagnetic_field.h>
 #include <xfdtd/exception/exception.h>
 #include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/grid_space/subgrid.h>
 #include <xfdtd/material/ade_method/ade_method.h>
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/network/network.h>
 #include <xfdtd/nffft/nffft.h>
 #include <xfdtd/object/object.h>
 #include <xfdtd/parallel/parallelized_config.h>
+#include <xfdtd/simulation/checkpoint.h>
 #include <xfdtd/simulation/simulation_flag.h>
+#include <xfdtd/simulation/simulation_profile.h>
 #include <xfdtd/waveform_source/waveform_source.h>
 
+#include <atomic>
 #include <barrier>
 #include <chrono>
+#include <future>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,6 +32,9 @@ namespace xfdtd {
 // Forward declaration
 class Updator;
 class Domain;
+class ThreadPool;
+template <typename T>
+struct TaskWeight;
 
 class XFDTDSimulationException : public XFDTDException {
  public:
@@ -61,10 +70,115 @@ class Simulation {
 
   void addNF2FF(std::shared_ptr<NFFFT> nffft);
 
+  /**
+   * @brief Refine a box of the grid, see Subgrid. Only for a uniform 3D grid
+   * on a single MPI process, without the fused sweep.
+   */
+  auto addSubgrid(std::shared_ptr<Subgrid> subgrid) -> void;
+
   auto addVisitor(std::shared_ptr<SimulationFlagVisitor> visitor) -> void;
 
   auto addDefaultVisitor() -> void;
 
+  /**
+   * @brief Time every phase of the update loop on every thread and pass the
+   * timings to `visitor`. Without profile visitors nothing is timed.
+   */
+  auto addProfileVisitor(std::shared_ptr<SimulationProfileVisitor> visitor)
+      -> void;
+
+  /**
+   * @brief Use a graded mesh instead of the uniform one: cells are `min_dx`,
+   * `min_dy` and `min_dz` wide at the bounding box faces of every object and
+   * grow by about `max_ratio` per cell up to the cell size of the
+   * constructor. The time step follows the smallest cell. TFSF sources, thin
+   * wires and subgrids need a uniform grid and are not supported: their
+   * init() throws. Must be called before init().
+   */
+  auto enableGradedMesh(Real min_dx, Real min_dy, Real min_dz,
+                        Real max_ratio = 1.3) -> void;
+
+  /**
+   * @brief Fuse the E update into the H sweep for non-dispersive 3D problems,
+   * within one time step. Must be called before init().
+   *
+   * @param tile_size number of y rows in a tile.
+   */
+  auto enableFusedSweep(Index tile_size = 8) -> void;
+
+  /**
+   * @brief Store the update coefficients as a class index per node and a table
+   * of distinct coefficients, and free the material grids after init(). Must
+   * be called before init().
+   */
+  auto enableCoefficientCompression() -> void;
+
+  /**
+   * @brief Keep the ADE state and coefficients of the dispersive cells only,
+   * as compact lists with one coefficient row per material. The rest of the
+   * grid runs the plain Yee update. Only for 3D. Must be called before init().
+   */
+  auto enableSparseDispersion() -> void;
+
+  /**
+   * @brief With MPI, post the H halo exchange without blocking and update E
+   * away from the halo while it is in flight. Must be called before init().
+   */
+  auto enableHaloOverlap() -> void;
+
+  /**
+   * @brief With MPI and several threads per node, let every thread exchange
+   * its own strips of the node faces instead of the master exchanging all of
+   * them. Needs MPI_THREAD_MULTIPLE, without it the master keeps doing the
+   * exchange. Must be called before init().
+   */
+  auto enableThreadedHaloExchange() -> void;
+
+  /**
+   * @brief Apply the corrections of all PML boundaries of a domain in one
+   * pass per field component, so a cell where PML slabs overlap is read and
+   * written once. Must be called before init().
+   */
+  auto enableFusedPML() -> void;
+
+  /**
+   * @brief Gather the cells of all lumped sources and inductors of a domain
+   * into flat lists corrected in one loop each, instead of one corrector per
+   * element. Must be called before init().
+   */
+  auto enableBatchedLumpedElements() -> void;
+
+  /**
+   * @brief Place the thread boundaries so every thread gets about the same
+   * cost instead of the same number of cells. A vacuum cell costs 1; a cell
+   * corrected by a PML costs `pml_cost` more, a dispersive cell
+   * `dispersive_cost` more and a cell on a TFSF face, a monitor or an NF2FF
+   * surface `surface_cost` more. The per-thread times of a StepProfiler tell
+   * how to tune them. Must be called before init().
+   */
+  auto enableCostDecomposition(Real pml_cost = 1, Real dispersive_cost = 2,
+                               Real surface_cost = 0.5) -> void;
+
+  /**
+   * @brief Save a checkpoint to `dir` every `interval` steps of run(). The
+   * state is copied between two steps and written by a background thread
+   * while the update goes on. Must be called before run().
+   */
+  auto enableCheckpoint(std::string dir, Index interval) -> void;
+
+  /**
+   * @brief Write the solver state of this rank to `dir`. Every rank writes
+   * its own file. Call after init() and outside of run().
+   */
+  auto saveCheckpoint(const std::string& dir) -> void;
+
+  /**
+   * @brief Restore the state saved by a run with the same setup and the same
+   * number of ranks. Call after init(time_step); run() then continues from the
+   * saved step with the same results as a run that wasn't interrupted.
+   */
+  auto loadCheckpoint(const std::string& dir) -> void;
+
   void run(Index time_step);
 
   auto run() -> void;
@@ -102,10 +216,27 @@ class Simulation {
  private:
   Real _dx, _dy, _dz;
   Real _cfl;
+  Real _min_dx{0}, _min_dy{0}, _min_dz{0};
+  Real _max_ratio{0};
   ThreadConfig _thread_config;
   std::barrier<> _barrier;  // move to thread config
+  // set when a domain threw; the barrier has lost its threads for good
+  std::atomic<bool> _abort{false};
+  Index _fused_sweep_tile_size{0};
+  bool _coefficient_compression{false};
+  bool _sparse_dispersion{false};
+  bool _halo_overlap{false};
+  bool _threaded_halo_exchange{false};
+  bool _fused_pml{false};
+  bool _batched_lumped_elements{false};
+  bool _cost_decomposition{false};
+  Real _pml_cost{0}, _dispersive_cost{0}, _surface_cost{0};
+  std::string _checkpoint_dir;
+  Index _checkpoint_interval{0};
+  std::future<void> _checkpoint_writing;
 
   std::vector<std::shared_ptr<SimulationFlagVisitor>> _visitors;
+  std::vector<std::shared_ptr<SimulationProfileVisitor>> _profile_visitors;
 
   std::vector<std::shared_ptr<xfdtd::Object>> _objects;
   std::vector<std::shared_ptr<WaveformSource>> _waveform_sources;
@@ -113,6 +244,7 @@ class Simulation {
   std::vector<std::shared_ptr<Monitor>> _monitors;
   std::vector<std::shared_ptr<Network>> _networks;
   std::vector<std::shared_ptr<NFFFT>> _nfffts;
+  std::vector<std::shared_ptr<Subgrid>> _subgrids;
 
   std::chrono::high_resolution_clock::time_point _start_time;
   std::chrono::high_resolution_clock::time_point _end_time;
@@ -124,6 +256,7 @@ class Simulation {
   std::shared_ptr<ADEMethodStorage> _ade_method_storage;
 
   std::vector<std::unique_ptr<Domain>> _domains;
+  std::unique_ptr<ThreadPool> _thread_pool;
 
   std::unique_ptr<CalculationParam> makeCalculationParam();
 
@@ -135,6 +268,9 @@ class Simulation {
 
   void generateDomain();
 
+  auto decompositionWeights(const IndexTask& problem)
+      -> std::vector<TaskWeight<Index>>;
+
   void generateGridSpace();
 
   void globalGridSpaceDecomposition();
@@ -151,6 +287,23 @@ class Simulation {
 
   auto buildDispersiveSpace() -> void;
 
+  auto compressCoefficient() -> void;
+
+  auto firstTouch() -> void;
+
+  auto checkpointPath(const std::string& dir) const -> std::string;
+
+  auto captureCheckpoint() const -> Checkpoint;
+
+  auto restoreCheckpoint(const Checkpoint& checkpoint) -> void;
+
+  auto writeCheckpoint(const Checkpoint& checkpoint,
+                       const std::string& dir) const -> void;
+
+  auto beginCheckpoint() -> void;
+
+  auto waitCheckpoint() -> void;
+
   std::unique_ptr<Updator> makeUpdator(const IndexTask& task);
 };
 
@@ -0,0 +1,144 @@
+#ifndef __XFDTD_CORE_SIMULATION_PROFILE_H__
+#define __XFDTD_CORE_SIMULATION_PROFILE_H__
+
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/exception/exception.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xfdtd {
+
+class XFDTDProfileException : public XFDTDException {
+ public:
+  explicit XFDTDProfileException(
+      std::string message = "XFDTD Profile Exception")
+      : XFDTDException(std::move(message)) {}
+};
+
+enum class ProfilePhase {
+  UPDATE_H,
+  CORRECT_H,
+  EXCHANGE_H,
+  UPDATE_E,
+  CORRECT_E,
+  RECORD,
+  NEXT_STEP,
+  BARRIER
+};
+
+auto profilePhaseToString(ProfilePhase phase) -> std::string_view;
+
+/**
+ * @brief One timed section of a time step. `_name` is the corrector, monitor
+ * or NF2FF instance the section belongs to, empty for the whole phase. Time
+ * spent in thread and MPI barriers is reported as ProfilePhase::BARRIER.
+ */
+struct ProfileEvent {
+  using Clock = std::chrono::steady_clock;
+
+  ProfilePhase _phase;
+  std::string_view _name;
+  int _rank;
+  std::size_t _thread;
+  Index _step;
+  Clock::time_point _start;
+  Clock::time_point _end;
+};
+
+/**
+ * @brief Receives the timings of the update loop. profileEvent() is called by
+ * every domain thread for its own sections, so calls from different threads
+ * overlap; the calls of one thread don't.
+ */
+class SimulationProfileVisitor {
+ public:
+  virtual ~SimulationProfileVisitor() = default;
+
+  /**
+   * @brief Called once by the master thread before the update loop.
+   */
+  virtual auto profileStart(int rank, std::size_t num_thread) -> void {}
+
+  virtual auto profileEvent(const ProfileEvent& event) -> void = 0;
+
+  /**
+   * @brief Called once by the master thread after the update loop.
+   */
+  virtual auto profileEnd() -> void {}
+};
+
+/**
+ * @brief Collects per rank, thread, phase and instance statistics and an
+ * optional trace of the first time steps.
+ *
+ * Every rank only knows its own threads, so the write functions write the data
+ * of the calling rank. Use a different path on every rank.
+ */
+class StepProfiler : public SimulationProfileVisitor {
+ public:
+  struct Entry {
+    int _rank;
+    std::size_t _thread;
+    ProfilePhase _phase;
+    std::string _name;
+    Index _count;
+    double _total;  // unit: second
+    double _min;
+    double _max;
+  };
+
+  /**
+   * @param trace_steps keep every event of this many steps for
+   * writeChromeTrace().
+   */
+  explicit StepProfiler(Index trace_steps = 0);
+
+  auto profileStart(int rank, std::size_t num_thread) -> void override;
+
+  auto profileEvent(const ProfileEvent& event) -> void override;
+
+  auto rank() const { return _rank; }
+
+  auto summary() const -> std::vector<Entry>;
+
+  auto toString() const -> std::string;
+
+  auto writeSummaryJson(const std::string& path) const -> void;
+
+  auto writeSummaryCsv(const std::string& path) const -> void;
+
+  /**
+   * @brief Write the kept events in the Chrome trace event format, viewable in
+   * chrome://tracing or Perfetto. The rank is the process id and the thread
+   * the thread id.
+   */
+  auto writeChromeTrace(const std::string& path) const -> void;
+
+ private:
+  struct TraceEvent {
+    ProfilePhase _phase;
+    std::string _name;
+    double _start;  // unit: microsecond from profileStart()
+    double _duration;
+  };
+
+  struct ThreadData {
+    std::vector<Entry> _entries;
+    std::vector<TraceEvent> _trace;
+    Index _first_step{0};
+    bool _started{false};
+  };
+
+  Index _trace_steps;
+  int _rank{0};
+  ProfileEvent::Clock::time_point _origin{};
+  std::vector<ThreadData> _threads;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_SIMULATION_PROFILE_H__
@@ -4,23 +4,168 @@
 #include <xfdtd/common/constant.h>
 #include <xfdtd/common/type_define.h>
 
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <utility>
+#include <vector>
+
 namespace xfdtd {
 
+/**
+ * @brief In place radix-2 FFT, the size of `data` must be a power of two. The
+ * inverse transform isn't scaled.
+ */
+inline auto fft(std::vector<std::complex<double>> &data, bool inverse) -> void {
+  const auto n = data.size();
+  for (std::size_t i{1}, j{0}; i < n; ++i) {
+    auto bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  const auto sign = inverse ? 1.0 : -1.0;
+  for (std::size_t len{2}; len <= n; len <<= 1) {
+    const auto w_len =
+        std::polar(1.0, sign * 2 * std::numbers::pi / static_cast<double>(len));
+    for (std::size_t i{0}; i < n; i += len) {
+      std::complex<double> w{1.0, 0.0};
+      for (std::size_t j{0}; j < len / 2; ++j) {
+        const auto u = data[i + j];
+        const auto v = data[i + j + len / 2] * w;
+        data[i + j] = u + v;
+        data[i + j + len / 2] = u - v;
+        w *= w_len;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Chirp-z transform X(n) = sum_j x(j) exp(-i theta n j) for n < m, by
+ * Bluestein's algorithm in O((N + m) log(N + m)).
+ */
+inline auto chirpZ(const std::vector<std::complex<double>> &x, double theta,
+                   std::size_t m) -> std::vector<std::complex<double>> {
+  const auto n = x.size();
+  if (n == 0 || m == 0) {
+    return std::vector<std::complex<double>>(m);
+  }
+
+  std::size_t l{1};
+  while (l < n + m - 1) {
+    l <<= 1;
+  }
+
+  // k * k is exact in double far beyond any number of time steps
+  auto chirp = [theta](std::size_t k) {
+    const auto kk = static_cast<double>(k) * static_cast<double>(k);
+    return std::polar(1.0, theta * kk / 2);
+  };
+
+  auto a = std::vector<std::complex<double>>(l);
+  for (std::size_t j{0}; j < n; ++j) {
+    a[j] = x[j] * std::conj(chirp(j));
+  }
+  auto b = std::vector<std::complex<double>>(l);
+  for (std::size_t k{0}; k < m; ++k) {
+    b[k] = chirp(k);
+  }
+  for (std::size_t k{1}; k < n; ++k) {
+    b[l - k] = chirp(k);
+  }
+
+  fft(a, false);
+  fft(b, false);
+  for (std::size_t k{0}; k < l; ++k) {
+    a[k] *= b[k];
+  }
+  fft(a, true);
+
+  auto res = std::vector<std::complex<double>>(m);
+  for (std::size_t k{0}; k < m; ++k) {
+    res[k] = std::conj(chirp(k)) * a[k] / static_cast<double>(l);
+  }
+  return res;
+}
+
+/**
+ * @brief DFT of `time_domain_data` sampled at (j + 1) * dt + time_shift.
+ *
+ * Evenly spaced frequencies, like a linspace, go through a chirp-z transform
+ * in double. Other frequencies run a recursive phasor in AccReal, with one
+ * complex multiply per sample and frequency.
+ */
 template <typename Arr>
-inline Array1D<std::complex<Real>> dft(const Arr &time_domain_data, Real dt,
-                                       const Arr &frequencies,
-                                       Real time_shift = 0) {
-  Array1D<std::complex<Real>> res =
-      xt::empty<std::complex<Real>>({frequencies.size()});
-  for (size_t i{0}; i < frequencies.size(); ++i) {
-    std::complex<Real> sum{0.0, 0.0};
-
-    for (size_t j{0}; j < time_domain_data.size(); ++j) {
-      auto t{(j + 1) * dt + time_shift};
-      sum += time_domain_data(j) *
-             std::exp(-static_cast<Real>(2.0) * constant::II * constant::PI * frequencies(i) * t);
+inline Array1D<std::complex<AccReal>> dft(const Arr &time_domain_data, Real dt,
+                                          const Arr &frequencies,
+                                          Real time_shift = 0) {
+  const auto num_freq = frequencies.size();
+  const auto num_time = time_domain_data.size();
+  Array1D<std::complex<AccReal>> res =
+      xt::zeros<std::complex<AccReal>>({num_freq});
+  if (num_freq == 0 || num_time == 0) {
+    return res;
+  }
+
+  // Below this the chirp-z transform doesn't pay off
+  constexpr std::size_t min_chirp_z_frequencies{16};
+  const auto f_start = static_cast<double>(frequencies(0));
+  const auto df =
+      (num_freq < 2) ? 0.0
+                     : (static_cast<double>(frequencies(num_freq - 1)) -
+                        f_start) /
+                           static_cast<double>(num_freq - 1);
+  auto uniform = min_chirp_z_frequencies <= num_freq;
+  for (std::size_t i{0}; uniform && i < num_freq; ++i) {
+    const auto f = f_start + static_cast<double>(i) * df;
+    uniform = std::abs(static_cast<double>(frequencies(i)) - f) <=
+              4 * std::numeric_limits<Real>::epsilon() * std::abs(f);
+  }
+
+  if (uniform) {
+    const auto dt_d = static_cast<double>(dt);
+    const auto shift = static_cast<double>(time_shift) + dt_d;
+    auto x = std::vector<std::complex<double>>(num_time);
+    for (std::size_t j{0}; j < num_time; ++j) {
+      x[j] = static_cast<double>(time_domain_data(j)) *
+             std::polar(1.0, -2 * std::numbers::pi * f_start *
+                                 static_cast<double>(j) * dt_d);
+    }
+
+    const auto sum = chirpZ(x, 2 * std::numbers::pi * df * dt_d, num_freq);
+    for (std::size_t i{0}; i < num_freq; ++i) {
+      const auto f = f_start + static_cast<double>(i) * df;
+      res(i) = static_cast<std::complex<AccReal>>(
+          sum[i] * std::polar(dt_d, -2 * std::numbers::pi * f * shift));
+    }
+    return res;
+  }
+
+  // Exact kernel every `reseed` samples, so the phasor doesn't drift
+  constexpr std::size_t reseed{1024};
+  const auto dt_acc = static_cast<AccReal>(dt);
+  for (std::size_t i{0}; i < num_freq; ++i) {
+    const auto omega = -2 * constant::ACC_PI * frequencies(i);
+    const auto step = std::exp(std::complex<AccReal>{0, omega * dt_acc});
+    std::complex<AccReal> kernel{};
+    std::complex<AccReal> sum{0.0, 0.0};
+    for (std::size_t j{0}; j < num_time; ++j) {
+      if (j % reseed == 0) {
+        auto t{(j + 1) * dt_acc + time_shift};
+        kernel = std::exp(std::complex<AccReal>{0, omega * t});
+      }
+      sum += static_cast<AccReal>(time_domain_data(j)) * kernel;
+      kernel *= step;
     }
-    res(i) = sum * dt;
+    res(i) = sum * dt_acc;
   }
   return res;
 }
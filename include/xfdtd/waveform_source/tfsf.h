@@ -7,6 +7,7 @@
 #include <xfdtd/grid_space/grid_space.h>
 #include <xfdtd/waveform_source/waveform_source.h>
 
+#include <array>
 #include <cstddef>
 #include <memory>
 
@@ -29,6 +30,8 @@ class TFSF : public WaveformSource {
 
   void initTimeDependentVariable() override;
 
+  void nextStep() override;
+
   std::size_t x() const;
 
   std::size_t y() const;
@@ -105,6 +108,16 @@ class TFSF : public WaveformSource {
 
   auto nodeTask() const -> IndexTask;
 
+  /**
+   * @brief Advance the incident line one step at a time during the run
+   * instead of solving it for every step in initTimeDependentVariable(). Only
+   * the current step is kept, so eInc() and hInc() have a single row. Off by
+   * default.
+   */
+  auto setIncidentOnTheFly(bool on_the_fly) -> void;
+
+  auto incidentOnTheFly() const -> bool;
+
  protected:
   void defaultInit(std::shared_ptr<GridSpace> grid_space,
                    std::shared_ptr<CalculationParam> calculation_param,
@@ -144,8 +157,18 @@ class TFSF : public WaveformSource {
   Real _abc_coff_0, _abc_coff_1;
   Real _a = 0, _b = 0;
 
+  bool _incident_on_the_fly{false};
+  Index _incident_step{0};
+  Array1D<Real> _e_line, _h_line;
+  // the last two samples of the line one and two steps ago, for the ABC
+  std::array<Real, 2> _e_end_prev{}, _e_end_prev_prev{};
+
   void initTransform();
 
+  auto resetIncidentLine() -> void;
+
+  auto advanceIncidentLine() -> void;
+
   void calculateProjection();
 
   Grid calculateInjectPostion();
@@ -37,6 +37,12 @@ class WaveformSource {
 
   virtual void initTimeDependentVariable() = 0;
 
+  /**
+   * @brief Called by the master domain once the time step is advanced, before
+   * any corrector of the new step runs.
+   */
+  virtual void nextStep();
+
   const std::unique_ptr<Waveform> &waveform();
 
   virtual std::unique_ptr<Corrector> generateCorrector(
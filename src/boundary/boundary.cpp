@@ -1,4 +1,5 @@
 #include <xfdtd/boundary/boundary.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 namespace xfdtd {
 
@@ -18,4 +19,10 @@ CalculationParam* Boundary::calculationParamPtr() const {
 
 EMF* Boundary::emfPtr() const { return _emf.get(); }
 
+auto Boundary::saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void {}
+
+auto Boundary::loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void {}
+
 }  // namespace xfdtd
@@ -0,0 +1,178 @@
+#include "boundary/fused_pml_corrector.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace xfdtd {
+
+namespace {
+
+// One PML term on a k segment of a row. Everything steps by one along k,
+// except the coefficients when the main axis of the PML isn't z.
+struct Row {
+  Real* _psi;
+  const Real* _c_psi;
+  const Real* _p;
+  const Real* _q;
+  const Real* _coeff_a;
+  const Real* _coeff_b;
+  Index _coeff_step;
+};
+
+template <EMF::Attribute attribute>
+auto makeRow(PMLTerm& t, Index i, Index j, Index k) -> Row {
+  Index i_l = i, j_l = j, k_l = k;
+  Index i_q = i, j_q = j, k_q = k;
+  Index c{};
+  switch (t._main_axis) {
+    case Axis::XYZ::X:
+      c = i;
+      i_l -= t._pml_node_start;
+      i_q = (attribute == EMF::Attribute::E) ? i_q - 1 : i_q + 1;
+      break;
+    case Axis::XYZ::Y:
+      c = j;
+      j_l -= t._pml_node_start;
+      j_q = (attribute == EMF::Attribute::E) ? j_q - 1 : j_q + 1;
+      break;
+    default:
+      c = k;
+      k_l -= t._pml_node_start;
+      k_q = (attribute == EMF::Attribute::E) ? k_q - 1 : k_q + 1;
+      break;
+  }
+
+  const auto coeff_index = c + t._offset_c - t._pml_global_start;
+  return Row{&(*t._psi)(i_l, j_l, k_l),
+             &(*t._c_psi)(i_l, j_l, k_l),
+             &(*t._dual_field)(i, j, k),
+             &(*t._dual_field)(i_q, j_q, k_q),
+             t._coeff_a->data() + coeff_index,
+             t._coeff_b->data() + coeff_index,
+             static_cast<Index>(t._main_axis == Axis::XYZ::Z ? 1 : 0)};
+}
+
+}  // namespace
+
+auto FusedPMLCorrector::add(PMLCorrectorBase& corrector) -> void {
+  if (!corrector.task().valid()) {
+    return;
+  }
+
+  for (auto&& t : corrector.terms(EMF::Attribute::E)) {
+    if (t._task.valid()) {
+      _e_terms[static_cast<std::size_t>(t._component)].emplace_back(t);
+    }
+  }
+  for (auto&& t : corrector.terms(EMF::Attribute::H)) {
+    if (t._task.valid()) {
+      _h_terms[static_cast<std::size_t>(t._component)].emplace_back(t);
+    }
+  }
+  _regions.emplace_back(corrector.task());
+}
+
+auto FusedPMLCorrector::correctE() -> void {
+  for (auto&& terms : _e_terms) {
+    correct<EMF::Attribute::E>(terms);
+  }
+}
+
+auto FusedPMLCorrector::correctH() -> void {
+  for (auto&& terms : _h_terms) {
+    correct<EMF::Attribute::H>(terms);
+  }
+}
+
+auto FusedPMLCorrector::toString() const -> std::string {
+  std::stringstream ss;
+  ss << "FusedPMLCorrector:";
+  for (const auto& r : _regions) {
+    ss << "\n " << r.toString();
+  }
+  return ss.str();
+}
+
+template <EMF::Attribute attribute>
+auto FusedPMLCorrector::correct(std::vector<PMLTerm>& terms) -> void {
+  if (terms.empty()) {
+    return;
+  }
+
+  // All terms of a component correct the same field
+  auto& field = *terms.front()._field;
+
+  auto is = std::numeric_limits<Index>::max();
+  auto js = std::numeric_limits<Index>::max();
+  Index ie{0};
+  Index je{0};
+  for (const auto& t : terms) {
+    is = std::min(is, t._task.xRange().start());
+    ie = std::max(ie, t._task.xRange().end());
+    js = std::min(js, t._task.yRange().start());
+    je = std::max(je, t._task.yRange().end());
+  }
+
+  std::vector<PMLTerm*> active;
+  std::vector<Index> cuts;
+  std::vector<Row> rows;
+  for (Index i = is; i < ie; ++i) {
+    for (Index j = js; j < je; ++j) {
+      active.clear();
+      cuts.clear();
+      for (auto&& t : terms) {
+        const auto x = t._task.xRange();
+        const auto y = t._task.yRange();
+        if (i < x.start() || x.end() <= i || j < y.start() || y.end() <= j) {
+          continue;
+        }
+
+        active.emplace_back(&t);
+        cuts.emplace_back(t._task.zRange().start());
+        cuts.emplace_back(t._task.zRange().end());
+      }
+      if (active.empty()) {
+        continue;
+      }
+
+      std::sort(cuts.begin(), cuts.end());
+      cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+      for (std::size_t s = 0; s + 1 < cuts.size(); ++s) {
+        const auto ks = cuts[s];
+        const auto ke = cuts[s + 1];
+
+        rows.clear();
+        for (auto* t : active) {
+          const auto z = t->_task.zRange();
+          if (z.start() <= ks && ke <= z.end()) {
+            rows.emplace_back(makeRow<attribute>(*t, i, j, ks));
+          }
+        }
+        if (rows.empty()) {
+          continue;
+        }
+
+        auto* f = &field(i, j, ks);
+        for (Index k = 0; k < ke - ks; ++k) {
+          auto f_v = f[k];
+          for (const auto& r : rows) {
+            const auto coeff_a_v = r._coeff_a[k * r._coeff_step];
+            const auto coeff_b_v = r._coeff_b[k * r._coeff_step];
+            auto& psi_v = r._psi[k];
+            if constexpr (attribute == EMF::Attribute::E) {
+              psi_v = coeff_b_v * psi_v + coeff_a_v * (r._p[k] - r._q[k]);
+            } else {
+              psi_v = coeff_b_v * psi_v + coeff_a_v * (r._q[k] - r._p[k]);
+            }
+            f_v += r._c_psi[k] * psi_v;
+          }
+          f[k] = f_v;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace xfdtd
@@ -5,6 +5,7 @@
 #include <xfdtd/coordinate_system/coordinate_system.h>
 #include <xfdtd/electromagnetic_field/electromagnetic_field.h>
 #include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/simulation/checkpoint.h>
 #include <xfdtd/util/transform.h>
 #include <xfdtd/util/transform/abc_xyz.h>
 
@@ -638,4 +639,20 @@ Array1D<Real> PML::calculateCoeffPsi(const Array1D<Real>& coeff,
   return coeff * dl;
 }
 
+auto PML::saveState(Checkpoint& checkpoint,
+                    const std::string& prefix) const -> void {
+  checkpoint.save(prefix + "ea_psi_hb", _ea_psi_hb);
+  checkpoint.save(prefix + "eb_psi_ha", _eb_psi_ha);
+  checkpoint.save(prefix + "ha_psi_eb", _ha_psi_eb);
+  checkpoint.save(prefix + "hb_psi_ea", _hb_psi_ea);
+}
+
+auto PML::loadState(const Checkpoint& checkpoint,
+                    const std::string& prefix) -> void {
+  checkpoint.load(prefix + "ea_psi_hb", _ea_psi_hb);
+  checkpoint.load(prefix + "eb_psi_ha", _eb_psi_ha);
+  checkpoint.load(prefix + "ha_psi_eb", _ha_psi_eb);
+  checkpoint.load(prefix + "hb_psi_ea", _hb_psi_ea);
+}
+
 }  // namespace xfdtd
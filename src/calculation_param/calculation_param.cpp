@@ -2,10 +2,71 @@
 #include <xfdtd/common/constant.h>
 #include <xfdtd/grid_space/grid_space.h>
 
+#include <array>
 #include <xtensor.hpp>
 
 namespace xfdtd {
 
+// Material averaging of a graded mesh. The four cells around an E edge are
+// weighted by their area; the two cells along an H component are averaged
+// harmonically, weighted by their length. Both reduce to the uniform averages
+// when the cells are equal. The grid is walked backwards, so the cells at
+// lower indices are read before they are overwritten.
+static auto areaWeightedMean(Array3D<Real>& p, const Array1D<Real>& da,
+                             const Array1D<Real>& db, std::size_t axis_a,
+                             std::size_t axis_b) -> void {
+  const auto shape = p.shape();
+  for (Index i{shape[0]}; 0 < i--;) {
+    for (Index j{shape[1]}; 0 < j--;) {
+      for (Index k{shape[2]}; 0 < k--;) {
+        const auto n = std::array<Index, 3>{i, j, k};
+        const auto a = n[axis_a];
+        const auto b = n[axis_b];
+        if (a == 0 || da.size() <= a || b == 0 || db.size() <= b) {
+          continue;
+        }
+
+        auto na = n;
+        --na[axis_a];
+        auto nb = n;
+        --nb[axis_b];
+        auto nab = na;
+        --nab[axis_b];
+        const auto wa0 = da(a - 1);
+        const auto wa1 = da(a);
+        const auto wb0 = db(b - 1);
+        const auto wb1 = db(b);
+        p[n] = (wa1 * wb1 * p[n] + wa0 * wb1 * p[na] + wa1 * wb0 * p[nb] +
+                wa0 * wb0 * p[nab]) /
+               ((wa0 + wa1) * (wb0 + wb1));
+      }
+    }
+  }
+}
+
+static auto lengthWeightedHarmonicMean(Array3D<Real>& p,
+                                       const Array1D<Real>& d,
+                                       std::size_t axis) -> void {
+  const auto shape = p.shape();
+  for (Index i{shape[0]}; 0 < i--;) {
+    for (Index j{shape[1]}; 0 < j--;) {
+      for (Index k{shape[2]}; 0 < k--;) {
+        const auto n = std::array<Index, 3>{i, j, k};
+        const auto c = n[axis];
+        if (c == 0 || d.size() <= c) {
+          continue;
+        }
+
+        auto nc = n;
+        --nc[axis];
+        const auto w0 = d(c - 1);
+        const auto w1 = d(c);
+        p[n] = (w0 + w1) * p[nc] * p[n] / (w0 * p[n] + w1 * p[nc]);
+      }
+    }
+  }
+}
+
 XFDTDCalculationParamException::XFDTDCalculationParamException(
     std::string message)
     : XFDTDException{std::move(message)} {}
@@ -41,11 +102,24 @@ std::unique_ptr<FDTDUpdateCoefficient>& CalculationParam::fdtdCoefficient() {
 }
 
 void CalculationParam::generateMaterialSpaceParam(const GridSpace* grid_space) {
-  // TODO(franzero): don't support to nonuniform grid space
-  if (grid_space->type() != GridSpace::Type::UNIFORM) {
-    throw XFDTDCalculationParamException{
-        "Nonuniform grid space is not "
-        "supported yet"};
+  if (grid_space->type() == GridSpace::Type::NONUNIFORM) {
+    const auto& dx = grid_space->eSizeX();
+    const auto& dy = grid_space->eSizeY();
+    const auto& dz = grid_space->eSizeZ();
+    auto& m = *materialParam();
+    areaWeightedMean(m.epsX(), dy, dz, 1, 2);
+    areaWeightedMean(m.epsY(), dz, dx, 2, 0);
+    areaWeightedMean(m.epsZ(), dx, dy, 0, 1);
+    areaWeightedMean(m.sigmaEX(), dy, dz, 1, 2);
+    areaWeightedMean(m.sigmaEY(), dz, dx, 2, 0);
+    areaWeightedMean(m.sigmaEZ(), dx, dy, 0, 1);
+    lengthWeightedHarmonicMean(m.muX(), dx, 0);
+    lengthWeightedHarmonicMean(m.muY(), dy, 1);
+    lengthWeightedHarmonicMean(m.muZ(), dz, 2);
+    lengthWeightedHarmonicMean(m.sigmaMX(), dx, 0);
+    lengthWeightedHarmonicMean(m.sigmaMY(), dy, 1);
+    lengthWeightedHarmonicMean(m.sigmaMZ(), dz, 2);
+    return;
   }
 
   auto nx{grid_space->sizeX()};
@@ -1,10 +1,88 @@
 #include <xfdtd/calculation_param/fdtd_update_coefficient.h>
 
 #include <filesystem>
+#include <limits>
+#include <map>
 #include <xtensor/xnpy.hpp>
 
 namespace xfdtd {
 
+template <EMF::Attribute c, Axis::XYZ xyz>
+auto FDTDUpdateCoefficient::compressComponent(
+    Array3D<ClassIndex>& index, std::vector<ClassCoefficient>& table) const
+    -> bool {
+  constexpr auto dual = EMF::dualAttribute(c);
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+  constexpr auto max_class =
+      static_cast<std::size_t>(std::numeric_limits<ClassIndex>::max()) + 1;
+
+  const auto& cc = coeff<c, xyz>();
+  const auto& ca = coeff<c, xyz, dual, xyz_a>();
+  const auto& cb = coeff<c, xyz, dual, xyz_b>();
+
+  index = Array3D<ClassIndex>::from_shape(cc.shape());
+  table.clear();
+
+  // Neighbors along z are usually in the same material, so check the last
+  // class before looking up the map.
+  std::map<std::array<Real, 3>, ClassIndex> classes;
+  auto last = std::array<Real, 3>{};
+  ClassIndex last_index = 0;
+  for (std::size_t n = 0; n < cc.size(); ++n) {
+    const auto key = std::array<Real, 3>{cc.flat(n), ca.flat(n), cb.flat(n)};
+    if (!table.empty() && key == last) {
+      index.flat(n) = last_index;
+      continue;
+    }
+
+    auto it = classes.find(key);
+    if (it == classes.end()) {
+      if (table.size() == max_class) {
+        return false;
+      }
+
+      it = classes.emplace(key, static_cast<ClassIndex>(table.size())).first;
+      table.push_back({key[0], key[1], key[2]});
+    }
+
+    last = key;
+    last_index = it->second;
+    index.flat(n) = last_index;
+  }
+
+  return true;
+}
+
+auto FDTDUpdateCoefficient::compress() -> bool {
+  if (_compressed) {
+    return true;
+  }
+
+  auto index = std::array<Array3D<ClassIndex>, 6>{};
+  auto table = std::array<std::vector<ClassCoefficient>, 6>{};
+  constexpr auto e = EMF::Attribute::E;
+  constexpr auto h = EMF::Attribute::H;
+  if (!compressComponent<e, Axis::XYZ::X>(index[0], table[0]) ||
+      !compressComponent<e, Axis::XYZ::Y>(index[1], table[1]) ||
+      !compressComponent<e, Axis::XYZ::Z>(index[2], table[2]) ||
+      !compressComponent<h, Axis::XYZ::X>(index[3], table[3]) ||
+      !compressComponent<h, Axis::XYZ::Y>(index[4], table[4]) ||
+      !compressComponent<h, Axis::XYZ::Z>(index[5], table[5])) {
+    return false;
+  }
+
+  _class_index = std::move(index);
+  _class_table = std::move(table);
+  for (auto* arr : {&_cexe, &_cexhy, &_cexhz, &_ceye, &_ceyhz, &_ceyhx,
+                    &_ceze, &_cezhx, &_cezhy, &_chxh, &_chxey, &_chxez,
+                    &_chyh, &_chyez, &_chyex, &_chzh, &_chzex, &_chzey}) {
+    *arr = Array3D<Real>{};
+  }
+  _compressed = true;
+  return true;
+}
+
 auto FDTDUpdateCoefficient::save(const std::string& dir) const -> void {
   auto dir_path = std::filesystem::path(dir);
 
@@ -13,6 +91,26 @@ auto FDTDUpdateCoefficient::save(const std::string& dir) const -> void {
     std::filesystem::create_directories(dir_path);
   }
 
+  if (_compressed) {
+    // every row of the table is (c, c_a, c_b)
+    const char* names[] = {"ex", "ey", "ez", "hx", "hy", "hz"};
+    for (std::size_t n = 0; n < _class_index.size(); ++n) {
+      auto table = Array2D<Real>::from_shape({_class_table[n].size(), 3});
+      for (std::size_t m = 0; m < _class_table[n].size(); ++m) {
+        table(m, 0) = _class_table[n][m]._c;
+        table(m, 1) = _class_table[n][m]._c_a;
+        table(m, 2) = _class_table[n][m]._c_b;
+      }
+      xt::dump_npy(
+          (dir_path / (std::string{names[n]} + "_class_index.npy")).string(),
+          _class_index[n]);
+      xt::dump_npy(
+          (dir_path / (std::string{names[n]} + "_class_table.npy")).string(),
+          table);
+    }
+    return;
+  }
+
   xt::dump_npy((dir_path / "cexe.npy").string(), _cexe);
   xt::dump_npy((dir_path / "cexhy.npy").string(), _cexhy);
   xt::dump_npy((dir_path / "cexhz.npy").string(), _cexhz);
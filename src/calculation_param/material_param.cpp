@@ -390,6 +390,16 @@ void MaterialParam::allocate(std::size_t nx, std::size_t ny, std::size_t nz) {
   _sigma_m_y.fill(constant::SIGMA_M_ZERO_APPROX);
   _sigma_m_z = makeArr<EMF::Attribute::H, Axis::XYZ::Z>(nx, ny, nz);
   _sigma_m_z.fill(constant::SIGMA_M_ZERO_APPROX);
+  _released = false;
+}
+
+auto MaterialParam::release() -> void {
+  for (auto* arr :
+       {&_eps_x, &_eps_y, &_eps_z, &_mu_x, &_mu_y, &_mu_z, &_sigma_e_x,
+        &_sigma_e_y, &_sigma_e_z, &_sigma_m_x, &_sigma_m_y, &_sigma_m_z}) {
+    *arr = Array3D<Real>{};
+  }
+  _released = true;
 }
 
 }  // namespace xfdtd
@@ -60,6 +60,15 @@ void TimeParam::setTimeParamRunRange(std::size_t end_time_step,
   _current_time_step = start_time_step;
 }
 
+void TimeParam::setCurrentTimeStep(std::size_t time_step) {
+  if (time_step < _start_time_step || endTimeStep() < time_step) {
+    throw XFDTDTimeParamException(
+        "time_step must be inside the run range of the time parameter");
+  }
+
+  _current_time_step = time_step;
+}
+
 auto TimeParam::eTime() const -> Array1D<Real> {
   return xt::linspace((_start_time_step + 1) * _dt,
                       (_start_time_step + _size) * _dt, _size);
@@ -20,6 +20,13 @@ namespace xfdtd {
 
 static std::mutex cout_mutex;
 
+namespace {
+
+// Thrown at a barrier when another domain of the run failed
+struct DomainAborted {};
+
+}  // namespace
+
 Domain::Domain(std::size_t id, IndexTask task,
                std::shared_ptr<GridSpace> grid_space,
                std::shared_ptr<CalculationParam> calculation_param,
@@ -43,40 +50,20 @@ Domain::Domain(std::size_t id, IndexTask task,
       _master{master} {}
 
 void Domain::run() {
-  //   // run info
-  //   {
-  //     std::stringstream ss;
-  //     ss << "Domain " << _id << " is running ";
-  //     ss << "Size: " << _task.toString() << "\n";
-  //     std::cerr << ss.str();
-  //   }
-
-  // #ifdef __linux__
-  //   auto cpu_id = (_id) % std::thread::hardware_concurrency();
-  //   constexpr auto cpu_logical_cores = 2;
-  //   constexpr auto cpu_physical_cores = 1;
-  //   auto cpu_offset = std::thread::hardware_concurrency() /
-  //   cpu_logical_cores;
-  //   // if (cpu_id % 2 != 0) {
-  //   //   cpu_id = (cpu_id - 1) + std::thread::hardware_concurrency() / 2;
-  //   // }
-
-  //   cpu_set_t mask;
-  //   CPU_ZERO(&mask);
-  //   CPU_SET(cpu_id, &mask);
-  //   // set for thread
-  //   if (int rc = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
-  //       rc != 0) {
-  //     std::cerr << "Error calling pthread_setaffinity_np: " << rc << "\n";
-  //   }
-
-  //   // get affinity
-  //   std::stringstream ss;
-  //   ss << "Thread " << _id << " is running on CPU " << sched_getcpu() <<
-  //   "\n"; std::cerr << ss.str();
-
-  // #endif
+  try {
+    runSteps();
+  } catch (const DomainAborted&) {
+    _barrier.arrive_and_drop();
+  } catch (...) {
+    if (_abort != nullptr) {
+      _abort->store(true);
+    }
+    _barrier.arrive_and_drop();
+    throw;
+  }
+}
 
+auto Domain::runSteps() -> void {
   sendInitFlag(SimulationInitFlag::UpdateStart);
 
   while (!isCalculationDone()) {
@@ -91,23 +78,27 @@ void Domain::run() {
 
     correctH();
 
-    synchronize();
+    if (_halo_overlap) {
+      updateEOverlapped();
+    } else {
+      synchronize();
 
-    exchangeH();
+      exchangeH();
 
-    sendIteratorFlag(SimulationIteratorFlag::UpdateHSEnd,
-                     _calculation_param->timeParam()->currentTimeStep(),
-                     _calculation_param->timeParam()->startTimeStep(),
-                     _calculation_param->timeParam()->endTimeStep());
+      sendIteratorFlag(SimulationIteratorFlag::UpdateHSEnd,
+                       _calculation_param->timeParam()->currentTimeStep(),
+                       _calculation_param->timeParam()->startTimeStep(),
+                       _calculation_param->timeParam()->endTimeStep());
 
-    synchronize();
+      synchronize();
 
-    sendIteratorFlag(SimulationIteratorFlag::UpdateEStart,
-                     _calculation_param->timeParam()->currentTimeStep(),
-                     _calculation_param->timeParam()->startTimeStep(),
-                     _calculation_param->timeParam()->endTimeStep());
+      sendIteratorFlag(SimulationIteratorFlag::UpdateEStart,
+                       _calculation_param->timeParam()->currentTimeStep(),
+                       _calculation_param->timeParam()->startTimeStep(),
+                       _calculation_param->timeParam()->endTimeStep());
 
-    updateE();
+      updateE();
+    }
 
     threadSynchronize();
 
@@ -132,40 +123,119 @@ void Domain::run() {
                      _calculation_param->timeParam()->currentTimeStep(),
                      _calculation_param->timeParam()->startTimeStep(),
                      _calculation_param->timeParam()->endTimeStep());
+
+    if (checkpointDue()) {
+      if (isMaster()) {
+        _checkpoint_capture();
+      }
+
+      threadSynchronize();
+    }
   }
 
   sendInitFlag(SimulationInitFlag::UpdateEnd);
 }
 
+auto Domain::checkpointDue() const -> bool {
+  if (_checkpoint_interval == 0 || isCalculationDone()) {
+    return false;
+  }
+
+  return _calculation_param->timeParam()->currentTimeStep() %
+             _checkpoint_interval ==
+         0;
+}
+
 bool Domain::isCalculationDone() const {
   return _calculation_param->timeParam()->endTimeStep() <=
          _calculation_param->timeParam()->currentTimeStep();
 }
 
-void Domain::updateE() { _updator->updateE(); }
+void Domain::updateE() {
+  profile(ProfilePhase::UPDATE_E, {}, [this]() { _updator->updateE(); });
+}
+
+void Domain::updateH() {
+  profile(ProfilePhase::UPDATE_H, {}, [this]() { _updator->updateH(); });
+}
+
+auto Domain::updateEOverlapped() -> void {
+  // H of every task is corrected before the boundary planes are sent
+  threadSynchronize();
+
+  beginExchangeH();
+
+  sendIteratorFlag(SimulationIteratorFlag::UpdateHSEnd,
+                   _calculation_param->timeParam()->currentTimeStep(),
+                   _calculation_param->timeParam()->startTimeStep(),
+                   _calculation_param->timeParam()->endTimeStep());
 
-void Domain::updateH() { _updator->updateH(); }
+  sendIteratorFlag(SimulationIteratorFlag::UpdateEStart,
+                   _calculation_param->timeParam()->currentTimeStep(),
+                   _calculation_param->timeParam()->startTimeStep(),
+                   _calculation_param->timeParam()->endTimeStep());
+
+  // E away from the received planes doesn't read them, and no E is sent.
+  const auto interior = haloInterior();
+  profile(ProfilePhase::UPDATE_E, "interior",
+          [this, &interior]() { _updator->updateEInterior(interior); });
+
+  endExchangeH();
+
+  threadSynchronize();
+
+  profile(ProfilePhase::UPDATE_E, "rim",
+          [this, &interior]() { _updator->updateERim(interior); });
+}
+
+auto Domain::haloInterior() const -> IndexTask {
+  // H is received into the node planes 0 and n - 1, which E at 0, 1 and n - 1
+  // reads.
+  auto range = [](bool head, bool tail, Index n) {
+    return makeIndexRange(head ? 0 : 2, tail ? n + 1 : n - 1);
+  };
+
+  return makeIndexTask(
+      range(nodeContainXNBoundary(), nodeContainXPBoundary(),
+            _grid_space->sizeX()),
+      range(nodeContainYNBoundary(), nodeContainYPBoundary(),
+            _grid_space->sizeY()),
+      range(nodeContainZNBoundary(), nodeContainZPBoundary(),
+            _grid_space->sizeZ()));
+}
 
 void Domain::correctE() {
-  for (auto&& c : _correctors) {
-    c->correctE();
-  }
+  profile(ProfilePhase::CORRECT_E, {}, [this]() {
+    for (std::size_t i{0}; i < _correctors.size(); ++i) {
+      profile(ProfilePhase::CORRECT_E, correctorName(i),
+              [&c = _correctors[i]]() { c->correctE(); });
+    }
+  });
 }
 
 void Domain::correctH() {
-  for (auto&& c : _correctors) {
-    c->correctH();
-  }
+  profile(ProfilePhase::CORRECT_H, {}, [this]() {
+    for (std::size_t i{0}; i < _correctors.size(); ++i) {
+      profile(ProfilePhase::CORRECT_H, correctorName(i),
+              [&c = _correctors[i]]() { c->correctH(); });
+    }
+  });
 }
 
-void Domain::threadSynchronize() { _barrier.arrive_and_wait(); }
+void Domain::threadSynchronize() {
+  profile(ProfilePhase::BARRIER, {}, [this]() { _barrier.arrive_and_wait(); });
+  if (_abort != nullptr && _abort->load()) {
+    throw DomainAborted{};
+  }
+}
 
 void Domain::processSynchronize() {
   if (!isMaster()) {
     return;
   }
 
-  MpiSupport::instance().barrier();
+  profile(ProfilePhase::BARRIER, "MPI",
+          []() { MpiSupport::instance().barrier(); });
 }
 
 void Domain::synchronize() {
@@ -174,19 +244,86 @@ void Domain::synchronize() {
 }
 
 void Domain::record() {
-  for (auto&& m : _monitors) {
-    m->update();
+  const auto task = recordTask();
+  bool sharded = false;
+
+  profile(ProfilePhase::RECORD, {}, [this, &task, &sharded]() {
+    for (std::size_t i{0}; i < _monitors.size(); ++i) {
+      const auto& m = _monitors[i];
+      if (m->shardable()) {
+        profile(ProfilePhase::RECORD, monitorName(i),
+                [&]() { m->updateShard(_id, task); });
+        sharded = true;
+      } else if (isMaster()) {
+        profile(ProfilePhase::RECORD, monitorName(i), [&]() { m->update(); });
+      }
+    }
+
+    for (std::size_t i{0}; i < _nfffts.size(); ++i) {
+      const auto& n = _nfffts[i];
+      if (n->shardable()) {
+        profile(ProfilePhase::RECORD, nffftName(i),
+                [&]() { n->updateShard(_id, task); });
+        sharded = true;
+      } else if (isMaster()) {
+        profile(ProfilePhase::RECORD, nffftName(i), [&]() { n->update(); });
+      }
+    }
+  });
+
+  if (!sharded) {
+    return;
   }
 
-  for (auto&& n : _nfffts) {
-    n->update();
+  threadSynchronize();
+
+  if (!isMaster()) {
+    return;
   }
+
+  // Shards are combined by the master in domain order, so the result doesn't
+  // depend on which thread finishes first.
+  profile(ProfilePhase::RECORD, {}, [this]() {
+    for (std::size_t i{0}; i < _monitors.size(); ++i) {
+      if (_monitors[i]->shardable()) {
+        profile(ProfilePhase::RECORD, monitorName(i),
+                [&m = _monitors[i]]() { m->reduceShards(); });
+      }
+    }
+
+    for (std::size_t i{0}; i < _nfffts.size(); ++i) {
+      if (_nfffts[i]->shardable()) {
+        profile(ProfilePhase::RECORD, nffftName(i),
+                [&n = _nfffts[i]]() { n->reduceShards(); });
+      }
+    }
+  });
+}
+
+auto Domain::recordTask() const -> IndexTask {
+  // The thread tasks cover the cells. The last node plane belongs to the task
+  // at the end of the axis, so the tasks cover every node exactly once.
+  auto extend = [](const IndexRange& range, Index n) {
+    return makeIndexRange(range.start(),
+                          range.end() == n ? n + 1 : range.end());
+  };
+
+  return makeIndexTask(extend(_task.xRange(), _grid_space->sizeX()),
+                       extend(_task.yRange(), _grid_space->sizeY()),
+                       extend(_task.zRange(), _grid_space->sizeZ()));
 }
 
 void Domain::nextStep() {
-  if (isMaster()) {
-    _calculation_param->timeParam()->nextStep();
+  if (!isMaster()) {
+    return;
   }
+
+  profile(ProfilePhase::NEXT_STEP, {}, [this]() {
+    _calculation_param->timeParam()->nextStep();
+    for (auto&& w : _waveform_sources) {
+      w->nextStep();
+    }
+  });
 }
 
 auto Domain::toString() const -> std::string {
@@ -213,6 +350,96 @@ auto Domain::addVisitor(std::shared_ptr<SimulationFlagVisitor> visitor)
   _simulation_flag_visitors.emplace_back(std::move(visitor));
 }
 
+auto Domain::setCheckpoint(Index interval,
+                           std::function<void()> capture) -> void {
+  _checkpoint_interval = interval;
+  _checkpoint_capture = std::move(capture);
+}
+
+auto Domain::setProfileVisitors(
+    std::vector<std::shared_ptr<SimulationProfileVisitor>> visitors) -> void {
+  _profile_visitors = std::move(visitors);
+  _rank = MpiSupport::instance().rank();
+
+  // Instances are told apart by name; an index keeps equal names apart.
+  _corrector_names.clear();
+  for (std::size_t i{0}; i < _correctors.size(); ++i) {
+    std::stringstream ss;
+    ss << i << ": " << _correctors[i]->toString();
+    _corrector_names.emplace_back(ss.str());
+  }
+
+  _monitor_names.clear();
+  for (std::size_t i{0}; i < _monitors.size(); ++i) {
+    std::stringstream ss;
+    ss << i << ": " << _monitors[i]->name();
+    _monitor_names.emplace_back(ss.str());
+  }
+
+  _nffft_names.clear();
+  for (std::size_t i{0}; i < _nfffts.size(); ++i) {
+    std::stringstream ss;
+    ss << i << ": NF2FF " << _nfffts[i]->outputDir();
+    _nffft_names.emplace_back(ss.str());
+  }
+}
+
+auto Domain::correctHRegion() const -> std::optional<std::vector<IndexTask>> {
+  auto region = std::vector<IndexTask>{};
+  for (const auto& c : _correctors) {
+    auto r = c->correctHRegion();
+    if (!r.has_value()) {
+      return std::nullopt;
+    }
+
+    region.insert(region.end(), r->begin(), r->end());
+  }
+
+  // H in the overlap with the neighbor node is received in exchangeH()
+  const auto nx = _grid_space->sizeX();
+  const auto ny = _grid_space->sizeY();
+  const auto nz = _grid_space->sizeZ();
+  const auto whole_x = makeIndexRange(0, nx + 1);
+  const auto whole_y = makeIndexRange(0, ny + 1);
+  const auto whole_z = makeIndexRange(0, nz + 1);
+  auto tail = [](Index n) { return makeIndexRange(n < 2 ? 0 : n - 2, n + 1); };
+
+  if (!nodeContainXNBoundary()) {
+    region.emplace_back(makeIndexTask(makeIndexRange(0, 2), whole_y, whole_z));
+  }
+  if (!nodeContainXPBoundary()) {
+    region.emplace_back(makeIndexTask(tail(nx), whole_y, whole_z));
+  }
+  if (!nodeContainYNBoundary()) {
+    region.emplace_back(makeIndexTask(whole_x, makeIndexRange(0, 2), whole_z));
+  }
+  if (!nodeContainYPBoundary()) {
+    region.emplace_back(makeIndexTask(whole_x, tail(ny), whole_z));
+  }
+  if (!nodeContainZNBoundary()) {
+    region.emplace_back(makeIndexTask(whole_x, whole_y, makeIndexRange(0, 2)));
+  }
+  if (!nodeContainZPBoundary()) {
+    region.emplace_back(makeIndexTask(whole_x, whole_y, tail(nz)));
+  }
+
+  return region;
+}
+
+auto Domain::correctERegion() const -> std::optional<std::vector<IndexTask>> {
+  auto region = std::vector<IndexTask>{};
+  for (const auto& c : _correctors) {
+    auto r = c->correctERegion();
+    if (!r.has_value()) {
+      return std::nullopt;
+    }
+
+    region.insert(region.end(), r->begin(), r->end());
+  }
+
+  return region;
+}
+
 auto Domain::sendInitFlag(SimulationInitFlag flag) -> void {
   if (!isMaster() || !MpiSupport::instance().isRoot()) {
     return;
@@ -235,10 +462,25 @@ auto Domain::sendIteratorFlag(SimulationIteratorFlag flag, Index cur,
 }
 
 void Domain::exchangeH() {
+  beginExchangeH();
+  endExchangeH();
+}
+
+auto Domain::beginExchangeH() -> void {
+  if (_halo_exchange != nullptr) {
+    profile(ProfilePhase::EXCHANGE_H, "post",
+            [this]() { _halo_exchange->post(); });
+    return;
+  }
+
   if (!isMaster()) {
     return;
   }
 
+  profile(ProfilePhase::EXCHANGE_H, "post", [this]() { postExchangeH(); });
+}
+
+auto Domain::postExchangeH() -> void {
   auto& mpi_support = MpiSupport::instance();
 
   auto& hx = _emf->hx();
@@ -274,8 +516,21 @@ void Domain::exchangeH() {
     mpi_support.recvSendHxZTail(hx);
     mpi_support.recvSendHyZTail(hy);
   }
+}
+
+auto Domain::endExchangeH() -> void {
+  if (_halo_exchange != nullptr) {
+    profile(ProfilePhase::EXCHANGE_H, "wait",
+            [this]() { _halo_exchange->wait(); });
+    return;
+  }
+
+  if (!isMaster()) {
+    return;
+  }
 
-  mpi_support.waitAll();
+  profile(ProfilePhase::EXCHANGE_H, "wait",
+          []() { MpiSupport::instance().waitAll(); });
 }
 
 }  // namespace xfdtd
@@ -521,6 +521,11 @@ void GridSpace::correctGridSpaceForOne(Real dl, const Array1D<Real>& e_node,
   h_node = calculateHNode(e_node);
   e_size = calculateESize(e_node);
   h_size = calculateHSize(h_node, e_node, dl);
+
+  // A graded mesh is told apart by its cell sizes, far beyond rounding.
+  if (dl * 1e-3 < xt::amax(e_size)() - xt::amin(e_size)()) {
+    _type = Type::NONUNIFORM;
+  }
 }
 
 Array1D<Real> GridSpace::calculateHNode(const Array1D<Real>& e_node) {
@@ -4,6 +4,9 @@
 #include <xfdtd/grid_space/grid_space_generator.h>
 #include <xfdtd/shape/shape.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -33,6 +36,61 @@ std::unique_ptr<GridSpace> GridSpaceGenerator::generateUniformGridSpace(
   }
 }
 
+std::unique_ptr<GridSpace> GridSpaceGenerator::generateGradedGridSpace(
+    const std::vector<const Shape*>& shapes,
+    const std::vector<const Boundary*>& boundaries, Real based_dx,
+    Real based_dy, Real based_dz, Real min_dx, Real min_dy, Real min_dz,
+    Real max_ratio) {
+  if (min_dx <= 0 || min_dy <= 0 || min_dz <= 0 || max_ratio <= 1) {
+    throw XFDTDGridSpaceException{
+        "Graded mesh needs positive minimum cell sizes and max_ratio > 1"};
+  }
+
+  auto domain = Shape::makeWrappedCube(shapes);
+  auto padded = extendDomain(std::make_unique<Cube>(*domain), boundaries,
+                             based_dx, based_dy, based_dz);
+
+  std::vector<Real> lines_x;
+  std::vector<Real> lines_y;
+  std::vector<Real> lines_z;
+  for (const auto& s : shapes) {
+    auto cube{s->wrappedCube()};
+    lines_x.insert(lines_x.end(), {cube->originX(), cube->endX()});
+    lines_y.insert(lines_y.end(), {cube->originY(), cube->endY()});
+    lines_z.insert(lines_z.end(), {cube->originZ(), cube->endZ()});
+  }
+
+  auto node_x = [&]() {
+    return generateGradedNode(domain->originX(), domain->endX(),
+                              padded->originX(), padded->endX(),
+                              std::move(lines_x), based_dx, min_dx, max_ratio);
+  };
+  auto node_y = [&]() {
+    return generateGradedNode(domain->originY(), domain->endY(),
+                              padded->originY(), padded->endY(),
+                              std::move(lines_y), based_dy, min_dy, max_ratio);
+  };
+  auto node_z = [&]() {
+    return generateGradedNode(domain->originZ(), domain->endZ(),
+                              padded->originZ(), padded->endZ(),
+                              std::move(lines_z), based_dz, min_dz, max_ratio);
+  };
+
+  auto dimension{decideDimension(domain.get())};
+  switch (dimension) {
+    case GridSpace::Dimension::ONE:
+      return std::make_unique<GridSpace1D>(based_dz, node_z());
+    case GridSpace::Dimension::TWO:
+      return std::make_unique<GridSpace2D>(based_dx, based_dy, node_x(),
+                                           node_y());
+    case GridSpace::Dimension::THREE:
+      return std::make_unique<GridSpace3D>(based_dx, based_dy, based_dz,
+                                           node_x(), node_y(), node_z());
+    default:
+      throw XFDTDGridSpaceException{"GridSpace dimension is undefined"};
+  }
+}
+
 std::unique_ptr<Cube> GridSpaceGenerator::extendDomain(
     std::unique_ptr<Cube> domain,
     const std::vector<const Boundary*>& boundaries, Real based_dx,
@@ -216,4 +274,96 @@ std::unique_ptr<GridSpace> GridSpaceGenerator::generateGridSpace3D(
                                        std::move(e_node_z));
 }
 
+Array1D<Real> GridSpaceGenerator::generateGradedNode(
+    Real start, Real end, Real padded_start, Real padded_end,
+    std::vector<Real> lines, Real based_dl, Real min_dl, Real max_ratio) {
+  min_dl = std::min(min_dl, based_dl);
+  const auto tolerance = min_dl / 2;
+  if (end - start < 2 * min_dl) {
+    throw XFDTDGridSpaceException{"GridSpace is too small"};
+  }
+
+  // Faces on the domain bounds don't refine: the PML follows there.
+  lines.erase(std::remove_if(lines.begin(), lines.end(),
+                             [&](Real l) {
+                               return !std::isfinite(l) ||
+                                      l < start + tolerance ||
+                                      end - tolerance < l;
+                             }),
+              lines.end());
+  std::sort(lines.begin(), lines.end());
+
+  // The wanted cell size grows linearly with the distance to the nearest
+  // line, so each cell is max_ratio times its neighbour towards the line.
+  auto cell_size = [&](Real x) {
+    auto distance = std::numeric_limits<Real>::max();
+    auto it = std::lower_bound(lines.begin(), lines.end(), x);
+    if (it != lines.end()) {
+      distance = *it - x;
+    }
+    if (it != lines.begin()) {
+      distance = std::min(distance, x - *std::prev(it));
+    }
+    return std::min(based_dl, min_dl + (max_ratio - 1) * distance);
+  };
+
+  // Lines closer than half a minimum cell share a node.
+  std::vector<Real> breaks{start};
+  for (auto l : lines) {
+    if (breaks.back() + tolerance < l) {
+      breaks.emplace_back(l);
+    }
+  }
+  breaks.emplace_back(end);
+
+  std::vector<Real> nodes;
+  const auto num_front =
+      static_cast<Index>(std::round((start - padded_start) / based_dl));
+  for (auto n{num_front}; 0 < n; --n) {
+    nodes.emplace_back(start - n * based_dl);
+  }
+  nodes.emplace_back(start);
+
+  // Between two breaks the number of cells is the integral of 1 / cell_size,
+  // rounded up, and the nodes split that integral evenly.
+  constexpr Index samples_per_cell = 8;
+  for (std::size_t b{1}; b < breaks.size(); ++b) {
+    const auto a = breaks[b - 1];
+    const auto length = breaks[b] - a;
+    const auto num_sample = std::max<Index>(
+        1, static_cast<Index>(
+               std::ceil(length * samples_per_cell / min_dl)));
+    const auto step = length / num_sample;
+
+    std::vector<Real> integral(num_sample + 1, 0);
+    for (Index q{0}; q < num_sample; ++q) {
+      integral[q + 1] = integral[q] + step / cell_size(a + (q + 0.5) * step);
+    }
+
+    const auto num_cell = std::max<Index>(
+        1, static_cast<Index>(std::ceil(integral.back() - 1e-3)));
+    const auto share = integral.back() / num_cell;
+    Index q{0};
+    for (Index c{1}; c < num_cell; ++c) {
+      const auto target = c * share;
+      while (q + 2 < integral.size() && integral[q + 1] < target) {
+        ++q;
+      }
+      const auto t = (target - integral[q]) / (integral[q + 1] - integral[q]);
+      nodes.emplace_back(a + (q + t) * step);
+    }
+    nodes.emplace_back(breaks[b]);
+  }
+
+  const auto num_back =
+      static_cast<Index>(std::round((padded_end - end) / based_dl));
+  for (Index n{1}; n <= num_back; ++n) {
+    nodes.emplace_back(end + n * based_dl);
+  }
+
+  Array1D<Real> e_node = xt::empty<Real>({nodes.size()});
+  std::copy(nodes.begin(), nodes.end(), e_node.begin());
+  return e_node;
+}
+
 }  // namespace xfdtd
\ No newline at end of file
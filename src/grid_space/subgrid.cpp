@@ -0,0 +1,416 @@
+#include <xfdtd/grid_space/subgrid.h>
+#include <xfdtd/material/material.h>
+#include <xfdtd/simulation/checkpoint.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+namespace xfdtd {
+
+Subgrid::Subgrid(std::string name, std::unique_ptr<Cube> region, Index ratio)
+    : _name{std::move(name)},
+      _region{std::move(region)},
+      _ratio{ratio},
+      _margin{0} {
+  if (_ratio < 2) {
+    throw XFDTDSubgridException("Subgrid " + _name + ": ratio must be >= 2");
+  }
+}
+
+Subgrid::Subgrid(std::string name, const Object& object, Index ratio,
+                 Index margin)
+    : Subgrid{std::move(name), object.shape()->wrappedCube(), ratio} {
+  _margin = margin;
+}
+
+auto Subgrid::init(std::shared_ptr<const GridSpace> grid_space,
+                   std::shared_ptr<CalculationParam> calculation_param,
+                   std::shared_ptr<EMF> emf,
+                   const std::vector<std::shared_ptr<Object>>& objects)
+    -> void {
+  if (grid_space->dimension() != GridSpace::Dimension::THREE) {
+    throw XFDTDSubgridException("Subgrid " + _name + ": only for 3D");
+  }
+  if (grid_space->type() != GridSpace::Type::UNIFORM) {
+    throw XFDTDSubgridException("Subgrid " + _name +
+                                ": the coarse grid must be uniform");
+  }
+
+  _emf = std::move(emf);
+
+  // Snap to the coarse cells and add the margin, inside the grid
+  const auto box = grid_space->getGridBox(_region.get());
+  auto extend = [m = _margin](Index start, Index end, Index n) {
+    return std::pair{start < m ? 0 : start - m, std::min(end + m, n)};
+  };
+  const auto [is, ie] =
+      extend(box.origin().i(), box.end().i(), grid_space->sizeX());
+  const auto [js, je] =
+      extend(box.origin().j(), box.end().j(), grid_space->sizeY());
+  const auto [ks, ke] =
+      extend(box.origin().k(), box.end().k(), grid_space->sizeZ());
+  if (ie - is < 2 || je - js < 2 || ke - ks < 2) {
+    std::stringstream ss;
+    ss << "Subgrid " << _name << ": the box must be at least 2 coarse cells "
+       << "along each axis, got " << ie - is << " x " << je - js << " x "
+       << ke - ks;
+    throw XFDTDSubgridException(ss.str());
+  }
+  _box = GridBox{Grid{is, js, ks}, Grid{ie - is, je - js, ke - ks}};
+
+  _nx = (ie - is) * _ratio;
+  _ny = (je - js) * _ratio;
+  _nz = (ke - ks) * _ratio;
+  _dx = grid_space->basedDx() / static_cast<Real>(_ratio);
+  _dy = grid_space->basedDy() / static_cast<Real>(_ratio);
+  _dz = grid_space->basedDz() / static_cast<Real>(_ratio);
+
+  allocate();
+  sampleMaterial(*grid_space, objects,
+                 calculation_param->timeParam()->dt() /
+                     static_cast<Real>(_ratio));
+  collectBoundary();
+}
+
+auto Subgrid::correctE() -> void {
+  for (auto&& b : _boundary) {
+    b._new = interpolate(b);
+  }
+
+  const auto r = static_cast<Real>(_ratio);
+  for (Index m{1}; m <= _ratio; ++m) {
+    updateH();
+    updateE();
+
+    const auto a = static_cast<Real>(m) / r;
+    for (auto&& b : _boundary) {
+      *b._fine = b._old + a * (b._new - b._old);
+    }
+  }
+
+  for (auto&& b : _boundary) {
+    b._old = b._new;
+  }
+
+  restrictE();
+}
+
+auto Subgrid::toString() const -> std::string {
+  std::stringstream ss;
+  ss << "Subgrid: " << _name << ", ratio " << _ratio << ", coarse "
+     << _box.toString() << ", fine " << _nx << " x " << _ny << " x " << _nz;
+  return ss.str();
+}
+
+auto Subgrid::saveState(Checkpoint& checkpoint,
+                        const std::string& prefix) const -> void {
+  checkpoint.save(prefix + "ex", _ex);
+  checkpoint.save(prefix + "ey", _ey);
+  checkpoint.save(prefix + "ez", _ez);
+  checkpoint.save(prefix + "hx", _hx);
+  checkpoint.save(prefix + "hy", _hy);
+  checkpoint.save(prefix + "hz", _hz);
+
+  auto old = std::vector<Real>(_boundary.size());
+  for (std::size_t n{0}; n < _boundary.size(); ++n) {
+    old[n] = _boundary[n]._old;
+  }
+  checkpoint.save(prefix + "boundary_old", old);
+}
+
+auto Subgrid::loadState(const Checkpoint& checkpoint,
+                        const std::string& prefix) -> void {
+  checkpoint.load(prefix + "ex", _ex);
+  checkpoint.load(prefix + "ey", _ey);
+  checkpoint.load(prefix + "ez", _ez);
+  checkpoint.load(prefix + "hx", _hx);
+  checkpoint.load(prefix + "hy", _hy);
+  checkpoint.load(prefix + "hz", _hz);
+
+  auto old = std::vector<Real>(_boundary.size());
+  checkpoint.load(prefix + "boundary_old", old);
+  for (std::size_t n{0}; n < _boundary.size(); ++n) {
+    _boundary[n]._old = old[n];
+  }
+}
+
+auto Subgrid::allocate() -> void {
+  auto make = [](Index nx, Index ny, Index nz) {
+    return Array3D<Real>::from_shape({nx, ny, nz});
+  };
+
+  _ex = make(_nx, _ny + 1, _nz + 1);
+  _ey = make(_nx + 1, _ny, _nz + 1);
+  _ez = make(_nx + 1, _ny + 1, _nz);
+  _hx = make(_nx + 1, _ny, _nz);
+  _hy = make(_nx, _ny + 1, _nz);
+  _hz = make(_nx, _ny, _nz + 1);
+  for (auto* f : {&_ex, &_ey, &_ez, &_hx, &_hy, &_hz}) {
+    f->fill(0);
+  }
+
+  _cexe = make(_nx, _ny + 1, _nz + 1);
+  _cexh = make(_nx, _ny + 1, _nz + 1);
+  _ceye = make(_nx + 1, _ny, _nz + 1);
+  _ceyh = make(_nx + 1, _ny, _nz + 1);
+  _ceze = make(_nx + 1, _ny + 1, _nz);
+  _cezh = make(_nx + 1, _ny + 1, _nz);
+  _chxh = make(_nx + 1, _ny, _nz);
+  _chxe = make(_nx + 1, _ny, _nz);
+  _chyh = make(_nx, _ny + 1, _nz);
+  _chye = make(_nx, _ny + 1, _nz);
+  _chzh = make(_nx, _ny, _nz + 1);
+  _chze = make(_nx, _ny, _nz + 1);
+}
+
+auto Subgrid::sampleMaterial(
+    const GridSpace& grid_space,
+    const std::vector<std::shared_ptr<Object>>& objects, Real dt) -> void {
+  const auto x0 = grid_space.eNodeX()(_box.origin().i());
+  const auto y0 = grid_space.eNodeY()(_box.origin().j());
+  const auto z0 = grid_space.eNodeZ()(_box.origin().k());
+  const auto eps = grid_space.eps();
+
+  // The last object containing the point, as in the coarse material space
+  auto property = [&](Real x, Real y, Real z) {
+    for (auto it = objects.rbegin(); it != objects.rend(); ++it) {
+      const auto& o = *it;
+      if (!o->shape()->isInside(x, y, z, eps)) {
+        continue;
+      }
+
+      if (o->material()->dispersion()) {
+        std::stringstream ss;
+        ss << "Subgrid " << _name << ": dispersive object " << o->name()
+           << " isn't supported in a subgrid";
+        throw XFDTDSubgridException(ss.str());
+      }
+      return o->material()->emProperty();
+    }
+    return ElectroMagneticProperty::air();
+  };
+
+  // offset: position of the component in the cell, in fine cells
+  auto fill = [&](Array3D<Real>& c_self, Array3D<Real>& c_curl,
+                  const std::array<Real, 3>& offset, bool electric) {
+    const auto& shape = c_self.shape();
+    for (Index i{0}; i < shape[0]; ++i) {
+      for (Index j{0}; j < shape[1]; ++j) {
+        for (Index k{0}; k < shape[2]; ++k) {
+          const auto p = property(x0 + (i + offset[0]) * _dx,
+                                  y0 + (j + offset[1]) * _dy,
+                                  z0 + (k + offset[2]) * _dz);
+          const auto m = electric ? p.epsilon() : p.mu();
+          const auto s = (electric ? p.sigmaE() : p.sigmaM()) * dt;
+          c_self(i, j, k) = (2 * m - s) / (2 * m + s);
+          c_curl(i, j, k) = 2 * dt / (2 * m + s);
+        }
+      }
+    }
+  };
+
+  fill(_cexe, _cexh, {0.5, 0, 0}, true);
+  fill(_ceye, _ceyh, {0, 0.5, 0}, true);
+  fill(_ceze, _cezh, {0, 0, 0.5}, true);
+  fill(_chxh, _chxe, {0, 0.5, 0.5}, false);
+  fill(_chyh, _chye, {0.5, 0, 0.5}, false);
+  fill(_chzh, _chze, {0.5, 0.5, 0}, false);
+}
+
+auto Subgrid::collectBoundary() -> void {
+  const auto r = static_cast<Real>(_ratio);
+  const auto origin = std::array<Real, 3>{
+      static_cast<Real>(_box.origin().i()),
+      static_cast<Real>(_box.origin().j()),
+      static_cast<Real>(_box.origin().k())};
+
+  // offset: position of the component in the cell; on_face(i, j, k) tells
+  // whether the component is tangential on a face of the fine box there
+  auto collect = [&](Array3D<Real>& fine, const Array3D<Real>& coarse,
+                     const std::array<Real, 3>& offset, auto&& on_face) {
+    const auto& shape = fine.shape();
+    const auto& coarse_shape = coarse.shape();
+
+    // Position in coarse index space and the weight of the upper neighbour
+    auto locate = [&](Index n, Index axis, Index& lower, Real& w) {
+      const auto q = std::max(
+          origin[axis] + (static_cast<Real>(n) + offset[axis]) / r -
+              offset[axis],
+          Real{0});
+      const auto last = coarse_shape[axis] < 2 ? 0 : coarse_shape[axis] - 2;
+      lower = std::min(static_cast<Index>(std::floor(q)), last);
+      w = std::clamp(q - static_cast<Real>(lower), Real{0}, Real{1});
+    };
+
+    for (Index i{0}; i < shape[0]; ++i) {
+      for (Index j{0}; j < shape[1]; ++j) {
+        for (Index k{0}; k < shape[2]; ++k) {
+          if (!on_face(i, j, k)) {
+            continue;
+          }
+
+          BoundaryNode b{};
+          b._fine = &fine(i, j, k);
+          b._coarse = &coarse;
+          locate(i, 0, b._i, b._wx);
+          locate(j, 1, b._j, b._wy);
+          locate(k, 2, b._k, b._wz);
+          _boundary.emplace_back(b);
+        }
+      }
+    }
+  };
+
+  collect(_ex, _emf->ex(), {0.5, 0, 0}, [this](Index, Index j, Index k) {
+    return j == 0 || j == _ny || k == 0 || k == _nz;
+  });
+  collect(_ey, _emf->ey(), {0, 0.5, 0}, [this](Index i, Index, Index k) {
+    return i == 0 || i == _nx || k == 0 || k == _nz;
+  });
+  collect(_ez, _emf->ez(), {0, 0, 0.5}, [this](Index i, Index j, Index) {
+    return i == 0 || i == _nx || j == 0 || j == _ny;
+  });
+}
+
+auto Subgrid::interpolate(const BoundaryNode& b) const -> Real {
+  const auto& c = *b._coarse;
+  const auto i = b._i;
+  const auto j = b._j;
+  const auto k = b._k;
+  auto lerp = [](Real a, Real b, Real w) { return a + w * (b - a); };
+
+  const auto c00 = lerp(c(i, j, k), c(i, j, k + 1), b._wz);
+  const auto c01 = lerp(c(i, j + 1, k), c(i, j + 1, k + 1), b._wz);
+  const auto c10 = lerp(c(i + 1, j, k), c(i + 1, j, k + 1), b._wz);
+  const auto c11 = lerp(c(i + 1, j + 1, k), c(i + 1, j + 1, k + 1), b._wz);
+  return lerp(lerp(c00, c01, b._wy), lerp(c10, c11, b._wy), b._wx);
+}
+
+auto Subgrid::updateH() -> void {
+  const auto rdx = 1 / _dx;
+  const auto rdy = 1 / _dy;
+  const auto rdz = 1 / _dz;
+
+  for (Index i{0}; i <= _nx; ++i) {
+    for (Index j{0}; j < _ny; ++j) {
+      for (Index k{0}; k < _nz; ++k) {
+        const auto curl = (_ez(i, j + 1, k) - _ez(i, j, k)) * rdy -
+                          (_ey(i, j, k + 1) - _ey(i, j, k)) * rdz;
+        _hx(i, j, k) = _chxh(i, j, k) * _hx(i, j, k) - _chxe(i, j, k) * curl;
+      }
+    }
+  }
+
+  for (Index i{0}; i < _nx; ++i) {
+    for (Index j{0}; j <= _ny; ++j) {
+      for (Index k{0}; k < _nz; ++k) {
+        const auto curl = (_ex(i, j, k + 1) - _ex(i, j, k)) * rdz -
+                          (_ez(i + 1, j, k) - _ez(i, j, k)) * rdx;
+        _hy(i, j, k) = _chyh(i, j, k) * _hy(i, j, k) - _chye(i, j, k) * curl;
+      }
+    }
+  }
+
+  for (Index i{0}; i < _nx; ++i) {
+    for (Index j{0}; j < _ny; ++j) {
+      for (Index k{0}; k <= _nz; ++k) {
+        const auto curl = (_ey(i + 1, j, k) - _ey(i, j, k)) * rdx -
+                          (_ex(i, j + 1, k) - _ex(i, j, k)) * rdy;
+        _hz(i, j, k) = _chzh(i, j, k) * _hz(i, j, k) - _chze(i, j, k) * curl;
+      }
+    }
+  }
+}
+
+auto Subgrid::updateE() -> void {
+  const auto rdx = 1 / _dx;
+  const auto rdy = 1 / _dy;
+  const auto rdz = 1 / _dz;
+
+  // The tangential E on the faces is set from the coarse grid
+  for (Index i{0}; i < _nx; ++i) {
+    for (Index j{1}; j < _ny; ++j) {
+      for (Index k{1}; k < _nz; ++k) {
+        const auto curl = (_hz(i, j, k) - _hz(i, j - 1, k)) * rdy -
+                          (_hy(i, j, k) - _hy(i, j, k - 1)) * rdz;
+        _ex(i, j, k) = _cexe(i, j, k) * _ex(i, j, k) + _cexh(i, j, k) * curl;
+      }
+    }
+  }
+
+  for (Index i{1}; i < _nx; ++i) {
+    for (Index j{0}; j < _ny; ++j) {
+      for (Index k{1}; k < _nz; ++k) {
+        const auto curl = (_hx(i, j, k) - _hx(i, j, k - 1)) * rdz -
+                          (_hz(i, j, k) - _hz(i - 1, j, k)) * rdx;
+        _ey(i, j, k) = _ceye(i, j, k) * _ey(i, j, k) + _ceyh(i, j, k) * curl;
+      }
+    }
+  }
+
+  for (Index i{1}; i < _nx; ++i) {
+    for (Index j{1}; j < _ny; ++j) {
+      for (Index k{0}; k < _nz; ++k) {
+        const auto curl = (_hy(i, j, k) - _hy(i - 1, j, k)) * rdx -
+                          (_hx(i, j, k) - _hx(i, j - 1, k)) * rdy;
+        _ez(i, j, k) = _ceze(i, j, k) * _ez(i, j, k) + _cezh(i, j, k) * curl;
+      }
+    }
+  }
+}
+
+auto Subgrid::restrictE() -> void {
+  const auto is = _box.origin().i();
+  const auto js = _box.origin().j();
+  const auto ks = _box.origin().k();
+  const auto ie = _box.end().i();
+  const auto je = _box.end().j();
+  const auto ke = _box.end().k();
+  const auto r = _ratio;
+  const auto inv_r = 1 / static_cast<Real>(r);
+
+  // Every coarse edge strictly inside the box is the mean of its r fine edges
+  auto& ex = _emf->ex();
+  for (Index i{is}; i < ie; ++i) {
+    for (Index j{js + 1}; j < je; ++j) {
+      for (Index k{ks + 1}; k < ke; ++k) {
+        Real sum{0};
+        for (Index a{0}; a < r; ++a) {
+          sum += _ex(r * (i - is) + a, r * (j - js), r * (k - ks));
+        }
+        ex(i, j, k) = sum * inv_r;
+      }
+    }
+  }
+
+  auto& ey = _emf->ey();
+  for (Index i{is + 1}; i < ie; ++i) {
+    for (Index j{js}; j < je; ++j) {
+      for (Index k{ks + 1}; k < ke; ++k) {
+        Real sum{0};
+        for (Index a{0}; a < r; ++a) {
+          sum += _ey(r * (i - is), r * (j - js) + a, r * (k - ks));
+        }
+        ey(i, j, k) = sum * inv_r;
+      }
+    }
+  }
+
+  auto& ez = _emf->ez();
+  for (Index i{is + 1}; i < ie; ++i) {
+    for (Index j{js + 1}; j < je; ++j) {
+      for (Index k{ks}; k < ke; ++k) {
+        Real sum{0};
+        for (Index a{0}; a < r; ++a) {
+          sum += _ez(r * (i - is), r * (j - js), r * (k - ks) + a);
+        }
+        ez(i, j, k) = sum * inv_r;
+      }
+    }
+  }
+}
+
+}  // namespace xfdtd
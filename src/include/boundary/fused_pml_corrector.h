@@ -0,0 +1,63 @@
+#ifndef _XFDTD_CORE_FUSED_PML_CORRECTOR_H_
+#define _XFDTD_CORE_FUSED_PML_CORRECTOR_H_
+
+#include <xfdtd/common/index_task.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/electromagnetic_field/electromagnetic_field.h>
+
+#include <array>
+#include <vector>
+
+#include "boundary/pml_corrector.h"
+#include "corrector/corrector.h"
+
+namespace xfdtd {
+
+/**
+ * @brief Applies the corrections of several PMLCorrector in one pass per
+ * field component.
+ *
+ * Each row (i, j) of a component is cut in k where a PML slab starts or ends.
+ * A cell in an edge or a corner, where two or three slabs overlap, is read and
+ * written once and all its psi terms are applied in between. The terms are
+ * applied in the order the correctors were added, so the result is the same
+ * as running the correctors one after the other.
+ */
+class FusedPMLCorrector : public Corrector {
+ public:
+  FusedPMLCorrector() = default;
+
+  ~FusedPMLCorrector() override = default;
+
+  auto add(PMLCorrectorBase& corrector) -> void;
+
+  auto empty() const -> bool { return _regions.empty(); }
+
+  auto correctE() -> void override;
+
+  auto correctH() -> void override;
+
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return _regions;
+  }
+
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return _regions;
+  }
+
+  auto toString() const -> std::string override;
+
+ private:
+  // Indexed by the field component
+  std::array<std::vector<PMLTerm>, 3> _e_terms, _h_terms;
+  std::vector<IndexTask> _regions;
+
+  template <EMF::Attribute attribute>
+  static auto correct(std::vector<PMLTerm>& terms) -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // _XFDTD_CORE_FUSED_PML_CORRECTOR_H_
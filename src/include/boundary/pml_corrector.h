@@ -7,6 +7,8 @@
 #include <xfdtd/electromagnetic_field/electromagnetic_field.h>
 #include <xfdtd/util/transform/abc_xyz.h>
 
+#include <vector>
+
 #include "corrector/corrector.h"
 
 namespace xfdtd {
@@ -51,8 +53,34 @@ inline auto correctPML(auto&& field, auto&& psi, const auto& coeff_a,
   }
 }
 
+/**
+ * @brief The correction of one field component by one PML over `_task`: the
+ * arguments of correctPML(), for FusedPMLCorrector.
+ */
+struct PMLTerm {
+  Axis::XYZ _component;
+  Axis::XYZ _main_axis;
+  IndexTask _task;
+  Array3D<Real>* _field;
+  const Array3D<Real>* _dual_field;
+  Array3D<Real>* _psi;
+  const Array3D<Real>* _c_psi;
+  const Array1D<Real>* _coeff_a;
+  const Array1D<Real>* _coeff_b;
+  Index _pml_global_start;
+  Index _pml_node_start;
+  Index _offset_c;
+};
+
+class PMLCorrectorBase : public Corrector {
+ public:
+  virtual auto task() const -> IndexTask = 0;
+
+  virtual auto terms(EMF::Attribute attribute) -> std::vector<PMLTerm> = 0;
+};
+
 template <Axis::XYZ xyz>
-class PMLCorrector : public Corrector {
+class PMLCorrector : public PMLCorrectorBase {
  public:
   PMLCorrector(EMF* emf, IndexTask task, IndexTask node_task,
                Index pml_global_e_start, Index pml_global_h_start,
@@ -84,16 +112,28 @@ class PMLCorrector : public Corrector {
         _ha_psi_eb{ha_psi_eb},
         _hb_psi_ea{hb_psi_ea} {}
 
-  ~PMLCorrector() = default;
+  ~PMLCorrector() override = default;
 
   auto correctE() -> void override;
 
   auto correctH() -> void override;
 
-  auto task() const { return _task; }
+  auto task() const -> IndexTask override { return _task; }
 
   auto nodeTask() const -> IndexTask { return _node_task; }
 
+  auto terms(EMF::Attribute attribute) -> std::vector<PMLTerm> override;
+
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{_task};
+  }
+
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{_task};
+  }
+
   auto toString() const -> std::string override {
     std::stringstream ss;
     ss << "PMLCorrector " << Axis::toString(xyz) << " " << task().toString();
@@ -130,6 +170,24 @@ class PMLCorrector : public Corrector {
     }
   }
 
+  template <EMF::Attribute attribute>
+  auto pmlGlobalStart() const -> Index {
+    if constexpr (attribute == EMF::Attribute::E) {
+      return _pml_global_e_start;
+    } else {
+      return _pml_global_h_start;
+    }
+  }
+
+  template <EMF::Attribute attribute>
+  auto pmlNodeStart() const -> Index {
+    if constexpr (attribute == EMF::Attribute::E) {
+      return _pml_node_e_start;
+    } else {
+      return _pml_node_h_start;
+    }
+  }
+
   template <EMF::Attribute attribute, Axis::XYZ xyz_0>
   auto cPsi() const -> Array3D<Real>& {
     constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
@@ -173,212 +231,120 @@ class PMLCorrector : public Corrector {
       }
     }
   }
-};
 
-template <Axis::XYZ xyz>
-inline auto PMLCorrector<xyz>::correctE() -> void {
-  constexpr auto attribute = EMF::Attribute::E;
-  constexpr auto dual_attribute = EMF::dualAttribute(attribute);
-  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
-  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
-  const auto pml_global_start = _pml_global_e_start;
-  const auto pml_node_start = _pml_node_e_start;
-  const auto task = this->task();
-  if (!task.valid()) {
-    return;
-  }
-
-  auto is = task.xRange().start();
-  auto js = task.yRange().start();
-  auto ks = task.zRange().start();
-
-  auto main_axis_offset = 0;
+  /**
+   * @brief The cells of component xyz_0 corrected by this corrector.
+   *
+   * EA: [a_s, a_e), [b_s, b_e + 1), [c_s, c_e)
+   * EB: [a_s, a_e + 1), [b_s, b_e), [c_s, c_e)
+   * HA: [a_s, a_e + 1), [b_s, b_e), [c_s, c_e)
+   * HB: [a_s, a_e), [b_s, b_e + 1), [c_s, c_e)
+   *
+   * The extra node is only taken at the end of the node. E at c == 0 lies on
+   * the boundary, so E starts at c_s + 1 there.
+   */
+  template <EMF::Attribute attribute, Axis::XYZ xyz_0>
+  auto range() const -> IndexTask {
+    constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+    constexpr auto extend_a =
+        (attribute == EMF::Attribute::E) == (xyz_0 == xyz_b);
+    const auto task = this->task();
 
-  {
-    // c == 0?
-    auto [a, b, c] = transform::xYZToABC<Index, xyz>(
+    auto [as, bs, cs] = transform::xYZToABC<Index, xyz>(
         task.xRange().start(), task.yRange().start(), task.zRange().start());
-    if (c == 0) {
-      auto [i, j, k] = transform::aBCToXYZ<Index, xyz>(a, b, c + 1);
-      main_axis_offset = 1;
-      is = i;
-      js = j;
-      ks = k;
-    }
-  }
-
-  const auto offset_c = _offset_c;
-
-  {
-    auto&& field = _emf->field<attribute, xyz_a>();
-    auto&& psi = this->psi<attribute, xyz_a>();
-    const auto& coeff_a = coeffA<attribute>();
-    const auto& coeff_b = coeffB<attribute>();
-    const auto& dual_field = _emf->field<dual_attribute, xyz_b>();
-    const auto& c_psi = cPsi<attribute, xyz_a>();
-    // correct EA: [a_s, a_e), [b_s, b_e + 1), [c_s, c_e)
-    auto [a, b, c] = transform::xYZToABC<Index, xyz>(nodeTask().xRange().end(),
-                                                     nodeTask().yRange().end(),
-                                                     nodeTask().zRange().end());
+    auto [an, bn, cn] = transform::xYZToABC<Index, xyz>(
+        nodeTask().xRange().end(), nodeTask().yRange().end(),
+        nodeTask().zRange().end());
     auto [ae, be, ce] = transform::xYZToABC<Index, xyz>(
         task.xRange().end(), task.yRange().end(), task.zRange().end());
 
-    // auto [ie, je, ke] =
-    //     transform::aBCToXYZ<Index, xyz>(a, b + 1, c + main_axis_offset);
-    Index ie = 0;
-    Index je = 0;
-    Index ke = 0;
-    if (be == b) {
-      auto [i, j, k] =
-          transform::aBCToXYZ<Index, xyz>(ae, be + 1, ce + main_axis_offset);
-      ie = i;
-      je = j;
-      ke = k;
-    } else {
-      auto [i, j, k] =
-          transform::aBCToXYZ<Index, xyz>(ae, be, ce + main_axis_offset);
-      ie = i;
-      je = j;
-      ke = k;
+    const Index main_axis_offset =
+        (attribute == EMF::Attribute::E && cs == 0) ? 1 : 0;
+    if (extend_a && ae == an) {
+      ++ae;
+    }
+    if (!extend_a && be == bn) {
+      ++be;
     }
 
-    correctPML<attribute, xyz>(field, psi, coeff_a, coeff_b, dual_field, c_psi,
-                               is, ie, js, je, ks, ke, pml_global_start,
-                               pml_node_start, offset_c);
+    auto [is, js, ks] =
+        transform::aBCToXYZ<Index, xyz>(as, bs, cs + main_axis_offset);
+    auto [ie, je, ke] =
+        transform::aBCToXYZ<Index, xyz>(ae, be, ce + main_axis_offset);
+    return makeIndexTask(makeIndexRange(is, ie), makeIndexRange(js, je),
+                         makeIndexRange(ks, ke));
   }
 
-  {
-    auto&& field = _emf->field<attribute, xyz_b>();
-    auto&& psi = this->psi<attribute, xyz_b>();
-    const auto& coeff_a = coeffA<attribute>();
-    const auto& coeff_b = coeffB<attribute>();
-    const auto& dual_field = _emf->field<dual_attribute, xyz_a>();
-    const auto& c_psi = cPsi<attribute, xyz_b>();
-    // correct EB: [a_s, a_e + 1), [b_s, b_e), [c_s, c_e)
-    auto [a, b, c] = transform::xYZToABC<Index, xyz>(nodeTask().xRange().end(),
-                                                     nodeTask().yRange().end(),
-                                                     nodeTask().zRange().end());
-    auto [ae, be, ce] = transform::xYZToABC<Index, xyz>(
-        task.xRange().end(), task.yRange().end(), task.zRange().end());
+  template <EMF::Attribute attribute, Axis::XYZ xyz_0>
+  auto dualField() -> Array3D<Real>& {
+    constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+    constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+    constexpr auto dual_xyz = (xyz_0 == xyz_a) ? xyz_b : xyz_a;
+    return _emf->field<EMF::dualAttribute(attribute), dual_xyz>();
+  }
 
-    // auto [ie, je, ke] =
-    //     transform::aBCToXYZ<Index, xyz>(a + 1, b, c + main_axis_offset);
-
-    Index ie = 0;
-    Index je = 0;
-    Index ke = 0;
-    if (ae == a) {
-      auto [i, j, k] =
-          transform::aBCToXYZ<Index, xyz>(ae + 1, be, ce + main_axis_offset);
-      ie = i;
-      je = j;
-      ke = k;
-    } else {
-      auto [i, j, k] =
-          transform::aBCToXYZ<Index, xyz>(ae, be, ce + main_axis_offset);
-      ie = i;
-      je = j;
-      ke = k;
-    }
+  template <EMF::Attribute attribute, Axis::XYZ xyz_0>
+  auto correct() -> void {
+    const auto r = range<attribute, xyz_0>();
+    correctPML<attribute, xyz>(
+        _emf->field<attribute, xyz_0>(), psi<attribute, xyz_0>(),
+        coeffA<attribute>(), coeffB<attribute>(),
+        dualField<attribute, xyz_0>(), cPsi<attribute, xyz_0>(),
+        r.xRange().start(), r.xRange().end(), r.yRange().start(),
+        r.yRange().end(), r.zRange().start(), r.zRange().end(),
+        pmlGlobalStart<attribute>(), pmlNodeStart<attribute>(), _offset_c);
+  }
 
-    correctPML<attribute, xyz>(field, psi, coeff_a, coeff_b, dual_field, c_psi,
-                               is, ie, js, je, ks, ke, pml_global_start,
-                               pml_node_start, offset_c);
+  template <EMF::Attribute attribute, Axis::XYZ xyz_0>
+  auto term() -> PMLTerm {
+    return PMLTerm{xyz_0,
+                   xyz,
+                   range<attribute, xyz_0>(),
+                   &_emf->field<attribute, xyz_0>(),
+                   &dualField<attribute, xyz_0>(),
+                   &psi<attribute, xyz_0>(),
+                   &cPsi<attribute, xyz_0>(),
+                   &coeffA<attribute>(),
+                   &coeffB<attribute>(),
+                   pmlGlobalStart<attribute>(),
+                   pmlNodeStart<attribute>(),
+                   _offset_c};
   }
-}
+};
 
 template <Axis::XYZ xyz>
-inline auto PMLCorrector<xyz>::correctH() -> void {
-  constexpr auto attribute = EMF::Attribute::H;
-  constexpr auto dual_attribute = EMF::dualAttribute(attribute);
-  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
-  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
-  const auto pml_global_start = _pml_global_h_start;
-  const auto pml_node_start = _pml_node_h_start;
-  const auto task = this->task();
-  if (!task.valid()) {
+inline auto PMLCorrector<xyz>::correctE() -> void {
+  if (!task().valid()) {
     return;
   }
 
-  const auto is = task.xRange().start();
-  const auto js = task.yRange().start();
-  const auto ks = task.zRange().start();
-
-  const auto offset_c = _offset_c;
-
-  {
-    auto&& field = _emf->field<attribute, xyz_a>();
-    auto&& psi = this->psi<attribute, xyz_a>();
-    const auto& coeff_a = coeffA<attribute>();
-    const auto& coeff_b = coeffB<attribute>();
-    const auto& dual_field = _emf->field<dual_attribute, xyz_b>();
-    const auto& c_psi = cPsi<attribute, xyz_a>();
-    // correct HA: [a_s, a_e + 1), [b_s, b_e), [c_s, c_e)
-    // auto [a, b, c] = transform::xYZToABC<Index, xyz>(
-    //     task().xRange().end(), task().yRange().end(), task().zRange().end());
-    // auto [ie, je, ke] = transform::aBCToXYZ<Index, xyz>(a + 1, b, c);
-    auto [a, b, c] = transform::xYZToABC<Index, xyz>(nodeTask().xRange().end(),
-                                                     nodeTask().yRange().end(),
-                                                     nodeTask().zRange().end());
-    auto [ae, be, ce] = transform::xYZToABC<Index, xyz>(
-        task.xRange().end(), task.yRange().end(), task.zRange().end());
-
-    Index ie = 0;
-    Index je = 0;
-    Index ke = 0;
-    if (ae == a) {
-      auto [i, j, k] = transform::aBCToXYZ<Index, xyz>(ae + 1, be, ce);
-      ie = i;
-      je = j;
-      ke = k;
-    } else {
-      auto [i, j, k] = transform::aBCToXYZ<Index, xyz>(ae, be, ce);
-      ie = i;
-      je = j;
-      ke = k;
-    }
+  correct<EMF::Attribute::E, Axis::tangentialAAxis<xyz>()>();
+  correct<EMF::Attribute::E, Axis::tangentialBAxis<xyz>()>();
+}
 
-    correctPML<attribute, xyz>(field, psi, coeff_a, coeff_b, dual_field, c_psi,
-                               is, ie, js, je, ks, ke, pml_global_start,
-                               pml_node_start, offset_c);
+template <Axis::XYZ xyz>
+inline auto PMLCorrector<xyz>::correctH() -> void {
+  if (!task().valid()) {
+    return;
   }
 
-  {
-    auto&& field = _emf->field<attribute, xyz_b>();
-    auto&& psi = this->psi<attribute, xyz_b>();
-    const auto& coeff_a = coeffA<attribute>();
-    const auto& coeff_b = coeffB<attribute>();
-    const auto& dual_field = _emf->field<dual_attribute, xyz_a>();
-    const auto& c_psi = cPsi<attribute, xyz_b>();
-    // correct HB: [a_s, a_e), [b_s, b_e + 1), [c_s, c_e)
-    // auto [a, b, c] = transform::xYZToABC<Index, xyz>(
-    //     task().xRange().end(), task().yRange().end(), task().zRange().end());
-    // auto [ie, je, ke] = transform::aBCToXYZ<Index, xyz>(a, b + 1, c);
-    auto [a, b, c] = transform::xYZToABC<Index, xyz>(nodeTask().xRange().end(),
-                                                     nodeTask().yRange().end(),
-                                                     nodeTask().zRange().end());
-    auto [ae, be, ce] = transform::xYZToABC<Index, xyz>(
-        task.xRange().end(), task.yRange().end(), task.zRange().end());
+  correct<EMF::Attribute::H, Axis::tangentialAAxis<xyz>()>();
+  correct<EMF::Attribute::H, Axis::tangentialBAxis<xyz>()>();
+}
 
-    Index ie = 0;
-    Index je = 0;
-    Index ke = 0;
-    if (be == b) {
-      auto [i, j, k] = transform::aBCToXYZ<Index, xyz>(ae, be + 1, ce);
-      ie = i;
-      je = j;
-      ke = k;
-    } else {
-      auto [i, j, k] = transform::aBCToXYZ<Index, xyz>(ae, be, ce);
-      ie = i;
-      je = j;
-      ke = k;
-    }
+template <Axis::XYZ xyz>
+inline auto PMLCorrector<xyz>::terms(EMF::Attribute attribute)
+    -> std::vector<PMLTerm> {
+  if (!task().valid()) {
+    return {};
+  }
 
-    correctPML<attribute, xyz>(field, psi, coeff_a, coeff_b, dual_field, c_psi,
-                               is, ie, js, je, ks, ke, pml_global_start,
-                               pml_node_start, offset_c);
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+  if (attribute == EMF::Attribute::E) {
+    return {term<EMF::Attribute::E, xyz_a>(), term<EMF::Attribute::E, xyz_b>()};
   }
+  return {term<EMF::Attribute::H, xyz_a>(), term<EMF::Attribute::H, xyz_b>()};
 }
 
 }  // namespace xfdtd
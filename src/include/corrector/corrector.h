@@ -1,7 +1,12 @@
 #ifndef _XFDTD_CORE_CORRECTOR_H_
 #define _XFDTD_CORE_CORRECTOR_H_
 
+#include <xfdtd/common/index_task.h>
+
+#include <optional>
 #include <string>
+#include <vector>
+
 namespace xfdtd {
 
 class Corrector {
@@ -13,6 +18,25 @@ class Corrector {
   virtual void correctH() = 0;
 
   virtual std::string toString() const { return "Corrector"; }
+
+  /**
+   * @brief The node boxes of cells that correctH() reads or writes. An empty
+   * vector means correctH() does nothing. std::nullopt means the corrector
+   * can't tell, so the whole node has to be assumed.
+   */
+  virtual auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> {
+    return std::nullopt;
+  }
+
+  /**
+   * @brief The node boxes of cells that correctE() reads or writes, in the
+   * same terms as correctHRegion().
+   */
+  virtual auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> {
+    return std::nullopt;
+  }
 };
 
 }  // namespace xfdtd
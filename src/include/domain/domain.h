@@ -5,15 +5,21 @@
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/nffft/nffft.h>
 #include <xfdtd/simulation/simulation_flag.h>
+#include <xfdtd/simulation/simulation_profile.h>
 #include <xfdtd/waveform_source/waveform_source.h>
 
+#include <atomic>
 #include <barrier>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "corrector/corrector.h"
+#include "parallel/halo_exchange.h"
 #include "updator/updator.h"
 
 namespace xfdtd {
@@ -111,9 +117,66 @@ class Domain {
 
   auto addVisitor(std::shared_ptr<SimulationFlagVisitor> visitor) -> void;
 
+  /**
+   * @brief Time the phases of every step, and every corrector, monitor and
+   * NF2FF inside them. Without visitors nothing is timed.
+   */
+  auto setProfileVisitors(
+      std::vector<std::shared_ptr<SimulationProfileVisitor>> visitors) -> void;
+
+  /**
+   * @brief Every `interval` steps, stop all threads after the step and let
+   * the master call `capture`. An interval of 0 turns it off.
+   */
+  auto setCheckpoint(Index interval, std::function<void()> capture) -> void;
+
+  /**
+   * @brief Flag shared by the domains of a run. A domain that throws sets it
+   * and leaves the barrier; the others see it at their next barrier, leave
+   * too and return, so the exception reaches the caller of run().
+   */
+  auto setAbort(std::atomic<bool>* abort) -> void { _abort = abort; }
+
+  /**
+   * @brief The node boxes in which H is changed between updateH() and
+   * updateE(): the correctH() region of all correctors and the H halo
+   * exchanged with other nodes. std::nullopt if any corrector doesn't know.
+   */
+  auto correctHRegion() const -> std::optional<std::vector<IndexTask>>;
+
+  /**
+   * @brief The correctE() region of all correctors. std::nullopt if any
+   * corrector doesn't know.
+   */
+  auto correctERegion() const -> std::optional<std::vector<IndexTask>>;
+
+  /**
+   * @brief Overlap the H halo exchange with the E update of the nodes that
+   * don't read the halo. The exchange is posted without blocking, the rest of
+   * E waits for it.
+   */
+  auto setHaloOverlap(bool overlap) -> void { _halo_overlap = overlap; }
+
+  auto haloOverlap() const { return _halo_overlap; }
+
+  /**
+   * @brief Let this domain exchange its own strips of the H halo instead of
+   * leaving the whole exchange to the master. Set it on every domain of the
+   * node or on none.
+   */
+  auto setHaloExchange(std::unique_ptr<HaloExchange> halo_exchange) -> void {
+    _halo_exchange = std::move(halo_exchange);
+  }
+
  protected:
   void exchangeH();
 
+  auto beginExchangeH() -> void;
+
+  auto endExchangeH() -> void;
+
+  auto updateEOverlapped() -> void;
+
  private:
   std::size_t _id;
   IndexTask _task;
@@ -126,13 +189,63 @@ class Domain {
   std::vector<std::shared_ptr<Monitor>> _monitors;
   std::vector<std::shared_ptr<NFFFT>> _nfffts;
   std::vector<std::shared_ptr<SimulationFlagVisitor>> _simulation_flag_visitors;
+  std::vector<std::shared_ptr<SimulationProfileVisitor>> _profile_visitors;
+  std::vector<std::string> _corrector_names, _monitor_names, _nffft_names;
+  int _rank{0};
+  Index _checkpoint_interval{0};
+  std::function<void()> _checkpoint_capture;
   std::barrier<>& _barrier;
+  std::atomic<bool>* _abort{nullptr};
   bool _master = false;
+  bool _halo_overlap = false;
+  std::unique_ptr<HaloExchange> _halo_exchange;
+
+  auto recordTask() const -> IndexTask;
+
+  auto runSteps() -> void;
+
+  auto checkpointDue() const -> bool;
+
+  auto postExchangeH() -> void;
+
+  auto correctorName(std::size_t i) const -> std::string_view {
+    return i < _corrector_names.size() ? _corrector_names[i] : "";
+  }
+
+  auto monitorName(std::size_t i) const -> std::string_view {
+    return i < _monitor_names.size() ? _monitor_names[i] : "";
+  }
+
+  auto nffftName(std::size_t i) const -> std::string_view {
+    return i < _nffft_names.size() ? _nffft_names[i] : "";
+  }
+
+  /**
+   * @brief The node box of E that doesn't read H received from other nodes.
+   */
+  auto haloInterior() const -> IndexTask;
 
   auto sendInitFlag(SimulationInitFlag flag) -> void;
 
   auto sendIteratorFlag(SimulationIteratorFlag flag, Index cur, Index start,
                         Index end) -> void;
+
+  template <typename F>
+  auto profile(ProfilePhase phase, std::string_view name, F&& f) -> void {
+    if (_profile_visitors.empty()) {
+      f();
+      return;
+    }
+
+    const auto start = ProfileEvent::Clock::now();
+    f();
+    const auto end = ProfileEvent::Clock::now();
+    const auto step = _calculation_param->timeParam()->currentTimeStep();
+    const auto event = ProfileEvent{phase, name, _rank, _id, step, start, end};
+    for (auto&& v : _profile_visitors) {
+      v->profileEvent(event);
+    }
+  }
 };
 
 }  // namespace xfdtd
@@ -0,0 +1,55 @@
+#ifndef _XFDTD_CORE_SUBGRID_CORRECTOR_H_
+#define _XFDTD_CORE_SUBGRID_CORRECTOR_H_
+
+#include <xfdtd/grid_space/subgrid.h>
+
+#include <memory>
+#include <utility>
+
+#include "corrector/corrector.h"
+
+namespace xfdtd {
+
+/**
+ * @brief Runs a subgrid after the coarse E update. The subgrid reads and
+ * writes coarse E around and inside its box, so it runs on the master domain
+ * only.
+ */
+class SubgridCorrector : public Corrector {
+ public:
+  explicit SubgridCorrector(std::shared_ptr<Subgrid> subgrid)
+      : _subgrid{std::move(subgrid)} {}
+
+  ~SubgridCorrector() override = default;
+
+  auto correctE() -> void override { _subgrid->correctE(); }
+
+  auto correctH() -> void override {}
+
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{};
+  }
+
+  // The coarse E of the box and of the interpolation stencil around it
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    const auto& box = _subgrid->box();
+    auto prev = [](Index v) { return v == 0 ? Index{0} : v - 1; };
+    return std::vector<IndexTask>{makeIndexTask(
+        makeIndexRange(prev(box.origin().i()), box.end().i() + 2),
+        makeIndexRange(prev(box.origin().j()), box.end().j() + 2),
+        makeIndexRange(prev(box.origin().k()), box.end().k() + 2))};
+  }
+
+  auto toString() const -> std::string override {
+    return _subgrid->toString();
+  }
+
+ private:
+  std::shared_ptr<Subgrid> _subgrid;
+};
+
+}  // namespace xfdtd
+
+#endif  // _XFDTD_CORE_SUBGRID_CORRECTOR_H_
@@ -0,0 +1,69 @@
+#ifndef __XFDTD_CORE_ASYNC_OUTPUT_WRITER_H__
+#define __XFDTD_CORE_ASYNC_OUTPUT_WRITER_H__
+
+#include <xfdtd/common/type_define.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xfdtd {
+
+/**
+ * @brief Writes npy files on a background thread. submit() copies the data
+ * into one of `queue_depth` pooled buffers and returns; when all buffers are
+ * queued it waits for the oldest file to be written. An error of the
+ * background thread is rethrown by the next submit() or flush().
+ */
+class AsyncOutputWriter {
+ public:
+  explicit AsyncOutputWriter(std::size_t queue_depth);
+
+  AsyncOutputWriter(const AsyncOutputWriter&) = delete;
+
+  AsyncOutputWriter& operator=(const AsyncOutputWriter&) = delete;
+
+  /**
+   * @brief Writes the queued files before returning.
+   */
+  ~AsyncOutputWriter();
+
+  auto queueDepth() const { return _queue_depth; }
+
+  auto submit(std::string path, const Array<Real>& data) -> void;
+
+  /**
+   * @brief Wait until every submitted file is written.
+   */
+  auto flush() -> void;
+
+ private:
+  struct Job {
+    std::string _path;
+    Array<Real> _data;
+  };
+
+  std::size_t _queue_depth;
+  std::mutex _mutex;
+  std::condition_variable _job_cv;
+  std::condition_variable _free_cv;
+  std::vector<Array<Real>> _pool;
+  std::deque<Job> _jobs;
+  std::exception_ptr _exception;
+  bool _stop{false};
+  std::thread _thread;
+
+  auto work() -> void;
+
+  // Called with _mutex held
+  auto rethrow() -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_ASYNC_OUTPUT_WRITER_H__
@@ -0,0 +1,75 @@
+#ifndef __XFDTD_CORE_FAR_FIELD_ENGINE_H__
+#define __XFDTD_CORE_FAR_FIELD_ENGINE_H__
+
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/coordinate_system/coordinate_system.h>
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "nffft/nffft_fd_data.h"
+
+namespace xfdtd {
+
+/**
+ * @brief Evaluates the radiation integral of the surface currents of a rank on
+ * any (theta, phi) grid, for all frequencies at once.
+ *
+ * The surface is flattened once into a list of points with their position
+ * and, per frequency, the Cartesian J and M times the cell area. For the unit
+ * vectors u of a set of directions the integral is then the complex matrix
+ * product
+ *
+ *   N(direction, component) = sum_p exp(j k r_p . u) C(p, component),
+ *
+ * with six components (Jx, Jy, Jz, Mx, My, Mz), projected onto theta and phi
+ * at the end. It is computed in tiles of ANGLE_TILE directions by POINT_TILE
+ * points: the phase tile is computed once and used for the six components,
+ * the current tile is used for all directions of the tile. The (frequency,
+ * direction tile) pairs are shared by the threads.
+ */
+class FarFieldEngine {
+ public:
+  static constexpr std::size_t ANGLE_TILE = 8;
+  static constexpr std::size_t POINT_TILE = 256;
+  static constexpr std::size_t NUM_POTENTIAL = 4;
+
+  FarFieldEngine(const std::vector<FDPlaneData>& fd_plane_data,
+                 const Vector& origin);
+
+  auto numPoint() const { return _x.size(); }
+
+  auto numFrequency() const { return _wave_number.size(); }
+
+  /**
+   * @brief The potentials of this rank on the grid theta x phi. The result is
+   * laid out as (frequency, potential, theta, phi), the potentials in the
+   * order a_theta, f_phi, a_phi, f_theta as in processFarField.
+   *
+   * @param num_thread 0 uses all hardware threads.
+   */
+  auto evaluate(const Array1D<Real>& theta, const Array1D<Real>& phi,
+                std::size_t num_thread = 0) const
+      -> std::vector<std::complex<Real>>;
+
+ private:
+  std::vector<AccReal> _x, _y, _z;
+  std::vector<AccReal> _wave_number;
+  // per frequency, component-major: _current_re[f][c * numPoint() + p]
+  std::vector<std::vector<AccReal>> _current_re, _current_im;
+
+  template <Axis::Direction direction>
+  auto gatherFace(const std::vector<FDPlaneData>& fd_plane_data,
+                  const Vector& origin) -> void;
+
+  auto evaluateTile(std::size_t freq, std::size_t angle_start,
+                    std::size_t angle_end, const std::vector<AccReal>& ux,
+                    const std::vector<AccReal>& uy,
+                    const std::vector<AccReal>& uz,
+                    std::complex<AccReal>* potential) const -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_FAR_FIELD_ENGINE_H__
@@ -8,12 +8,30 @@
 #include <xfdtd/nffft/nffft.h>
 #include <xfdtd/util/transform.h>
 
+#include <array>
+#include <complex>
+#include <limits>
+#include <vector>
+
 namespace xfdtd {
 
+/**
+ * @brief Tangential fields on the Huygens surface at one step, interpolated
+ * once and shared by all frequencies. Faces are indexed by Axis::Direction,
+ * cells of a face are stored in (i, j, k) order over `_range`.
+ */
+struct FDSurfaceSample {
+  std::array<IndexTask, 6> _range;
+  std::array<std::vector<Real>, 6> _ja, _jb, _ma, _mb;
+};
+
 class FDPlaneData {
  public:
   enum class Potential { A, F };
 
+  // DFT of a tangential field over the surface, summed every time step.
+  using SurfaceCurrent = Array3D<std::complex<AccReal>>;
+
  public:
   FDPlaneData(std::shared_ptr<const GridSpace> grid_space,
               std::shared_ptr<const EMF> emf, Real freq,
@@ -23,7 +41,39 @@ class FDPlaneData {
 
   auto frequency() const -> Real;
 
-  auto update(std::size_t current_time_step) -> void;
+  /**
+   * @brief Interpolate the surface cells inside `range`. It only depends on
+   * the surface, so any frequency can sample for all of them.
+   */
+  auto sample(const IndexTask& range, FDSurfaceSample& sample) const -> void;
+
+  /**
+   * @brief Add `sample` to the surface currents of this frequency with the
+   * kernel of the current DFT step. Every cell owns its own entry, so samples
+   * of disjoint ranges can be added concurrently.
+   */
+  auto accumulate(const FDSurfaceSample& sample) -> void;
+
+  /**
+   * @brief Move the DFT kernel to `time_step`. The next step is reached by a
+   * rotation, anything else (and every DFT_RESYNC_INTERVAL steps, to stop the
+   * rounding drift) is computed directly.
+   */
+  auto seekDFT(std::size_t time_step) -> void;
+
+  /**
+   * @brief The surface currents and the DFT kernel. The kernel is saved as
+   * is, since recomputing it would not match the rotated one bit for bit.
+   */
+  auto saveState(Checkpoint& checkpoint, const std::string& prefix) const
+      -> void;
+
+  auto loadState(const Checkpoint& checkpoint, const std::string& prefix)
+      -> void;
+
+  auto transformE() const -> Array1D<std::complex<AccReal>>;
+
+  auto transformH() const -> Array1D<std::complex<AccReal>>;
 
   auto aTheta(const Array1D<Real>& theta, const Array1D<Real>& phi,
               const Vector& origin) const -> Array1D<std::complex<Real>>;
@@ -52,7 +102,7 @@ class FDPlaneData {
       -> Array1D<std::complex<Real>>;
 
   template <Axis::Direction direction>
-  auto calculatePower() const -> std::complex<Real>;
+  auto calculatePower() const -> std::complex<AccReal>;
 
   template <Axis::XYZ xyz>
   auto rVector(size_t i, std::size_t j, std::size_t k) const -> Vector;
@@ -65,21 +115,29 @@ class FDPlaneData {
   std::shared_ptr<const EMF> _emf;
   Real _freq;
   IndexTask _task_xn, _task_xp, _task_yn, _task_yp, _task_zn, _task_zp;
-  Array3D<std::complex<Real>> _jx_yn, _jx_yp, _jx_zn, _jx_zp;
-  Array3D<std::complex<Real>> _jy_xn, _jy_xp, _jy_zn, _jy_zp;
-  Array3D<std::complex<Real>> _jz_xn, _jz_xp, _jz_yn, _jz_yp;
-  Array3D<std::complex<Real>> _mx_yn, _mx_yp, _mx_zn, _mx_zp;
-  Array3D<std::complex<Real>> _my_xn, _my_xp, _my_zn, _my_zp;
-  Array3D<std::complex<Real>> _mz_xn, _mz_xp, _mz_yn, _mz_yp;
+  SurfaceCurrent _jx_yn, _jx_yp, _jx_zn, _jx_zp;
+  SurfaceCurrent _jy_xn, _jy_xp, _jy_zn, _jy_zp;
+  SurfaceCurrent _jz_xn, _jz_xp, _jz_yn, _jz_yp;
+  SurfaceCurrent _mx_yn, _mx_yp, _mx_zn, _mx_zp;
+  SurfaceCurrent _my_xn, _my_xp, _my_zn, _my_zp;
+  SurfaceCurrent _mz_xn, _mz_xp, _mz_yn, _mz_yp;
+
+  static constexpr std::size_t DFT_RESYNC_INTERVAL = 1024;
+
+  Real _dt{};
+  std::size_t _total_time_step{};
+  std::size_t _dft_step{std::numeric_limits<std::size_t>::max()};
+  std::complex<AccReal> _dft_rotation;
+  std::complex<AccReal> _dft_e, _dft_h;
 
-  Array1D<std::complex<Real>> _transform_e;
-  Array1D<std::complex<Real>> _transform_h;
+  auto dftKernel(AccReal t) const -> std::complex<AccReal>;
 
   template <Axis::Direction direction>
-  auto calculateJ(std::size_t current_time_step) -> void;
+  auto sampleFace(const IndexTask& range,
+                  FDSurfaceSample& sample) const -> void;
 
   template <Axis::Direction direction>
-  auto calculateM(std::size_t current_time_step) -> void;
+  auto accumulateFace(const FDSurfaceSample& sample) -> void;
 
   template <Axis::Direction direction>
   auto task() const -> const IndexTask&;
@@ -102,27 +160,27 @@ class FDPlaneData {
 
   template <Potential potential, Axis::Direction direction>
   auto surfaceCurrent()
-      -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&>;
+      -> std::tuple<SurfaceCurrent&, SurfaceCurrent&>;
 
   template <Axis::Direction direction>
   auto surfaceJ()
-      -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&>;
+      -> std::tuple<SurfaceCurrent&, SurfaceCurrent&>;
 
   template <Axis::Direction direction>
   auto surfaceM()
-      -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&>;
+      -> std::tuple<SurfaceCurrent&, SurfaceCurrent&>;
 
   template <Potential potential, Axis::Direction direction>
-  auto surfaceCurrent() const -> std::tuple<const Array3D<std::complex<Real>>&,
-                                            const Array3D<std::complex<Real>>&>;
+  auto surfaceCurrent() const
+      -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&>;
 
   template <Axis::Direction direction>
-  auto surfaceJ() const -> std::tuple<const Array3D<std::complex<Real>>&,
-                                      const Array3D<std::complex<Real>>&>;
+  auto surfaceJ() const
+      -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&>;
 
   template <Axis::Direction direction>
-  auto surfaceM() const -> std::tuple<const Array3D<std::complex<Real>>&,
-                                      const Array3D<std::complex<Real>>&>;
+  auto surfaceM() const
+      -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&>;
 };
 
 template <Axis::Direction direction>
@@ -146,7 +204,7 @@ inline auto FDPlaneData::task() const -> const IndexTask& {
 
 template <FDPlaneData::Potential potential, Axis::Direction direction>
 inline auto FDPlaneData::surfaceCurrent()
-    -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&> {
+    -> std::tuple<SurfaceCurrent&, SurfaceCurrent&> {
   if constexpr (potential == Potential::A) {
     return surfaceJ<direction>();
   } else if constexpr (potential == Potential::F) {
@@ -158,7 +216,7 @@ inline auto FDPlaneData::surfaceCurrent()
 
 template <Axis::Direction direction>
 inline auto FDPlaneData::surfaceJ()
-    -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&> {
+    -> std::tuple<SurfaceCurrent&, SurfaceCurrent&> {
   if constexpr (direction == Axis::Direction::XN) {
     return std::make_tuple(std::ref(_jy_xn), std::ref(_jz_xn));
   } else if constexpr (direction == Axis::Direction::XP) {
@@ -178,7 +236,7 @@ inline auto FDPlaneData::surfaceJ()
 
 template <Axis::Direction direction>
 inline auto FDPlaneData::surfaceM()
-    -> std::tuple<Array3D<std::complex<Real>>&, Array3D<std::complex<Real>>&> {
+    -> std::tuple<SurfaceCurrent&, SurfaceCurrent&> {
   if constexpr (direction == Axis::Direction::XN) {
     return std::make_tuple(std::ref(_my_xn), std::ref(_mz_xn));
   } else if constexpr (direction == Axis::Direction::XP) {
@@ -198,8 +256,7 @@ inline auto FDPlaneData::surfaceM()
 
 template <FDPlaneData::Potential potential, Axis::Direction direction>
 inline auto FDPlaneData::surfaceCurrent() const
-    -> std::tuple<const Array3D<std::complex<Real>>&,
-                  const Array3D<std::complex<Real>>&> {
+    -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&> {
   if constexpr (potential == Potential::A) {
     return surfaceJ<direction>();
   } else if constexpr (potential == Potential::F) {
@@ -211,8 +268,7 @@ inline auto FDPlaneData::surfaceCurrent() const
 
 template <Axis::Direction direction>
 inline auto FDPlaneData::surfaceJ() const
-    -> std::tuple<const Array3D<std::complex<Real>>&,
-                  const Array3D<std::complex<Real>>&> {
+    -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&> {
   if constexpr (direction == Axis::Direction::XN) {
     return std::make_tuple(std::ref(_jy_xn), std::ref(_jz_xn));
   } else if constexpr (direction == Axis::Direction::XP) {
@@ -232,8 +288,7 @@ inline auto FDPlaneData::surfaceJ() const
 
 template <Axis::Direction direction>
 inline auto FDPlaneData::surfaceM() const
-    -> std::tuple<const Array3D<std::complex<Real>>&,
-                  const Array3D<std::complex<Real>>&> {
+    -> std::tuple<const SurfaceCurrent&, const SurfaceCurrent&> {
   if constexpr (direction == Axis::Direction::XN) {
     return std::make_tuple(std::ref(_my_xn), std::ref(_mz_xn));
   } else if constexpr (direction == Axis::Direction::XP) {
@@ -7,11 +7,14 @@
 #include <xfdtd/common/type_define.h>
 #include <xfdtd/electromagnetic_field/electromagnetic_field.h>
 #include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 #include <xtensor.hpp>
 
 #include "nffft/interpolate_scheme.h"
@@ -60,40 +63,88 @@ class TDPlaneData {
 
   auto task() const -> IndexTask;
 
-  auto initForUpdate(Index num_e, Index num_h, Range<Real> distance_range_e,
-                     Range<Real> distance_range_h, Vector r_unit) -> void;
+  /**
+   * @brief Set the observation directions. Direction d gets the potentials
+   * [d * num_e, (d + 1) * num_e) of E and [d * num_h, (d + 1) * num_h) of H,
+   * its retarded time is counted from the end of its distance range.
+   */
+  auto initForUpdate(Index num_e, Index num_h,
+                     const std::vector<Range<Real>>& distance_range_e,
+                     const std::vector<Range<Real>>& distance_range_h,
+                     const std::vector<Vector>& r_unit) -> void;
+
+  auto numDirection() const { return _ux.size(); }
 
   template <EMF::Attribute attribute>
   auto update() -> void;
 
-  auto wa() const -> Array1D<Real>;
+  /**
+   * @brief Give every shard its own copy of the potentials. The retarded
+   * time of a cell is fixed, so a shard only touches a short window of them
+   * per step.
+   */
+  auto initShards(std::size_t num_shards) -> void;
+
+  /**
+   * @brief Accumulate the cells inside `range` into the potentials of
+   * `shard`.
+   */
+  template <EMF::Attribute attribute>
+  auto update(std::size_t shard, const IndexTask& range) -> void;
 
-  auto wb() const -> Array1D<Real>;
+  /**
+   * @brief Add the window touched by every shard to the potentials in shard
+   * order and clear it.
+   */
+  auto reduceShards() -> void;
 
-  auto ua() const -> Array1D<Real>;
+  /**
+   * @brief The shards are empty between steps, so only the previous fields
+   * and the potentials are state.
+   */
+  auto saveState(Checkpoint& checkpoint, const std::string& prefix) const
+      -> void;
 
-  auto ub() const -> Array1D<Real>;
+  auto loadState(const Checkpoint& checkpoint, const std::string& prefix)
+      -> void;
 
-  template <EMF::Attribute attribute>
-  auto potential() const
-      -> std::tuple<const Array1D<Real>&, const Array1D<Real>&>;
+  auto wa(Index direction) const -> Array1D<Real>;
+
+  auto wb(Index direction) const -> Array1D<Real>;
+
+  auto ua(Index direction) const -> Array1D<Real>;
+
+  auto ub(Index direction) const -> Array1D<Real>;
 
   template <EMF::Attribute attribute>
-  auto potential() -> std::tuple<Array1D<Real>&, Array1D<Real>&>;
+  auto potential() const
+      -> std::tuple<const Array1D<AccReal>&, const Array1D<AccReal>&>;
 
   template <EMF::Attribute attribute>
-  auto distanceRange() const -> Range<Real>;
+  auto potential() -> std::tuple<Array1D<AccReal>&, Array1D<AccReal>&>;
 
   std::shared_ptr<const GridSpace> _grid_space;
   std::shared_ptr<const CalculationParam> _calculation_param;
   std::shared_ptr<const EMF> _emf;
   IndexTask _task;
-  Vector _r_unit;
+  // the observation directions and the distance their retarded time is
+  // counted from
+  std::vector<Real> _ux, _uy, _uz;
+  std::vector<Real> _delay_origin_e, _delay_origin_h;
+  Index _num_e{0}, _num_h{0};
   Array2D<Real> _ea_prev, _eb_prev, _ha_prev, _hb_prev;
-  Range<Real> _distance_range_e, _distance_range_h;
-  Array1D<Real> _wa, _wb, _ua, _ub;
+  // direction-major, see initForUpdate()
+  Array1D<AccReal> _wa, _wb, _ua, _ub;
 
  private:
+  // the window of every direction, relative to its own potentials
+  struct Shard {
+    Array1D<AccReal> _wa, _wb, _ua, _ub;
+    std::vector<Range<Index>> _window_e, _window_h;
+  };
+
+  std::vector<Shard> _shards;
+
   auto gridSpacePtr() const -> const GridSpace*;
 
   auto calculationParamPtr() const -> const CalculationParam*;
@@ -101,7 +152,9 @@ class TDPlaneData {
   auto emfPrt() const -> const EMF*;
 
   template <EMF::Attribute attribute>
-  auto timeDelay(const Vector& location) const -> Real;
+  auto accumulate(const IndexTask& range, Array1D<AccReal>& potential_a,
+                  Array1D<AccReal>& potential_b,
+                  std::vector<Range<Index>>& window) -> void;
 
   template <EMF::Attribute attribute>
   auto previousAValue(Index i, Index j, Index k) const -> Real;
@@ -155,135 +208,178 @@ TDPlaneData<D>::TDPlaneData(
 }
 
 template <Axis::Direction D>
-auto TDPlaneData<D>::initForUpdate(Index num_e, Index num_h,
-                                   Range<Real> distance_range_e,
-                                   Range<Real> distance_range_h,
-                                   Vector r_unit) -> void {
-  _ua = xt::zeros<Real>({num_e});
-  _ub = xt::zeros<Real>({num_e});
-  _wa = xt::zeros<Real>({num_h});
-  _wb = xt::zeros<Real>({num_h});
-  _distance_range_e = distance_range_e;
-  _distance_range_h = distance_range_h;
-  _r_unit = std::move(r_unit);
+auto TDPlaneData<D>::initForUpdate(
+    Index num_e, Index num_h, const std::vector<Range<Real>>& distance_range_e,
+    const std::vector<Range<Real>>& distance_range_h,
+    const std::vector<Vector>& r_unit) -> void {
+  const auto num_direction = r_unit.size();
+  _ux.clear();
+  _uy.clear();
+  _uz.clear();
+  _delay_origin_e.clear();
+  _delay_origin_h.clear();
+  for (std::size_t d{0}; d < num_direction; ++d) {
+    _ux.emplace_back(r_unit[d].x());
+    _uy.emplace_back(r_unit[d].y());
+    _uz.emplace_back(r_unit[d].z());
+    _delay_origin_e.emplace_back(distance_range_e[d].end());
+    _delay_origin_h.emplace_back(distance_range_h[d].end());
+  }
+
+  _num_e = num_e;
+  _num_h = num_h;
+  _ua = xt::zeros<AccReal>({num_direction * num_e});
+  _ub = xt::zeros<AccReal>({num_direction * num_e});
+  _wa = xt::zeros<AccReal>({num_direction * num_h});
+  _wb = xt::zeros<AccReal>({num_direction * num_h});
 }
 
 template <Axis::Direction D>
 template <EMF::Attribute attribute>
 auto TDPlaneData<D>::update() -> void {
-  constexpr auto xyz = Axis::fromDirectionToXYZ<D>();
-  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
-  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+  if (!task().valid()) {
+    return;
+  }
 
-  constexpr auto filed_a =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_a));
-  constexpr auto filed_b =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_b));
+  auto [potential_a, potential_b] = potential<attribute>();
+  auto window = std::vector<Range<Index>>{};
+  accumulate<attribute>(task(), potential_a, potential_b, window);
+}
 
-  constexpr Real offset = (attribute == EMF::Attribute::E) ? 0.5 : 0.0;
-  Real coeff_a = (attribute == EMF::Attribute::E) ? 1.0 : -1.0;
-  if (Axis::directionNegative<D>()) {
-    coeff_a *= -1.0;
+template <Axis::Direction D>
+auto TDPlaneData<D>::initShards(std::size_t num_shards) -> void {
+  _shards.clear();
+  if (!task().valid()) {
+    return;
   }
 
-  Real coeff_b = (attribute == EMF::Attribute::E) ? -1.0 : 1.0;
-  if (Axis::directionNegative<D>()) {
-    coeff_b *= -1.0;
+  _shards.resize(num_shards);
+  for (auto&& s : _shards) {
+    s._ua = xt::zeros_like(_ua);
+    s._ub = xt::zeros_like(_ub);
+    s._wa = xt::zeros_like(_wa);
+    s._wb = xt::zeros_like(_wb);
+    s._window_e.assign(numDirection(), {});
+    s._window_h.assign(numDirection(), {});
   }
+}
 
-  auto task = this->task();
-  if (!task.valid()) {
+template <Axis::Direction D>
+template <EMF::Attribute attribute>
+auto TDPlaneData<D>::update(std::size_t shard, const IndexTask& range) -> void {
+  if (!task().valid()) {
     return;
   }
 
-  const EMF* emf = emfPrt();
-  auto grid_space = gridSpacePtr();
-  auto calculation_param = calculationParamPtr();
-
-  auto current_time_step = calculation_param->timeParam()->currentTimeStep();
-
-  const auto& field_a_value = emf->field<filed_a>();
-  const auto& field_b_value = emf->field<filed_b>();
-
-  auto [potential_a, potential_b] = potential<attribute>();
-
-  const auto dt = calculation_param->timeParam()->dt();
-
-  auto is = task.xRange().start();
-  auto js = task.yRange().start();
-  auto ks = task.zRange().start();
-  auto ie = task.xRange().end();
-  auto je = task.yRange().end();
-  auto ke = task.zRange().end();
-
-  for (auto i{is}; i < ie; ++i) {
-    for (auto j{js}; j < je; ++j) {
-      for (auto k{ks}; k < ke; ++k) {
-        auto r_center = rVector<xyz, attribute>(i, j, k, grid_space);
-        auto time_delay = timeDelay<attribute>(r_center);
-        auto time_step_delay = time_delay / (constant::C_0 * dt);
-        auto nn = static_cast<Index>(
-            std::floor(time_step_delay + offset + current_time_step));
-        auto coeff_f = time_step_delay + offset + current_time_step - nn;
-
-        auto ds = surfaceArea<xyz, attribute>(i, j, k, grid_space);
-
-        const auto a_avg = interpolate::interpolateSurfaceCenter<xyz, filed_a>(
-            field_a_value, i, j, k);
-        const auto b_avg = interpolate::interpolateSurfaceCenter<xyz, filed_b>(
-            field_b_value, i, j, k);
+  auto sub = taskIntersection(task(), range);
+  if (!sub.has_value()) {
+    return;
+  }
 
-        auto delta_a =
-            (a_avg - previousAValue<attribute>(i - is, j - js, k - ks));
-        auto delta_b =
-            (b_avg - previousBValue<attribute>(i - is, j - js, k - ks));
+  auto& s = _shards[shard];
+  if constexpr (attribute == EMF::Attribute::E) {
+    accumulate<attribute>(*sub, s._ua, s._ub, s._window_e);
+  } else {
+    accumulate<attribute>(*sub, s._wa, s._wb, s._window_h);
+  }
+}
 
-        potential_a.at(nn) += coeff_a * (1 - coeff_f) * ds * delta_b;
-        potential_a.at(nn + 1) += coeff_a * coeff_f * ds * delta_b;
+template <Axis::Direction D>
+auto TDPlaneData<D>::reduceShards() -> void {
+  auto add = [](Array1D<AccReal>& dst, Array1D<AccReal>& src, Index offset,
+                const Range<Index>& window) {
+    for (auto n{offset + window.start()}; n < offset + window.end(); ++n) {
+      dst(n) += src(n);
+      src(n) = 0;
+    }
+  };
 
-        potential_b.at(nn) += coeff_b * (1 - coeff_f) * ds * delta_a;
-        potential_b.at(nn + 1) += coeff_b * coeff_f * ds * delta_a;
+  for (auto&& s : _shards) {
+    for (std::size_t d{0}; d < s._window_e.size(); ++d) {
+      add(_ua, s._ua, d * _num_e, s._window_e[d]);
+      add(_ub, s._ub, d * _num_e, s._window_e[d]);
+      s._window_e[d] = {};
+    }
 
-        setPreviousAValue<attribute>(i - is, j - js, k - ks, a_avg);
-        setPreviousBValue<attribute>(i - is, j - js, k - ks, b_avg);
-      }
+    for (std::size_t d{0}; d < s._window_h.size(); ++d) {
+      add(_wa, s._wa, d * _num_h, s._window_h[d]);
+      add(_wb, s._wb, d * _num_h, s._window_h[d]);
+      s._window_h[d] = {};
     }
   }
 }
 
+template <Axis::Direction D>
+auto TDPlaneData<D>::saveState(Checkpoint& checkpoint,
+                               const std::string& prefix) const -> void {
+  checkpoint.save(prefix + "ea_prev", _ea_prev);
+  checkpoint.save(prefix + "eb_prev", _eb_prev);
+  checkpoint.save(prefix + "ha_prev", _ha_prev);
+  checkpoint.save(prefix + "hb_prev", _hb_prev);
+  checkpoint.save(prefix + "wa", _wa);
+  checkpoint.save(prefix + "wb", _wb);
+  checkpoint.save(prefix + "ua", _ua);
+  checkpoint.save(prefix + "ub", _ub);
+}
+
+template <Axis::Direction D>
+auto TDPlaneData<D>::loadState(const Checkpoint& checkpoint,
+                               const std::string& prefix) -> void {
+  checkpoint.load(prefix + "ea_prev", _ea_prev);
+  checkpoint.load(prefix + "eb_prev", _eb_prev);
+  checkpoint.load(prefix + "ha_prev", _ha_prev);
+  checkpoint.load(prefix + "hb_prev", _hb_prev);
+  checkpoint.load(prefix + "wa", _wa);
+  checkpoint.load(prefix + "wb", _wb);
+  checkpoint.load(prefix + "ua", _ua);
+  checkpoint.load(prefix + "ub", _ub);
+}
+
 template <Axis::Direction D>
 auto TDPlaneData<D>::task() const -> IndexTask {
   return _task;
 }
 
 template <Axis::Direction D>
-auto TDPlaneData<D>::wa() const -> Array1D<Real> {
-  return _wa / (constant::C_0 * calculationParamPtr()->timeParam()->dt() * 4 *
-                constant::PI);
+auto TDPlaneData<D>::wa(Index direction) const -> Array1D<Real> {
+  auto&& p = xt::view(_wa, xt::range(direction * _num_h,
+                                    (direction + 1) * _num_h));
+  return xt::cast<Real>(p / (constant::C_0 *
+                             calculationParamPtr()->timeParam()->dt() * 4 *
+                             constant::PI));
 }
 
 template <Axis::Direction D>
-auto TDPlaneData<D>::wb() const -> Array1D<Real> {
-  return _wb / (constant::C_0 * calculationParamPtr()->timeParam()->dt() * 4 *
-                constant::PI);
+auto TDPlaneData<D>::wb(Index direction) const -> Array1D<Real> {
+  auto&& p = xt::view(_wb, xt::range(direction * _num_h,
+                                    (direction + 1) * _num_h));
+  return xt::cast<Real>(p / (constant::C_0 *
+                             calculationParamPtr()->timeParam()->dt() * 4 *
+                             constant::PI));
 }
 
 template <Axis::Direction D>
-auto TDPlaneData<D>::ua() const -> Array1D<Real> {
-  return _ua / (constant::C_0 * calculationParamPtr()->timeParam()->dt() * 4 *
-                constant::PI);
+auto TDPlaneData<D>::ua(Index direction) const -> Array1D<Real> {
+  auto&& p = xt::view(_ua, xt::range(direction * _num_e,
+                                    (direction + 1) * _num_e));
+  return xt::cast<Real>(p / (constant::C_0 *
+                             calculationParamPtr()->timeParam()->dt() * 4 *
+                             constant::PI));
 }
 
 template <Axis::Direction D>
-auto TDPlaneData<D>::ub() const -> Array1D<Real> {
-  return _ub / (constant::C_0 * calculationParamPtr()->timeParam()->dt() * 4 *
-                constant::PI);
+auto TDPlaneData<D>::ub(Index direction) const -> Array1D<Real> {
+  auto&& p = xt::view(_ub, xt::range(direction * _num_e,
+                                    (direction + 1) * _num_e));
+  return xt::cast<Real>(p / (constant::C_0 *
+                             calculationParamPtr()->timeParam()->dt() * 4 *
+                             constant::PI));
 }
 
 template <Axis::Direction D>
 template <EMF::Attribute attribute>
 auto TDPlaneData<D>::potential() const
-    -> std::tuple<const Array1D<Real>&, const Array1D<Real>&> {
+    -> std::tuple<const Array1D<AccReal>&, const Array1D<AccReal>&> {
   if constexpr (attribute == EMF::Attribute::E) {
     return {_ua, _ub};
   }
@@ -295,7 +391,8 @@ auto TDPlaneData<D>::potential() const
 
 template <Axis::Direction D>
 template <EMF::Attribute attribute>
-auto TDPlaneData<D>::potential() -> std::tuple<Array1D<Real>&, Array1D<Real>&> {
+auto TDPlaneData<D>::potential()
+    -> std::tuple<Array1D<AccReal>&, Array1D<AccReal>&> {
   if constexpr (attribute == EMF::Attribute::E) {
     return {_ua, _ub};
   }
@@ -322,57 +419,118 @@ auto TDPlaneData<D>::emfPrt() const -> const EMF* {
 
 template <Axis::Direction D>
 template <EMF::Attribute attribute>
-auto TDPlaneData<D>::timeDelay(const Vector& location) const -> Real {
-  const auto& r_unit = _r_unit;
-  if constexpr (attribute == EMF::Attribute::E) {
-    return (_distance_range_e.end() -
-            (location.x() * r_unit.x() + location.y() * r_unit.y() +
-             location.z() * r_unit.z()));
+auto TDPlaneData<D>::accumulate(const IndexTask& range,
+                                Array1D<AccReal>& potential_a,
+                                Array1D<AccReal>& potential_b,
+                                std::vector<Range<Index>>& window) -> void {
+  constexpr auto xyz = Axis::fromDirectionToXYZ<D>();
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+
+  constexpr auto filed_a =
+      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_a));
+  constexpr auto filed_b =
+      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_b));
+
+  constexpr Real offset = (attribute == EMF::Attribute::E) ? 0.5 : 0.0;
+  Real coeff_a = (attribute == EMF::Attribute::E) ? 1.0 : -1.0;
+  if (Axis::directionNegative<D>()) {
+    coeff_a *= -1.0;
   }
 
-  if constexpr (attribute == EMF::Attribute::H) {
-    return (_distance_range_h.end() -
-            (location.x() * r_unit.x() + location.y() * r_unit.y() +
-             location.z() * r_unit.z()));
+  Real coeff_b = (attribute == EMF::Attribute::E) ? -1.0 : 1.0;
+  if (Axis::directionNegative<D>()) {
+    coeff_b *= -1.0;
   }
-}
 
-template <Axis::Direction D>
-template <EMF::Attribute attribute>
-auto TDPlaneData<D>::distanceRange() const -> Range<Real> {
-  auto min_dis = std::numeric_limits<Real>::max();
-  auto max_dis = std::numeric_limits<Real>::lowest();
+  const auto task = this->task();
+  const EMF* emf = emfPrt();
+  auto grid_space = gridSpacePtr();
+  auto calculation_param = calculationParamPtr();
 
-  if (task().valid()) {
-    return {min_dis, max_dis};
-  }
+  auto current_time_step = calculation_param->timeParam()->currentTimeStep();
 
-  const auto& r_unit = _r_unit;
+  const auto& field_a_value = emf->field<filed_a>();
+  const auto& field_b_value = emf->field<filed_b>();
 
-  auto is = task().xRange().start();
-  auto js = task().yRange().start();
-  auto ks = task().zRange().start();
-  auto ie = task().xRange().end();
-  auto je = task().yRange().end();
-  auto ke = task().zRange().end();
+  const auto dt = calculation_param->timeParam()->dt();
 
-  auto grid_space = gridSpacePtr();
+  const auto is = task.xRange().start();
+  const auto js = task.yRange().start();
+  const auto ks = task.zRange().start();
+
+  const auto num_direction = numDirection();
+  const auto stride = (attribute == EMF::Attribute::E) ? _num_e : _num_h;
+  const auto* delay_origin = (attribute == EMF::Attribute::E)
+                                 ? _delay_origin_e.data()
+                                 : _delay_origin_h.data();
+  const auto* ux = _ux.data();
+  const auto* uy = _uy.data();
+  const auto* uz = _uz.data();
+
+  // per direction: the first retarded step of the cell and its weight
+  auto nn = std::vector<Index>(num_direction);
+  auto coeff_f = std::vector<Real>(num_direction);
+  auto n_min =
+      std::vector<Index>(num_direction, std::numeric_limits<Index>::max());
+  auto n_max = std::vector<Index>(num_direction, 0);
+
+  for (auto i{range.xRange().start()}; i < range.xRange().end(); ++i) {
+    for (auto j{range.yRange().start()}; j < range.yRange().end(); ++j) {
+      for (auto k{range.zRange().start()}; k < range.zRange().end(); ++k) {
+        auto r_center = rVector<xyz, attribute>(i, j, k, grid_space);
+        for (std::size_t d{0}; d < num_direction; ++d) {
+          auto time_delay =
+              delay_origin[d] - (r_center.x() * ux[d] + r_center.y() * uy[d] +
+                                 r_center.z() * uz[d]);
+          auto time_step_delay = time_delay / (constant::C_0 * dt);
+          auto n = static_cast<Index>(
+              std::floor(time_step_delay + offset + current_time_step));
+          coeff_f[d] = time_step_delay + offset + current_time_step - n;
+          nn[d] = n;
+          n_min[d] = std::min(n_min[d], n);
+          n_max[d] = std::max(n_max[d], n + 2);
+        }
 
-  constexpr auto xyz = Axis::fromDirectionToXYZ<D>();
+        auto ds = surfaceArea<xyz, attribute>(i, j, k, grid_space);
+
+        const auto a_avg = interpolate::interpolateSurfaceCenter<xyz, filed_a>(
+            field_a_value, i, j, k);
+        const auto b_avg = interpolate::interpolateSurfaceCenter<xyz, filed_b>(
+            field_b_value, i, j, k);
 
-  for (auto i{is}; i < ie; ++i) {
-    for (auto j{js}; j < je; ++j) {
-      for (auto k{ks}; k < ke; ++k) {
-        auto r = rVector<xyz, attribute>(i, j, k, grid_space);
-        auto distance =
-            r.x() * r_unit.x() + r.y() * r_unit.y() + r.z() * r_unit.z();
-        max_dis = std::max(max_dis, distance);
-        min_dis = std::min(min_dis, distance);
+        auto delta_a =
+            (a_avg - previousAValue<attribute>(i - is, j - js, k - ks));
+        auto delta_b =
+            (b_avg - previousBValue<attribute>(i - is, j - js, k - ks));
+
+        // The surface is interpolated once, every direction only adds its
+        // own retarded time
+        for (std::size_t d{0}; d < num_direction; ++d) {
+          if (stride <= nn[d] + 1) {
+            throw TDPlaneDataException(
+                "TDPlaneData: retarded time out of the potential range");
+          }
+
+          auto* pa = potential_a.data() + d * stride + nn[d];
+          auto* pb = potential_b.data() + d * stride + nn[d];
+          pa[0] += coeff_a * (1 - coeff_f[d]) * ds * delta_b;
+          pa[1] += coeff_a * coeff_f[d] * ds * delta_b;
+          pb[0] += coeff_b * (1 - coeff_f[d]) * ds * delta_a;
+          pb[1] += coeff_b * coeff_f[d] * ds * delta_a;
+        }
+
+        setPreviousAValue<attribute>(i - is, j - js, k - ks, a_avg);
+        setPreviousBValue<attribute>(i - is, j - js, k - ks, b_avg);
       }
     }
   }
 
-  return {min_dis, max_dis};
+  window.resize(num_direction);
+  for (std::size_t d{0}; d < num_direction; ++d) {
+    window[d] = n_min[d] < n_max[d] ? Range<Index>{n_min[d], n_max[d]}
+                                    : Range<Index>{};
+  }
 }
 
 template <Axis::Direction D>
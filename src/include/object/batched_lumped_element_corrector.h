@@ -0,0 +1,106 @@
+#ifndef _XFDTD_CORE_BATCHED_LUMPED_ELEMENT_CORRECTOR_H_
+#define _XFDTD_CORE_BATCHED_LUMPED_ELEMENT_CORRECTOR_H_
+
+#include <xfdtd/calculation_param/calculation_param.h>
+#include <xfdtd/common/index_task.h>
+#include <xfdtd/common/type_define.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "corrector/corrector.h"
+#include "object/lumped_element_corrector.h"
+
+namespace xfdtd {
+
+/**
+ * @brief Corrects the cells of many lumped elements in two flat loops per
+ * step, one for the sources and one for the inductors.
+ *
+ * The cells are gathered once, as lists of field offsets, coefficients and
+ * waveform indices, so a step costs one multiply-add per cell instead of two
+ * views, an expression and a virtual call per element. The value of each
+ * distinct waveform is read once per step. The sources are applied before
+ * the inductors; elements that share a node are corrected in that order.
+ */
+class BatchedLumpedElementCorrector : public Corrector {
+ public:
+  explicit BatchedLumpedElementCorrector(
+      std::shared_ptr<CalculationParam> calculation_param);
+
+  ~BatchedLumpedElementCorrector() override = default;
+
+  auto add(LumpedElementCorrector& corrector) -> void {
+    corrector.batch(*this);
+  }
+
+  /**
+   * @brief Add the cells of a voltage or current source:
+   * e += coeff * waveform(t).
+   */
+  auto addSource(const IndexTask& task, const IndexTask& local_task,
+                 Array3D<Real>& e_field, const Array3D<Real>& coeff,
+                 const Array1D<Real>& waveform) -> void;
+
+  /**
+   * @brief Add the cells of an inductor: e += cecjc * j, then
+   * j += cjcec * e.
+   */
+  auto addInductor(const IndexTask& task, const IndexTask& local_task,
+                   Array3D<Real>& e_field, Array3D<Real>& j,
+                   const Array3D<Real>& cecjc, const Array3D<Real>& cjcec)
+      -> void;
+
+  auto empty() const {
+    return _source_offset.empty() && _inductor_offset.empty();
+  }
+
+  auto correctE() -> void override;
+
+  auto correctH() -> void override {}
+
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{};
+  }
+
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return _regions;
+  }
+
+  auto toString() const -> std::string override;
+
+ private:
+  std::shared_ptr<CalculationParam> _calculation_param;
+
+  std::vector<const Array1D<Real>*> _waveforms;
+  std::vector<Real> _waveform_values;
+
+  // E of a cell is _fields[field][offset]; the arrays are resolved every step
+  std::vector<Array3D<Real>*> _fields;
+  std::vector<Real*> _field_data;
+
+  std::vector<std::uint8_t> _source_field;
+  std::vector<std::size_t> _source_offset;
+  std::vector<Real> _source_coeff;
+  std::vector<std::uint32_t> _source_waveform;
+
+  std::vector<std::uint8_t> _inductor_field;
+  std::vector<std::size_t> _inductor_offset;
+  std::vector<Real*> _inductor_j;
+  std::vector<Real> _inductor_cecjc;
+  std::vector<Real> _inductor_cjcec;
+
+  std::vector<IndexTask> _regions;
+
+  auto waveformIndex(const Array1D<Real>& waveform) -> std::uint32_t;
+
+  auto fieldIndex(Array3D<Real>& field) -> std::uint8_t;
+};
+
+}  // namespace xfdtd
+
+#endif  // _XFDTD_CORE_BATCHED_LUMPED_ELEMENT_CORRECTOR_H_
@@ -12,6 +12,8 @@
 
 namespace xfdtd {
 
+class BatchedLumpedElementCorrector;
+
 class LumpedElementCorrector : public Corrector {
  public:
   LumpedElementCorrector(IndexTask task, IndexTask local_task,
@@ -32,6 +34,23 @@ class LumpedElementCorrector : public Corrector {
     return ss.str();
   }
 
+  // lumped element only corrects E
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{};
+  }
+
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override {
+    return std::vector<IndexTask>{_task};
+  }
+
+  /**
+   * @brief Add the cells of this corrector to `batch`, which then corrects
+   * them instead.
+   */
+  virtual auto batch(BatchedLumpedElementCorrector& batch) -> void = 0;
+
  protected:
   IndexTask _task, _local_task;
   std::shared_ptr<CalculationParam> _calculation_param;
@@ -55,6 +74,8 @@ class VoltageSourceCorrector : public LumpedElementCorrector {
 
   void correctH() override;
 
+  auto batch(BatchedLumpedElementCorrector& batch) -> void override;
+
   std::string toString() const override {
     std::stringstream ss;
     ss << "VoltageSourceCorrector: ";
@@ -84,6 +105,8 @@ class CurrentSourceCorrector : public LumpedElementCorrector {
 
   void correctH() override;
 
+  auto batch(BatchedLumpedElementCorrector& batch) -> void override;
+
   std::string toString() const override {
     std::stringstream ss;
     ss << "CurrentSourceCorrector: ";
@@ -113,6 +136,8 @@ class InductorCorrector : public LumpedElementCorrector {
 
   void correctH() override;
 
+  auto batch(BatchedLumpedElementCorrector& batch) -> void override;
+
   std::string toString() const override {
     std::stringstream ss;
     ss << "InductorCorrector: ";
@@ -0,0 +1,56 @@
+#ifndef _XFDTD_CORE_VOXELIZER_H_
+#define _XFDTD_CORE_VOXELIZER_H_
+
+#include <xfdtd/common/index_task.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/object/object.h>
+#include <xfdtd/shape/shape.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace xfdtd {
+
+/**
+ * @brief Finds the cells whose center is inside a shape, the same cells as
+ * Shape::isInside(center, grid_space->eps()). Only the cells of the wrapped
+ * cube are visited. A column (i, j) is filled from Shape::spanZ() when the
+ * shape has it, so isInside() is only called at the ends of the span.
+ */
+class Voxelizer {
+ public:
+  Voxelizer(const GridSpace* grid_space, const Shape* shape);
+
+  auto xRange() const { return _x_range; }
+
+  /**
+   * @brief Append the rows of the plane i to `rows`, in order of j and k.
+   */
+  auto voxelizePlane(Index i, std::vector<VoxelRow>& rows) const -> void;
+
+  auto voxelize() const -> std::vector<VoxelRow>;
+
+ private:
+  const GridSpace* _grid_space;
+  const Shape* _shape;
+  Real _eps;
+  IndexRange _x_range;
+  IndexRange _y_range;
+  IndexRange _z_range;
+
+  auto inside(Index i, Index j, Index k) const -> bool;
+};
+
+/**
+ * @brief Voxelize all `shapes` at once. The x planes of every shape are shared
+ * by `num_thread` threads, so many small shapes keep them as busy as one large
+ * shape. The rows of shapes[n] are returned in the n-th vector.
+ */
+auto voxelize(const GridSpace* grid_space,
+              const std::vector<const Shape*>& shapes,
+              std::size_t num_thread) -> std::vector<std::vector<VoxelRow>>;
+
+}  // namespace xfdtd
+
+#endif  // _XFDTD_CORE_VOXELIZER_H_
@@ -0,0 +1,89 @@
+#ifndef __XFDTD_CORE_HALO_EXCHANGE_H__
+#define __XFDTD_CORE_HALO_EXCHANGE_H__
+
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/electromagnetic_field/electromagnetic_field.h>
+#include <xfdtd/grid_space/grid_space.h>
+#include <xfdtd/parallel/mpi_support.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#if defined(XFDTD_CORE_WITH_MPI)
+#include <mpi.h>
+#endif
+
+namespace xfdtd {
+
+/**
+ * @brief The part of the H halo exchange done by one thread of a node.
+ *
+ * Every node face shared with another node is cut into strips along its first
+ * tangential axis, one strip per thread (fewer if the face is narrower). The
+ * cut depends on the face size and the number of threads only, so both nodes
+ * of a face cut it the same way. Each strip has its own datatypes and tags,
+ * and each HaloExchange keeps its own requests, so the threads of a node post
+ * and wait at the same time. Needs MPI_THREAD_MULTIPLE.
+ */
+class HaloExchange {
+ public:
+  HaloExchange(std::size_t piece, std::size_t num_pieces,
+               const GridSpace& grid_space, std::shared_ptr<EMF> emf);
+
+  HaloExchange(const HaloExchange&) = delete;
+
+  HaloExchange& operator=(const HaloExchange&) = delete;
+
+  ~HaloExchange();
+
+  /**
+   * @brief Post the sends and receives of this thread's strips.
+   */
+  auto post() -> void;
+
+  /**
+   * @brief Wait for the requests posted by post().
+   */
+  auto wait() -> void;
+
+  auto empty() const { return _faces.empty(); }
+
+ private:
+  struct Face {
+    EMF::Component _component;
+    int _peer;
+    int _send_tag;
+    int _recv_tag;
+    MpiSupport::Block _send;
+    MpiSupport::Block _recv;
+  };
+
+  std::size_t _piece;
+  std::size_t _num_pieces;
+  std::shared_ptr<EMF> _emf;
+  std::vector<Face> _faces;
+
+#if defined(XFDTD_CORE_WITH_MPI)
+  std::vector<MPI_Request> _requests;
+#endif
+
+  auto field(EMF::Component c) -> Array3D<Real>&;
+
+  /**
+   * @brief Add the strip of this thread on the face normal to `axis`.
+   *
+   * @param shape the shape of the field array.
+   * @param send_plane the plane sent to `peer`.
+   * @param recv_plane the plane received from `peer`.
+   */
+  auto addFace(EMF::Component component, Axis::XYZ axis,
+               const std::array<std::size_t, 3>& shape, std::size_t send_plane,
+               std::size_t recv_plane, int peer, int send_tag,
+               int recv_tag) -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_HALO_EXCHANGE_H__
@@ -8,7 +8,8 @@
 namespace xfdtd::mpi_type {
 #if defined(XFDTD_CORE_WITH_MPI)
 
-#if defined(XFDTD_CORE_SINGLE_PRECISION)
+#if defined(XFDTD_CORE_SINGLE_PRECISION) || \
+    defined(XFDTD_CORE_MIXED_PRECISION)
 static const auto XFDTD_MPI_REAL_TYPE = MPI_FLOAT;
 static const auto XFDTD_MPI_COMPLEX_TYPE = MPI_COMPLEX;
 #else
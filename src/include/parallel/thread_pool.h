@@ -0,0 +1,98 @@
+#ifndef __XFDTD_CORE_THREAD_POOL_H__
+#define __XFDTD_CORE_THREAD_POOL_H__
+
+#include <xfdtd/common/index_task.h>
+#include <xfdtd/common/type_define.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace xfdtd {
+
+/**
+ * @brief Persistent workers, one per domain. Worker `id` is created once,
+ * pinned to `cpu_of(id)` and then runs every job submitted by run() with its
+ * own id. All workers run a job at the same time, so jobs may synchronize with
+ * a barrier.
+ */
+class ThreadPool {
+ public:
+  ThreadPool(std::size_t size, const std::function<int(std::size_t)>& cpu_of);
+
+  ThreadPool(const ThreadPool&) = delete;
+
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool();
+
+  auto size() const { return _workers.size(); }
+
+  /**
+   * @brief Call job(id) on every worker and wait for all of them. The first
+   * exception thrown by a job is rethrown here. A job that waits on a barrier
+   * must leave it when it throws, or the other jobs never return.
+   */
+  auto run(const std::function<void(std::size_t)>& job) -> void;
+
+ private:
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _job_cv;
+  std::condition_variable _done_cv;
+  const std::function<void(std::size_t)>* _job{nullptr};
+  std::size_t _generation{0};
+  std::size_t _pending{0};
+  std::exception_ptr _exception;
+  bool _stop{false};
+
+  auto work(std::size_t id, int cpu) -> void;
+};
+
+/**
+ * @brief Pin the calling thread to `cpu`. Does nothing if `cpu` is negative or
+ * the platform has no affinity API.
+ */
+auto pinCurrentThread(int cpu) -> void;
+
+/**
+ * @brief Copy the part of `src` owned by `task` into `dst`. The task is given
+ * in cells of a grid of size (nx, ny, nz); a task that ends at the grid end
+ * also owns the extra node planes of the array. Used to first touch `dst`
+ * from the thread that updates `task`.
+ */
+template <typename T>
+inline auto copyTaskSlab(Array3D<T>& dst, const Array3D<T>& src,
+                         const IndexTask& task, Index nx, Index ny,
+                         Index nz) -> void {
+  const auto& shape = src.shape();
+  auto range = [](const IndexRange& r, Index n, std::size_t dim) {
+    const auto start = std::min<std::size_t>(r.start(), dim);
+    const auto end = r.end() == n ? dim : std::min<std::size_t>(r.end(), dim);
+    return std::pair<std::size_t, std::size_t>{start, end};
+  };
+
+  const auto [is, ie] = range(task.xRange(), nx, shape[0]);
+  const auto [js, je] = range(task.yRange(), ny, shape[1]);
+  const auto [ks, ke] = range(task.zRange(), nz, shape[2]);
+  if (ke <= ks) {
+    return;
+  }
+
+  for (auto i = is; i < ie; ++i) {
+    for (auto j = js; j < je; ++j) {
+      const auto* s = &src(i, j, ks);
+      std::copy(s, s + (ke - ks), &dst(i, j, ks));
+    }
+  }
+}
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_THREAD_POOL_H__
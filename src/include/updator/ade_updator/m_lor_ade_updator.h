@@ -15,17 +15,18 @@ class MLorentzUpdator : public BasicUpdator3D {
       std::shared_ptr<EMF> emf, IndexTask task,
       std::shared_ptr<MLorentzADEMethodStorage> m_lor_ade_method_storage);
 
-  auto updateE() -> void override;
-
   auto& storage() const { return _m_lor_ade_method_storage; }
 
   auto& storage() { return _m_lor_ade_method_storage; }
 
+ protected:
+  auto updateERegion(const IndexTask& task) -> void override;
+
  private:
   std::shared_ptr<MLorentzADEMethodStorage> _m_lor_ade_method_storage{};
 
   template <Axis::XYZ xyz>
-  auto updateE() -> void;
+  auto updateE(const IndexTask& task) -> void;
 
   template <Axis::XYZ xyz>
   auto updateJ(Index i, Index j, Index k, const Real e_next,
@@ -0,0 +1,53 @@
+#ifndef __XFDTD_CORE_SPARSE_ADE_UPDATOR_H__
+#define __XFDTD_CORE_SPARSE_ADE_UPDATOR_H__
+
+#include <xfdtd/material/ade_method/ade_method.h>
+
+#include <array>
+#include <vector>
+
+#include "updator/basic_updator.h"
+
+namespace xfdtd {
+
+/**
+ * @brief 3D update for an ADE storage in sparse mode.
+ *
+ * The whole task runs the plain Yee update. The dispersive cells already have
+ * their corrected E coefficients, so only the E^{n-1} and J terms are left;
+ * they are added to the cells listed in the storage that fall in the task.
+ */
+class SparseADEUpdator3D : public BasicUpdator3D {
+ public:
+  SparseADEUpdator3D(std::shared_ptr<const GridSpace> grid_space,
+                     std::shared_ptr<const CalculationParam> calculation_param,
+                     std::shared_ptr<EMF> emf, IndexTask task,
+                     std::shared_ptr<ADEMethodStorage> ade_method_storage);
+
+  ~SparseADEUpdator3D() override = default;
+
+  std::string toString() const override;
+
+  auto& storage() const { return _storage; }
+
+ protected:
+  auto updateERegion(const IndexTask& task) -> void override;
+
+ private:
+  std::shared_ptr<ADEMethodStorage> _storage;
+  // positions in the storage lists of the cells owned by this task
+  std::array<std::vector<std::size_t>, 3> _cells;
+
+  template <Axis::XYZ xyz>
+  auto gatherCells() -> void;
+
+  template <Axis::XYZ xyz>
+  auto beforeYee(const IndexTask& task) -> void;
+
+  template <Axis::XYZ xyz>
+  auto afterYee(const IndexTask& task) -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_SPARSE_ADE_UPDATOR_H__
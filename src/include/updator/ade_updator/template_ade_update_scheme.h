@@ -23,13 +23,6 @@ class TemplateADEUpdateScheme {
     constexpr auto xzy_a = Axis::tangentialAAxis<xyz>();  // !
     constexpr auto xzy_b = Axis::tangentialBAxis<xyz>();
 
-    const auto& cfcf = update_coefficient->template coeff<attribute, xyz>();
-    const auto& cf_a =
-        update_coefficient
-            ->template coeff<attribute, xyz, dual_attribute, xzy_a>();
-    const auto& cf_b =
-        update_coefficient
-            ->template coeff<attribute, xyz, dual_attribute, xzy_b>();
 
     auto&& field = emf->template field<attribute, xyz>();
     const auto& field_a = emf->template field<dual_attribute, xzy_a>();
@@ -72,12 +65,15 @@ class TemplateADEUpdateScheme {
           const auto e_prev = ade_updator->template ePrevious<xyz>(i, j, k);
           const auto coeff_e_e_p = ade_updator->coeffEPrev(i, j, k);
 
+          const auto cf =
+              update_coefficient->template at<attribute, xyz>(i, j, k);
+
           const auto e_cur = field(i, j, k);
           field(i, j, k) =
               coeff_e_e_p * e_prev +
-              eNext(cfcf(i, j, k), field(i, j, k), cf_a(i, j, k),
-                    field_a(i, j, k), field_a(i_a, j_a, k_a), cf_b(i, j, k),
-                    field_b(i, j, k), field_b(i_b, j_b, k_b)) +
+              eNext(cf._c, field(i, j, k), cf._c_a, field_a(i, j, k),
+                    field_a(i_a, j_a, k_a), cf._c_b, field_b(i, j, k),
+                    field_b(i_b, j_b, k_b)) +
               coeff_e_j_sum.at(i, j, k) * j_sum;
           ade_updator->template updateJ<xyz>(i, j, k, field(i, j, k), e_cur);
 
@@ -52,6 +52,16 @@ class BasicUpdator3D : public BasicUpdator {
   std::string toString() const override;
 
   void updateE() override;
+
+  auto updateEInterior(const IndexTask& interior) -> void override;
+
+  auto updateERim(const IndexTask& interior) -> void override;
+
+ protected:
+  /**
+   * @brief Update E of the nodes in `task`, a part of the task of the updator.
+   */
+  virtual auto updateERegion(const IndexTask& task) -> void;
 };
 
 }  // namespace xfdtd
@@ -0,0 +1,86 @@
+#ifndef __XFDTD_CORE_FUSED_SWEEP_UPDATOR_H__
+#define __XFDTD_CORE_FUSED_SWEEP_UPDATOR_H__
+
+#include <xfdtd/common/index_task.h>
+
+#include <array>
+#include <vector>
+
+#include "updator/basic_updator.h"
+
+namespace xfdtd {
+
+/**
+ * @brief One sweep for the H and E updates of a non-dispersive 3D time step.
+ *
+ * updateH() sweeps the task tile by tile (blocks of `tileSize()` rows in y,
+ * wavefront in x). Right after H of slab i in a tile is updated, E of the same
+ * slab is advanced too while the data is still in cache. So a time step
+ * streams the field and coefficient arrays once instead of twice. Tiles never
+ * run ahead by more than this one step.
+ *
+ * E can only run ahead where nothing happens to H between updateH() and
+ * updateE(): cells near a corrector that works in correctH() (PML, TFSF), the
+ * H halo exchanged with other nodes and the first slab of the task (its H
+ * neighbors belong to another thread) are left to updateE().
+ */
+class FusedSweepUpdator3D : public BasicUpdator3D {
+ public:
+  FusedSweepUpdator3D(
+      std::shared_ptr<const GridSpace> grid_space,
+      std::shared_ptr<const CalculationParam> calculation_param,
+      std::shared_ptr<EMF> emf, IndexTask task, Index tile_size);
+
+  ~FusedSweepUpdator3D() override = default;
+
+  std::string toString() const override;
+
+  void updateH() override;
+
+  void updateE() override;
+
+  // Part of E is already new after updateH(), so E is not split around the
+  // halo.
+  auto updateEInterior(const IndexTask& interior) -> void override {}
+
+  auto updateERim(const IndexTask& interior) -> void override { updateE(); }
+
+  auto tileSize() const { return _tile_size; }
+
+  /**
+   * @brief Set the node boxes touched by correctH(). Without it the updator
+   * behaves as BasicUpdator3D.
+   */
+  auto setCorrectedRegion(const std::vector<IndexTask>& region) -> void;
+
+ private:
+  struct Segment {
+    Index _start;
+    Index _end;
+    bool _fused;
+  };
+
+  // segments of every (i, j) row of one E component
+  struct RowSegments {
+    IndexTask _task;
+    std::vector<Index> _row_offset;
+    std::vector<Segment> _segments;
+  };
+
+  Index _tile_size;
+  bool _fused{false};
+  std::array<RowSegments, 3> _rows;
+
+  template <Axis::XYZ xyz>
+  auto eUpdateTask() const -> IndexTask;
+
+  template <Axis::XYZ xyz>
+  auto buildRows(const std::vector<IndexTask>& excluded) -> void;
+
+  template <Axis::XYZ xyz>
+  auto updateERow(Index i, Index j, bool fused) -> void;
+};
+
+}  // namespace xfdtd
+
+#endif  // __XFDTD_CORE_FUSED_SWEEP_UPDATOR_H__
@@ -0,0 +1,268 @@
+#ifndef __XFDTD_CORE_UPDATE_KERNEL_H__
+#define __XFDTD_CORE_UPDATE_KERNEL_H__
+
+#include <xfdtd/calculation_param/fdtd_update_coefficient.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/coordinate_system/coordinate_system.h>
+#include <xfdtd/electromagnetic_field/electromagnetic_field.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace xfdtd::kernel {
+
+/*
+  Raw pointer kernel for the Yee update.
+  The row-major layout of `Array3D` makes `k` (z axis) the contiguous axis, so
+  the kernel walks every (i, j) row with precomputed strides and updates the
+  row in one pass:
+    f = c * f + c_a * (p_a - q_a) + c_b * (p_b - q_b)
+  For E: p is the current node and q is the previous node. For H: p is the next
+  node and q is the current node. The operations are issued in the same order
+  as `eNext` and `hNext`; the compiler may still contract them into FMA (see
+  XFDTD_CORE_NATIVE_ARCH in CMakeLists.txt).
+*/
+
+template <Axis::XYZ xyz>
+inline constexpr auto axisIndex() -> std::size_t {
+  if constexpr (xyz == Axis::XYZ::X) {
+    return 0;
+  } else if constexpr (xyz == Axis::XYZ::Y) {
+    return 1;
+  } else {
+    return 2;
+  }
+}
+
+template <typename T>
+inline auto updateRowScalar(T* __restrict f, const T* __restrict c,
+                            const T* __restrict c_a, const T* __restrict p_a,
+                            const T* __restrict q_a, const T* __restrict c_b,
+                            const T* __restrict p_b, const T* __restrict q_b,
+                            std::ptrdiff_t start, std::ptrdiff_t end) {
+  for (auto k = start; k < end; ++k) {
+    f[k] = c[k] * f[k] + c_a[k] * (p_a[k] - q_a[k]) + c_b[k] * (p_b[k] - q_b[k]);
+  }
+}
+
+template <typename T>
+inline auto updateRow(T* __restrict f, const T* __restrict c,
+                      const T* __restrict c_a, const T* __restrict p_a,
+                      const T* __restrict q_a, const T* __restrict c_b,
+                      const T* __restrict p_b, const T* __restrict q_b,
+                      std::ptrdiff_t n) {
+  std::ptrdiff_t k = 0;
+
+#if defined(__AVX512F__)
+  if constexpr (std::is_same_v<T, double>) {
+    for (; k + 8 <= n; k += 8) {
+      auto v = _mm512_mul_pd(_mm512_loadu_pd(c + k), _mm512_loadu_pd(f + k));
+      v = _mm512_add_pd(
+          v, _mm512_mul_pd(_mm512_loadu_pd(c_a + k),
+                           _mm512_sub_pd(_mm512_loadu_pd(p_a + k),
+                                         _mm512_loadu_pd(q_a + k))));
+      v = _mm512_add_pd(
+          v, _mm512_mul_pd(_mm512_loadu_pd(c_b + k),
+                           _mm512_sub_pd(_mm512_loadu_pd(p_b + k),
+                                         _mm512_loadu_pd(q_b + k))));
+      _mm512_storeu_pd(f + k, v);
+    }
+  } else if constexpr (std::is_same_v<T, float>) {
+    for (; k + 16 <= n; k += 16) {
+      auto v = _mm512_mul_ps(_mm512_loadu_ps(c + k), _mm512_loadu_ps(f + k));
+      v = _mm512_add_ps(
+          v, _mm512_mul_ps(_mm512_loadu_ps(c_a + k),
+                           _mm512_sub_ps(_mm512_loadu_ps(p_a + k),
+                                         _mm512_loadu_ps(q_a + k))));
+      v = _mm512_add_ps(
+          v, _mm512_mul_ps(_mm512_loadu_ps(c_b + k),
+                           _mm512_sub_ps(_mm512_loadu_ps(p_b + k),
+                                         _mm512_loadu_ps(q_b + k))));
+      _mm512_storeu_ps(f + k, v);
+    }
+  }
+#elif defined(__AVX__)
+  if constexpr (std::is_same_v<T, double>) {
+    for (; k + 4 <= n; k += 4) {
+      auto v = _mm256_mul_pd(_mm256_loadu_pd(c + k), _mm256_loadu_pd(f + k));
+      v = _mm256_add_pd(
+          v, _mm256_mul_pd(_mm256_loadu_pd(c_a + k),
+                           _mm256_sub_pd(_mm256_loadu_pd(p_a + k),
+                                         _mm256_loadu_pd(q_a + k))));
+      v = _mm256_add_pd(
+          v, _mm256_mul_pd(_mm256_loadu_pd(c_b + k),
+                           _mm256_sub_pd(_mm256_loadu_pd(p_b + k),
+                                         _mm256_loadu_pd(q_b + k))));
+      _mm256_storeu_pd(f + k, v);
+    }
+  } else if constexpr (std::is_same_v<T, float>) {
+    for (; k + 8 <= n; k += 8) {
+      auto v = _mm256_mul_ps(_mm256_loadu_ps(c + k), _mm256_loadu_ps(f + k));
+      v = _mm256_add_ps(
+          v, _mm256_mul_ps(_mm256_loadu_ps(c_a + k),
+                           _mm256_sub_ps(_mm256_loadu_ps(p_a + k),
+                                         _mm256_loadu_ps(q_a + k))));
+      v = _mm256_add_ps(
+          v, _mm256_mul_ps(_mm256_loadu_ps(c_b + k),
+                           _mm256_sub_ps(_mm256_loadu_ps(p_b + k),
+                                         _mm256_loadu_ps(q_b + k))));
+      _mm256_storeu_ps(f + k, v);
+    }
+  }
+#endif
+
+  // scalar fallback and remainder
+  updateRowScalar(f, c, c_a, p_a, q_a, c_b, p_b, q_b, k, n);
+}
+
+/**
+ * @brief Row update for the compressed coefficient mode: the coefficients are
+ * looked up in the class table of each node.
+ */
+template <typename T, typename I, typename C>
+inline auto updateRowCompressed(T* __restrict f, const I* __restrict index,
+                                const C* __restrict table,
+                                const T* __restrict p_a,
+                                const T* __restrict q_a,
+                                const T* __restrict p_b,
+                                const T* __restrict q_b, std::ptrdiff_t n) {
+  for (std::ptrdiff_t k = 0; k < n; ++k) {
+    const auto& c = table[index[k]];
+    f[k] = c._c * f[k] + c._c_a * (p_a[k] - q_a[k]) + c._c_b * (p_b[k] - q_b[k]);
+  }
+}
+
+/**
+ * @brief Offset of node (i, j, k) in a row-major Array3D.
+ */
+template <typename T>
+inline auto offset(const Array3D<T>& arr, Index i, Index j,
+                   Index k) -> std::ptrdiff_t {
+  const auto& s = arr.strides();
+  return static_cast<std::ptrdiff_t>(i) * s[0] +
+         static_cast<std::ptrdiff_t>(j) * s[1] +
+         static_cast<std::ptrdiff_t>(k) * s[2];
+}
+
+template <EMF::Attribute attribute, Axis::XYZ xyz>
+inline auto updateCompressed(EMF& emf,
+                             const FDTDUpdateCoefficient& update_coefficient,
+                             Index is, Index ie, Index js, Index je, Index ks,
+                             Index ke) -> void {
+  constexpr auto dual_attribute = EMF::dualAttribute(attribute);
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+
+  const auto& index = update_coefficient.classIndex<attribute, xyz>();
+  const auto* table = update_coefficient.classTable<attribute, xyz>().data();
+
+  auto&& field = emf.field<attribute, xyz>();
+  const auto& field_a = emf.field<dual_attribute, xyz_a>();
+  const auto& field_b = emf.field<dual_attribute, xyz_b>();
+
+  const auto shift_a = field_a.strides()[axisIndex<xyz_b>()];
+  const auto shift_b = field_b.strides()[axisIndex<xyz_a>()];
+  const std::ptrdiff_t p_a_shift = attribute == EMF::Attribute::E ? 0 : shift_a;
+  const std::ptrdiff_t q_a_shift =
+      attribute == EMF::Attribute::E ? -shift_a : 0;
+  const std::ptrdiff_t p_b_shift = attribute == EMF::Attribute::E ? 0 : shift_b;
+  const std::ptrdiff_t q_b_shift =
+      attribute == EMF::Attribute::E ? -shift_b : 0;
+
+  auto* f_data = field.data();
+  const auto* index_data = index.data();
+  const auto* f_a_data = field_a.data();
+  const auto* f_b_data = field_b.data();
+
+  const auto n = static_cast<std::ptrdiff_t>(ke - ks);
+  for (Index i = is; i < ie; ++i) {
+    for (Index j = js; j < je; ++j) {
+      const auto o_a = offset(field_a, i, j, ks);
+      const auto o_b = offset(field_b, i, j, ks);
+
+      updateRowCompressed(f_data + offset(field, i, j, ks),
+                          index_data + offset(index, i, j, ks), table,
+                          f_a_data + o_a + p_a_shift,
+                          f_a_data + o_a + q_a_shift,
+                          f_b_data + o_b + p_b_shift,
+                          f_b_data + o_b + q_b_shift, n);
+    }
+  }
+}
+
+/**
+ * @brief Update the field component `attribute` `xyz` in [is, ie) x [js, je) x
+ * [ks, ke). Same contract as `update` in update_scheme.h. Reads the class table
+ * if the coefficients are compressed.
+ */
+template <EMF::Attribute attribute, Axis::XYZ xyz>
+inline auto update(EMF& emf, FDTDUpdateCoefficient& update_coefficient,
+                   Index is, Index ie, Index js, Index je, Index ks,
+                   Index ke) -> void {
+  if (ie <= is || je <= js || ke <= ks) {
+    return;
+  }
+
+  constexpr auto dual_attribute = EMF::dualAttribute(attribute);
+  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
+  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
+
+  if (update_coefficient.compressed()) {
+    updateCompressed<attribute, xyz>(emf, update_coefficient, is, ie, js, je,
+                                     ks, ke);
+    return;
+  }
+
+  const auto& cfcf = update_coefficient.coeff<attribute, xyz>();
+  const auto& cf_a =
+      update_coefficient.coeff<attribute, xyz, dual_attribute, xyz_a>();
+  const auto& cf_b =
+      update_coefficient.coeff<attribute, xyz, dual_attribute, xyz_b>();
+
+  auto&& field = emf.field<attribute, xyz>();
+  const auto& field_a = emf.field<dual_attribute, xyz_a>();
+  const auto& field_b = emf.field<dual_attribute, xyz_b>();
+
+  // field_a is differentiated along b axis, field_b is differentiated along a
+  // axis. E looks backward and H looks forward.
+  const auto shift_a = field_a.strides()[axisIndex<xyz_b>()];
+  const auto shift_b = field_b.strides()[axisIndex<xyz_a>()];
+  const std::ptrdiff_t p_a_shift = attribute == EMF::Attribute::E ? 0 : shift_a;
+  const std::ptrdiff_t q_a_shift =
+      attribute == EMF::Attribute::E ? -shift_a : 0;
+  const std::ptrdiff_t p_b_shift = attribute == EMF::Attribute::E ? 0 : shift_b;
+  const std::ptrdiff_t q_b_shift =
+      attribute == EMF::Attribute::E ? -shift_b : 0;
+
+  auto* f_data = field.data();
+  const auto* c_data = cfcf.data();
+  const auto* c_a_data = cf_a.data();
+  const auto* c_b_data = cf_b.data();
+  const auto* f_a_data = field_a.data();
+  const auto* f_b_data = field_b.data();
+
+  const auto n = static_cast<std::ptrdiff_t>(ke - ks);
+  for (Index i = is; i < ie; ++i) {
+    for (Index j = js; j < je; ++j) {
+      const auto o_f = offset(field, i, j, ks);
+      const auto o_c = offset(cfcf, i, j, ks);
+      const auto o_c_a = offset(cf_a, i, j, ks);
+      const auto o_c_b = offset(cf_b, i, j, ks);
+      const auto o_a = offset(field_a, i, j, ks);
+      const auto o_b = offset(field_b, i, j, ks);
+
+      updateRow(f_data + o_f, c_data + o_c, c_a_data + o_c_a,
+                f_a_data + o_a + p_a_shift, f_a_data + o_a + q_a_shift,
+                c_b_data + o_c_b, f_b_data + o_b + p_b_shift,
+                f_b_data + o_b + q_b_shift, n);
+    }
+  }
+}
+
+}  // namespace xfdtd::kernel
+
+#endif  // __XFDTD_CORE_UPDATE_KERNEL_H__
@@ -36,6 +36,16 @@ class Updator {
 
   virtual void updateH() = 0;
 
+  /**
+   * @brief updateE() in two passes, so that the H halo can be received in
+   * between. updateEInterior() updates E of the task nodes inside `interior`
+   * and updateERim() all the others. By default everything is left to the rim
+   * pass.
+   */
+  virtual auto updateEInterior(const IndexTask& interior) -> void {}
+
+  virtual auto updateERim(const IndexTask& interior) -> void { updateE(); }
+
   auto task() const { return _task; }
 
   virtual std::string toString() const;
@@ -4,6 +4,10 @@
 #include <xfdtd/common/index_task.h>
 #include <xfdtd/exception/exception.h>
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 namespace xfdtd {
 
 template <typename T>
@@ -92,6 +96,126 @@ static auto decomposeTask(const Task<T>& problem, int nx, int ny, int nz,
   return res;
 }
 
+/**
+ * @brief Every cell of `_task` costs `_weight` more than a vacuum cell, in
+ * units of the Yee update of a vacuum cell.
+ */
+template <typename T>
+struct TaskWeight {
+  Task<T> _task;
+  double _weight;
+};
+
+/**
+ * @brief Split `problem` into `num_procs` ranges of about the same cost.
+ * `cost[i]` is the cost of index `problem.start() + i`. Every range gets at
+ * least one index.
+ */
+template <typename T>
+inline auto decomposeRangeByCost(const Range<T>& problem, int num_procs,
+                                 const std::vector<double>& cost)
+    -> std::vector<Range<T>> {
+  if (num_procs <= 0) {
+    throw XFDTDException("Number of processes is less than or equal to zero");
+  }
+
+  const auto size = static_cast<std::size_t>(problem.size());
+  if (!problem.valid() || size < static_cast<std::size_t>(num_procs)) {
+    throw XFDTDException("Problem size is less than number of processes");
+  }
+
+  if (cost.size() != size) {
+    throw XFDTDException("Cost doesn't match the problem size");
+  }
+
+  auto prefix = std::vector<double>(size + 1, 0.0);
+  for (std::size_t i = 0; i < size; ++i) {
+    prefix[i + 1] = prefix[i] + cost[i];
+  }
+
+  std::vector<Range<T>> res;
+  std::size_t start{0};
+  for (int p = 1; p < num_procs; ++p) {
+    const auto target = prefix[size] * p / num_procs;
+    // Leave one index for each of the remaining ranges
+    const auto lo = start + 1;
+    const auto hi = size - static_cast<std::size_t>(num_procs - p);
+    auto end = static_cast<std::size_t>(
+        std::lower_bound(prefix.begin() + lo, prefix.begin() + hi + 1,
+                         target) -
+        prefix.begin());
+    end = std::min(end, hi);
+    if (lo < end && target - prefix[end - 1] < prefix[end] - target) {
+      --end;
+    }
+
+    res.emplace_back(problem.start() + static_cast<T>(start),
+                     problem.start() + static_cast<T>(end));
+    start = end;
+  }
+  res.emplace_back(problem.start() + static_cast<T>(start), problem.end());
+  return res;
+}
+
+/**
+ * @brief Like decomposeTask(), but the ranges of every axis have about the
+ * same cost instead of the same size. A cell costs 1 plus the weights of the
+ * tasks that contain it.
+ */
+template <typename T>
+static auto decomposeTask(const Task<T>& problem, int nx, int ny, int nz,
+                          const std::vector<TaskWeight<T>>& weights)
+    -> std::vector<Task<T>> {
+  if (nx <= 0 || ny <= 0 || nz <= 0) {
+    return std::vector<Task<T>>{problem};
+  }
+
+  const auto sx = static_cast<double>(problem.xRange().size());
+  const auto sy = static_cast<double>(problem.yRange().size());
+  const auto sz = static_cast<double>(problem.zRange().size());
+
+  // Cost of every slab of the problem along each axis
+  auto x_cost = std::vector<double>(problem.xRange().size(), sy * sz);
+  auto y_cost = std::vector<double>(problem.yRange().size(), sx * sz);
+  auto z_cost = std::vector<double>(problem.zRange().size(), sx * sy);
+  for (const auto& w : weights) {
+    auto t = taskIntersection(problem, w._task);
+    if (!t.has_value() || !t->valid()) {
+      continue;
+    }
+
+    const auto x = t->xRange() - problem.xRange().start();
+    const auto y = t->yRange() - problem.yRange().start();
+    const auto z = t->zRange() - problem.zRange().start();
+    const auto wx = static_cast<double>(x.size());
+    const auto wy = static_cast<double>(y.size());
+    const auto wz = static_cast<double>(z.size());
+    for (auto i = x.start(); i < x.end(); ++i) {
+      x_cost[i] += w._weight * wy * wz;
+    }
+    for (auto j = y.start(); j < y.end(); ++j) {
+      y_cost[j] += w._weight * wx * wz;
+    }
+    for (auto k = z.start(); k < z.end(); ++k) {
+      z_cost[k] += w._weight * wx * wy;
+    }
+  }
+
+  auto res = std::vector<Task<T>>{};
+  auto x_ranges = decomposeRangeByCost(problem.xRange(), nx, x_cost);
+  auto y_ranges = decomposeRangeByCost(problem.yRange(), ny, y_cost);
+  auto z_ranges = decomposeRangeByCost(problem.zRange(), nz, z_cost);
+  for (auto i{0}; i < nx; ++i) {
+    for (auto j{0}; j < ny; ++j) {
+      for (auto k{0}; k < nz; ++k) {
+        res.emplace_back(makeTask(x_ranges[i], y_ranges[j], z_ranges[k]));
+      }
+    }
+  }
+
+  return res;
+}
+
 }  // namespace xfdtd
 
 #endif  // __XFDTD_CORE_DECOMPOSE_TASK_H__
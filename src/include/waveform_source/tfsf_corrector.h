@@ -169,7 +169,7 @@ class TFSFCorrector : public WaveformSourceCorrector {
     auto [is, js, ks] = transform::aBCToXYZ<Index, xyz>(as, bs, cs);
     auto [ie, je, ke] = transform::aBCToXYZ<Index, xyz>(ae, be, ce);
 
-    const auto t = calculationParam()->timeParam()->currentTimeStep();
+    const auto t = incidentRow();
 
     auto emf = this->emf();
     for (Index i{is}; i < ie; ++i) {
@@ -330,10 +330,31 @@ class TFSFCorrector : public WaveformSourceCorrector {
 
   std::string toString() const override;
 
+  auto correctHRegion() const
+      -> std::optional<std::vector<IndexTask>> override;
+
+  auto correctERegion() const
+      -> std::optional<std::vector<IndexTask>> override;
+
+  /**
+   * @brief The incident arrays hold only the current step, see
+   * TFSF::setIncidentOnTheFly().
+   */
+  auto setIncidentOnTheFly(bool on_the_fly) -> void {
+    _incident_on_the_fly = on_the_fly;
+  }
+
+  auto incidentRow() const -> Index {
+    return _incident_on_the_fly
+               ? 0
+               : calculationParam()->timeParam()->currentTimeStep();
+  }
+
  protected:
   Index _node_offset_i, _node_offset_j, _node_offset_k;
 
  private:
+  bool _incident_on_the_fly{false};
   bool _xn{false}, _xp{false}, _yn{false}, _yp{false}, _zn{false}, _zp{false};
 
   const Array1D<Real>* _projection_x_int;
@@ -1,7 +1,156 @@
 #include <xfdtd/material/ade_method/ade_method.h>
+#include <xfdtd/simulation/checkpoint.h>
+
+#include <algorithm>
+#include <sstream>
 
 namespace xfdtd {
 
-ADEMethodStorage::ADEMethodStorage(Index num_pole) : _num_pole{num_pole} {}
+ADEMethodStorage::ADEMethodStorage(Index num_pole, bool sparse)
+    : _num_pole{num_pole}, _sparse{sparse} {}
+
+auto ADEMethodStorage::addSparseCell(
+    Index i, Index j, Index k, Index material_index,
+    const LinearDispersiveMaterial& linear_dispersive_material,
+    Real dt) -> void {
+  auto it = std::find(_sparse_material.begin(), _sparse_material.end(),
+                      material_index);
+  const auto row = static_cast<std::size_t>(it - _sparse_material.begin());
+  if (it == _sparse_material.end()) {
+    checkNumPole(linear_dispersive_material);
+    auto coeff = coefficient(linear_dispersive_material, dt);
+    // Missing poles get zero coefficients, so their J stays zero.
+    for (auto* c : {&coeff._coeff_j_e_n, &coeff._coeff_j_e, &coeff._coeff_j_e_p,
+                    &coeff._coeff_j_j, &coeff._coeff_j_j_p,
+                    &coeff._coeff_j_sum_j, &coeff._coeff_j_sum_j_p}) {
+      c->resize(_num_pole, Real{0});
+    }
+
+    _sparse_material.emplace_back(material_index);
+    _sparse_coeff.emplace_back(std::move(coeff));
+  }
+
+  // Same nodes as the E update: the tangential planes at index 0 are skipped.
+  auto add = [this, row, i, j, k](SparseCells& cells) {
+    cells._i.emplace_back(i);
+    cells._j.emplace_back(j);
+    cells._k.emplace_back(k);
+    cells._material.emplace_back(row);
+    cells._e_prev.emplace_back(0);
+    cells._e_cur.emplace_back(0);
+    cells._e_extra.emplace_back(0);
+    cells._j_pole.resize(cells._j_pole.size() + _num_pole, Real{0});
+    cells._j_pole_prev.resize(cells._j_pole_prev.size() + _num_pole, Real{0});
+  };
+
+  if (j != 0 && k != 0) {
+    add(sparseCells<Axis::XYZ::X>());
+  }
+  if (i != 0 && k != 0) {
+    add(sparseCells<Axis::XYZ::Y>());
+  }
+  if (i != 0 && j != 0) {
+    add(sparseCells<Axis::XYZ::Z>());
+  }
+}
+
+auto ADEMethodStorage::saveState(Checkpoint& checkpoint,
+                                 const std::string& prefix) const -> void {
+  if (_sparse) {
+    for (std::size_t n{0}; n < _sparse_cells.size(); ++n) {
+      const auto& cells = _sparse_cells[n];
+      const auto p = prefix + "sparse_" + std::to_string(n) + "/";
+      checkpoint.save(p + "e_prev", cells._e_prev);
+      checkpoint.save(p + "j_pole", cells._j_pole);
+      checkpoint.save(p + "j_pole_prev", cells._j_pole_prev);
+    }
+    return;
+  }
+
+  checkpoint.save(prefix + "ex_prev", _ex_prev);
+  checkpoint.save(prefix + "ey_prev", _ey_prev);
+  checkpoint.save(prefix + "ez_prev", _ez_prev);
+  checkpoint.save(prefix + "jx", _jx_arr);
+  checkpoint.save(prefix + "jy", _jy_arr);
+  checkpoint.save(prefix + "jz", _jz_arr);
+  checkpoint.save(prefix + "jx_prev", _jx_prev_arr);
+  checkpoint.save(prefix + "jy_prev", _jy_prev_arr);
+  checkpoint.save(prefix + "jz_prev", _jz_prev_arr);
+}
+
+auto ADEMethodStorage::loadState(const Checkpoint& checkpoint,
+                                 const std::string& prefix) -> void {
+  if (_sparse) {
+    for (std::size_t n{0}; n < _sparse_cells.size(); ++n) {
+      auto& cells = _sparse_cells[n];
+      const auto p = prefix + "sparse_" + std::to_string(n) + "/";
+      checkpoint.load(p + "e_prev", cells._e_prev);
+      checkpoint.load(p + "j_pole", cells._j_pole);
+      checkpoint.load(p + "j_pole_prev", cells._j_pole_prev);
+    }
+    return;
+  }
+
+  checkpoint.load(prefix + "ex_prev", _ex_prev);
+  checkpoint.load(prefix + "ey_prev", _ey_prev);
+  checkpoint.load(prefix + "ez_prev", _ez_prev);
+  checkpoint.load(prefix + "jx", _jx_arr);
+  checkpoint.load(prefix + "jy", _jy_arr);
+  checkpoint.load(prefix + "jz", _jz_arr);
+  checkpoint.load(prefix + "jx_prev", _jx_prev_arr);
+  checkpoint.load(prefix + "jy_prev", _jy_prev_arr);
+  checkpoint.load(prefix + "jz_prev", _jz_prev_arr);
+}
+
+auto ADEMethodStorage::checkNumPole(
+    const LinearDispersiveMaterial& linear_dispersive_material) const -> void {
+  if (_num_pole < linear_dispersive_material.numPoles()) {
+    std::stringstream ss;
+    ss << "The number of poles is not enough. The number of poles is "
+       << _num_pole << " but the number of poles in the material is "
+       << linear_dispersive_material.numPoles();
+    throw XFDTDLinearDispersiveMaterialException{ss.str()};
+  }
+}
+
+auto ADEMethodStorage::correctEUpdateCoeff(
+    Index i, Index j, Index k, const ADEMaterialCoefficient& coeff,
+    const std::shared_ptr<const GridSpace>& grid_space,
+    const std::shared_ptr<CalculationParam>& calculation_param) -> void {
+  auto correct_func = [&coeff](const auto da, const auto db, auto& cece,
+                               auto& cecha, auto& cechb) {
+    cece = coeff._cece;
+    if (coeff._ceh_den != 0) {
+      cecha = -1 / (coeff._ceh_den * db);
+      cechb = 1 / (coeff._ceh_den * da);
+      return;
+    }
+
+    cecha = -coeff._ceh / db;
+    cechb = coeff._ceh / da;
+  };
+
+  const auto dx = grid_space->hSizeX()(i);
+  const auto dy = grid_space->hSizeY()(j);
+  const auto dz = grid_space->hSizeZ()(k);
+
+  auto& cexe = calculation_param->fdtdCoefficient()->cexe()(i, j, k);
+  auto& cexhy = calculation_param->fdtdCoefficient()->cexhy()(i, j, k);
+  auto& cexhz = calculation_param->fdtdCoefficient()->cexhz()(i, j, k);
+
+  correct_func(dy, dz, cexe, cexhy, cexhz);
+
+  auto& ceye = calculation_param->fdtdCoefficient()->ceye()(i, j, k);
+  auto& ceyhz = calculation_param->fdtdCoefficient()->ceyhz()(i, j, k);
+  auto& ceyhx = calculation_param->fdtdCoefficient()->ceyhx()(i, j, k);
+
+  correct_func(dz, dx, ceye, ceyhz, ceyhx);
+
+  auto& ceze = calculation_param->fdtdCoefficient()->ceze()(i, j, k);
+  auto& cezhx = calculation_param->fdtdCoefficient()->cezhx()(i, j, k);
+  auto& cezhy = calculation_param->fdtdCoefficient()->cezhy()(i, j, k);
+
+  correct_func(dx, dy, ceze, cezhx, cezhy);
+}
 
-}  // namespace xfdtd
\ No newline at end of file
+}  // namespace xfdtd
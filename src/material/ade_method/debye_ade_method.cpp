@@ -30,8 +30,12 @@ class DebyeADEMethodCoefficient {
 };
 
 DebyeADEMethodStorage::DebyeADEMethodStorage(Index num_pole, Index nx, Index ny,
-                                             Index nz)
-    : ADEMethodStorage{num_pole} {
+                                             Index nz, bool sparse)
+    : ADEMethodStorage{num_pole, sparse} {
+  if (sparse) {
+    return;
+  }
+
   _coeff_j_j = xt::zeros<Real>({nx, ny, nz, num_pole});
   _coeff_j_e = xt::zeros<Real>({nx, ny, nz, num_pole});
   _coeff_j_sum_j = xt::zeros<Real>({nx, ny, nz, num_pole});
@@ -49,14 +53,27 @@ auto DebyeADEMethodStorage::correctCoeff(
     const LinearDispersiveMaterial& linear_dispersive_material,
     const std::shared_ptr<const GridSpace>& grid_space,
     const std::shared_ptr<CalculationParam>& calculation_param) -> void {
-  if (_num_pole < linear_dispersive_material.numPoles()) {
-    std::stringstream ss;
-    ss << "The number of poles is not enough. The number of poles is "
-       << _num_pole << " but the number of poles in the material is "
-       << linear_dispersive_material.numPoles();
-    throw XFDTDLinearDispersiveMaterialException{ss.str()};
+  checkNumPole(linear_dispersive_material);
+
+  const auto dt = calculation_param->timeParam()->dt();
+  const auto coeff = coefficient(linear_dispersive_material, dt);
+
+  if (!_sparse) {
+    for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
+      _coeff_j_j(i, j, k, p) = coeff._coeff_j_j[p];
+      _coeff_j_e(i, j, k, p) = coeff._coeff_j_e_n[p];
+      _coeff_j_sum_j(i, j, k, p) = coeff._coeff_j_sum_j[p];
+    }
+
+    _coeff_e_j_sum(i, j, k) = coeff._coeff_e_j_sum;
   }
 
+  correctEUpdateCoeff(i, j, k, coeff, grid_space, calculation_param);
+}
+
+auto DebyeADEMethodStorage::coefficient(
+    const LinearDispersiveMaterial& linear_dispersive_material,
+    Real dt) const -> ADEMaterialCoefficient {
   auto debye_eq = std::dynamic_pointer_cast<DebyeEqDecision>(
       linear_dispersive_material.equation());
   if (!debye_eq) {
@@ -64,8 +81,6 @@ auto DebyeADEMethodStorage::correctCoeff(
         "The equation is not Debye equation"};
   }
 
-  auto dt = calculation_param->timeParam()->dt();
-
   auto delta_epsilon = debye_eq->deltaEpsilon();
   auto tau = debye_eq->tau();
 
@@ -74,10 +89,17 @@ auto DebyeADEMethodStorage::correctCoeff(
   auto sum_beta =
       std::accumulate(coeff_beta.begin(), coeff_beta.end(), Real{0.0});
 
-  for (Index p{0}; p < _num_pole; ++p) {
-    _coeff_j_j(i, j, k, p) = coeff_k[p];
-    _coeff_j_e(i, j, k, p) = coeff_beta[p] / dt;
-    _coeff_j_sum_j(i, j, k, p) = 0.5 * (1 + coeff_k[p]);
+  // J^{n+1} = k J^n + beta / dt (E^{n+1} - E^n)
+  const auto num_pole = linear_dispersive_material.numPoles();
+  ADEMaterialCoefficient coeff;
+  coeff._coeff_j_e_p.assign(num_pole, 0);
+  coeff._coeff_j_j_p.assign(num_pole, 0);
+  coeff._coeff_j_sum_j_p.assign(num_pole, 0);
+  for (Index p{0}; p < num_pole; ++p) {
+    coeff._coeff_j_j.emplace_back(coeff_k[p]);
+    coeff._coeff_j_e_n.emplace_back(coeff_beta[p] / dt);
+    coeff._coeff_j_e.emplace_back(-coeff_beta[p] / dt);
+    coeff._coeff_j_sum_j.emplace_back(0.5 * (1 + coeff_k[p]));
   }
 
   auto epsilon_inf = linear_dispersive_material.epsilonInf();
@@ -88,37 +110,10 @@ auto DebyeADEMethodStorage::correctCoeff(
   const auto temp_b = DebyeADEMethodCoefficient::b(
       epsilon_inf, constant::EPSILON_0, sum_beta, dt, sigma_e);
 
-  _coeff_e_j_sum(i, j, k) = -temp_b;
-
-  auto correct_func = [a = temp_a, b = temp_b](const auto da, const auto db,
-                                               auto& cece, auto& cecha,
-                                               auto& cechb) {
-    cece = a;
-    cecha = -b / db;
-    cechb = b / da;
-  };
-
-  const auto dx = grid_space->hSizeX()(i);
-  const auto dy = grid_space->hSizeY()(j);
-  const auto dz = grid_space->hSizeZ()(k);
-
-  auto& cexe = calculation_param->fdtdCoefficient()->cexe()(i, j, k);
-  auto& cexhy = calculation_param->fdtdCoefficient()->cexhy()(i, j, k);
-  auto& cexhz = calculation_param->fdtdCoefficient()->cexhz()(i, j, k);
-
-  correct_func(dy, dz, cexe, cexhy, cexhz);
-
-  auto& ceye = calculation_param->fdtdCoefficient()->ceye()(i, j, k);
-  auto& ceyhz = calculation_param->fdtdCoefficient()->ceyhz()(i, j, k);
-  auto& ceyhx = calculation_param->fdtdCoefficient()->ceyhx()(i, j, k);
-
-  correct_func(dz, dx, ceye, ceyhz, ceyhx);
-
-  auto& ceze = calculation_param->fdtdCoefficient()->ceze()(i, j, k);
-  auto& cezhx = calculation_param->fdtdCoefficient()->cezhx()(i, j, k);
-  auto& cezhy = calculation_param->fdtdCoefficient()->cezhy()(i, j, k);
-
-  correct_func(dx, dy, ceze, cezhx, cezhy);
+  coeff._cece = temp_a;
+  coeff._ceh = temp_b;
+  coeff._coeff_e_j_sum = -temp_b;
+  return coeff;
 }
 
-}  // namespace xfdtd
\ No newline at end of file
+}  // namespace xfdtd
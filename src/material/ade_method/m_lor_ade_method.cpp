@@ -41,8 +41,13 @@ class MLorentzADEMethodCoefficient {
 };
 
 MLorentzADEMethodStorage::MLorentzADEMethodStorage(Index num_pole, Index nx,
-                                                   Index ny, Index nz)
-    : ADEMethodStorage{num_pole} {
+                                                   Index ny, Index nz,
+                                                   bool sparse)
+    : ADEMethodStorage{num_pole, sparse} {
+  if (sparse) {
+    return;
+  }
+
   _coeff_j_j = xt::zeros<Real>({nx, ny, nz, num_pole});
   _coeff_j_j_p = xt::zeros<Real>({nx, ny, nz, num_pole});
   _coeff_j_e_n = xt::zeros<Real>({nx, ny, nz, num_pole});
@@ -68,18 +73,34 @@ auto MLorentzADEMethodStorage::correctCoeff(
     const LinearDispersiveMaterial& linear_dispersive_material,
     const std::shared_ptr<const GridSpace>& grid_space,
     const std::shared_ptr<CalculationParam>& calculation_param) -> void {
-  const auto equation = linear_dispersive_material.equation();
-  const auto m_lor_eq = std::dynamic_pointer_cast<MLorentzEqDecision>(equation);
-  const auto dt = calculation_param->timeParam()->dt();
+  checkNumPole(linear_dispersive_material);
 
-  if (_num_pole < linear_dispersive_material.numPoles()) {
-    std::stringstream ss;
-    ss << "The number of poles is not enough. The number of poles is "
-       << _num_pole << " but the number of poles in the material is "
-       << linear_dispersive_material.numPoles();
-    throw XFDTDLinearDispersiveMaterialException{ss.str()};
+  const auto dt = calculation_param->timeParam()->dt();
+  const auto coeff = coefficient(linear_dispersive_material, dt);
+
+  if (!_sparse) {
+    for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
+      _coeff_j_e_n(i, j, k, p) = coeff._coeff_j_e_n[p];
+      _coeff_j_e(i, j, k, p) = coeff._coeff_j_e[p];
+      _coeff_j_e_p(i, j, k, p) = coeff._coeff_j_e_p[p];
+      _coeff_j_j(i, j, k, p) = coeff._coeff_j_j[p];
+      _coeff_j_j_p(i, j, k, p) = coeff._coeff_j_j_p[p];
+      _coeff_j_sum_j(i, j, k, p) = coeff._coeff_j_sum_j[p];
+      _coeff_j_sum_j_p(i, j, k, p) = coeff._coeff_j_sum_j_p[p];
+    }
+
+    _coeff_e_j_sum(i, j, k) = coeff._coeff_e_j_sum;
+    _coeff_e_e_p(i, j, k) = coeff._coeff_e_e_p;
   }
 
+  correctEUpdateCoeff(i, j, k, coeff, grid_space, calculation_param);
+}
+
+auto MLorentzADEMethodStorage::coefficient(
+    const LinearDispersiveMaterial& linear_dispersive_material,
+    Real dt) const -> ADEMaterialCoefficient {
+  const auto equation = linear_dispersive_material.equation();
+  const auto m_lor_eq = std::dynamic_pointer_cast<MLorentzEqDecision>(equation);
   if (m_lor_eq == nullptr) {
     throw XFDTDLinearDispersiveMaterialException{
         "The equation is not MLorentzEqDecision"};
@@ -92,26 +113,20 @@ auto MLorentzADEMethodStorage::correctCoeff(
   auto e = MLorentzADEMethodCoefficient::e(m_lor_eq->b1(), m_lor_eq->b2(), dt);
   auto f = MLorentzADEMethodCoefficient::f(m_lor_eq->b1(), m_lor_eq->b2(), dt);
 
-  for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
-    _coeff_j_e_n(i, j, k, p) = a(p) / f(p);
-    _coeff_j_e(i, j, k, p) = b(p) / f(p);
-    _coeff_j_e_p(i, j, k, p) = c(p) / f(p);
-    _coeff_j_j(i, j, k, p) = d(p) / f(p);
-    _coeff_j_j_p(i, j, k, p) = e(p) / f(p);
-    _coeff_j_sum_j(i, j, k, p) = 0.5 * (1 + d(p) / f(p));
-    _coeff_j_sum_j_p(i, j, k, p) = 0.5 * (e(p) / f(p));
-  }
-
+  ADEMaterialCoefficient coeff;
   auto sum_a_f = Real{0};
-  for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
-    sum_a_f += a(p) / f(p);
-  }
   auto sum_b_f = Real{0};
+  auto sum_c_f = Real{0};
   for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
+    coeff._coeff_j_e_n.emplace_back(a(p) / f(p));
+    coeff._coeff_j_e.emplace_back(b(p) / f(p));
+    coeff._coeff_j_e_p.emplace_back(c(p) / f(p));
+    coeff._coeff_j_j.emplace_back(d(p) / f(p));
+    coeff._coeff_j_j_p.emplace_back(e(p) / f(p));
+    coeff._coeff_j_sum_j.emplace_back(0.5 * (1 + d(p) / f(p)));
+    coeff._coeff_j_sum_j_p.emplace_back(0.5 * (e(p) / f(p)));
+    sum_a_f += a(p) / f(p);
     sum_b_f += b(p) / f(p);
-  }
-  Real sum_c_f = 0;
-  for (Index p{0}; p < linear_dispersive_material.numPoles(); ++p) {
     sum_c_f += c(p) / f(p);
   }
 
@@ -121,41 +136,14 @@ auto MLorentzADEMethodStorage::correctCoeff(
   Real temp =
       (epsilon_inf * constant::EPSILON_0) / dt + 0.5 * sum_a_f + 0.5 * sigma_e;
 
-  _coeff_e_j_sum(i, j, k) = -1 / temp;
-  _coeff_e_e_p(i, j, k) = -0.5 * sum_c_f / temp;
-
-  auto correct_func = [epsilon_inf, sum_a_f, sum_b_f, temp](
-                          const auto& dt, const auto& da, const auto& db,
-                          const auto& sigma_e, auto& cece, auto& cecha,
-                          auto& cechb) {
-    const auto epsilon_0 = xfdtd::constant::EPSILON_0;
-    cece =
-        ((epsilon_inf * epsilon_0) / dt - 0.5 * sum_b_f - 0.5 * sigma_e) / temp;
-    cecha = -1 / (temp * db);
-    cechb = 1 / (temp * da);
-  };
-
-  const auto dx = grid_space->hSizeX()(i);
-  const auto dy = grid_space->hSizeY()(j);
-  const auto dz = grid_space->hSizeZ()(k);
-
-  auto& cexe = calculation_param->fdtdCoefficient()->cexe().at(i, j, k);
-  auto& cexhy = calculation_param->fdtdCoefficient()->cexhy().at(i, j, k);
-  auto& cexhz = calculation_param->fdtdCoefficient()->cexhz().at(i, j, k);
-
-  correct_func(dt, dy, dz, sigma_e, cexe, cexhy, cexhz);
-
-  auto& ceye = calculation_param->fdtdCoefficient()->ceye().at(i, j, k);
-  auto& ceyhz = calculation_param->fdtdCoefficient()->ceyhz().at(i, j, k);
-  auto& ceyhx = calculation_param->fdtdCoefficient()->ceyhx().at(i, j, k);
-
-  correct_func(dt, dz, dx, sigma_e, ceye, ceyhz, ceyhx);
-
-  auto& ceze = calculation_param->fdtdCoefficient()->ceze().at(i, j, k);
-  auto& cezhx = calculation_param->fdtdCoefficient()->cezhx().at(i, j, k);
-  auto& cezhy = calculation_param->fdtdCoefficient()->cezhy().at(i, j, k);
-
-  correct_func(dt, dx, dy, sigma_e, ceze, cezhx, cezhy);
+  coeff._coeff_e_j_sum = -1 / temp;
+  coeff._coeff_e_e_p = -0.5 * sum_c_f / temp;
+  coeff._cece = ((epsilon_inf * constant::EPSILON_0) / dt - 0.5 * sum_b_f -
+                 0.5 * sigma_e) /
+                temp;
+  coeff._ceh = 1 / temp;
+  coeff._ceh_den = temp;
+  return coeff;
 }
 
-}  // namespace xfdtd
\ No newline at end of file
+}  // namespace xfdtd
@@ -0,0 +1,82 @@
+#include "monitor/async_output_writer.h"
+
+#include <utility>
+#include <xtensor/xnpy.hpp>
+
+namespace xfdtd {
+
+AsyncOutputWriter::AsyncOutputWriter(std::size_t queue_depth)
+    : _queue_depth{queue_depth == 0 ? 1 : queue_depth},
+      _pool(_queue_depth),
+      _thread{[this]() { work(); }} {}
+
+AsyncOutputWriter::~AsyncOutputWriter() {
+  {
+    std::scoped_lock lock{_mutex};
+    _stop = true;
+  }
+  _job_cv.notify_one();
+  _thread.join();
+}
+
+auto AsyncOutputWriter::submit(std::string path,
+                               const Array<Real>& data) -> void {
+  std::unique_lock lock{_mutex};
+  _free_cv.wait(lock, [this]() { return !_pool.empty() || _exception; });
+  rethrow();
+
+  auto buffer = std::move(_pool.back());
+  _pool.pop_back();
+  lock.unlock();
+
+  // Same shape as the last frame most of the time, so no allocation
+  buffer = data;
+
+  lock.lock();
+  _jobs.emplace_back(Job{std::move(path), std::move(buffer)});
+  lock.unlock();
+  _job_cv.notify_one();
+}
+
+auto AsyncOutputWriter::flush() -> void {
+  std::unique_lock lock{_mutex};
+  _free_cv.wait(lock, [this]() { return _pool.size() == _queue_depth; });
+  rethrow();
+}
+
+auto AsyncOutputWriter::work() -> void {
+  while (true) {
+    std::unique_lock lock{_mutex};
+    _job_cv.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+    if (_jobs.empty()) {
+      return;
+    }
+
+    auto job = std::move(_jobs.front());
+    _jobs.pop_front();
+    lock.unlock();
+
+    std::exception_ptr exception;
+    try {
+      xt::dump_npy(job._path, job._data);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception && !_exception) {
+      _exception = exception;
+    }
+    _pool.emplace_back(std::move(job._data));
+    lock.unlock();
+    _free_cv.notify_all();
+  }
+}
+
+auto AsyncOutputWriter::rethrow() -> void {
+  if (_exception) {
+    std::rethrow_exception(std::exchange(_exception, nullptr));
+  }
+}
+
+}  // namespace xfdtd
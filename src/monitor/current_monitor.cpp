@@ -2,6 +2,7 @@
 #include <xfdtd/monitor/current_monitor.h>
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 #include <xfdtd/util/transform.h>
 
 #include <memory>
@@ -297,7 +298,7 @@ void CurrentMonitor::update() {
             emf->hz()(_ie - 1, _je, k) * _db(k - _hb_range_ap.start());
       }
     }
-    _node_data(t) = _positive * (integral_z + integral_y);
+    record(t, _positive * (integral_z + integral_y));
     return;
   }
 
@@ -340,7 +341,7 @@ void CurrentMonitor::update() {
             emf->hx()(i, _je - 1, _ke) * _db(i - _hb_range_ap.start());
       }
     }
-    _node_data(t) = _positive * (integral_x + integral_z);
+    record(t, _positive * (integral_x + integral_z));
     return;
   }
 
@@ -373,15 +374,28 @@ void CurrentMonitor::update() {
       }
     }
 
-    _node_data(t) = _positive * (integral_x + integral_y);
+    record(t, _positive * (integral_x + integral_y));
     return;
   }
 }
 
+auto CurrentMonitor::record(Index t, Real value) -> void {
+  if (keepTimeSeries()) {
+    _node_data(t) = value;
+  }
+  accumulateDFT(t, value);
+}
+
 void CurrentMonitor::initTimeDependentVariable() {
   setTime(calculationParamPtr()->timeParam()->hTime());
-  _node_data = xt::zeros_like(time());
-  data() = xt::zeros_like(time());
+  initRunningDFT();
+  if (keepTimeSeries()) {
+    _node_data = xt::zeros_like(time());
+    data() = xt::zeros_like(time());
+  } else {
+    _node_data = xt::zeros<Real>({std::size_t{0}});
+    data() = xt::zeros<Real>({std::size_t{0}});
+  }
 }
 
 void CurrentMonitor::initParallelizedConfig() { makeMpiSubComm(); }
@@ -391,6 +405,11 @@ auto CurrentMonitor::gatherData() -> void {
     return;
   }
 
+  gatherDFT();
+  if (!keepTimeSeries()) {
+    return;
+  }
+
   if (monitorMpiConfig().size() <= 1) {
     data() = _node_data;
     return;
@@ -422,4 +441,16 @@ auto CurrentMonitor::toString() const -> std::string {
   return ss.str();
 }
 
+auto CurrentMonitor::saveState(Checkpoint& checkpoint,
+                               const std::string& prefix) const -> void {
+  TimeMonitor::saveState(checkpoint, prefix);
+  checkpoint.save(prefix + "node_data", _node_data);
+}
+
+auto CurrentMonitor::loadState(const Checkpoint& checkpoint,
+                               const std::string& prefix) -> void {
+  TimeMonitor::loadState(checkpoint, prefix);
+  checkpoint.load(prefix + "node_data", _node_data);
+}
+
 }  // namespace xfdtd
@@ -83,18 +83,67 @@ void FieldMonitor::output() {
   if (!valid()) {
     return;
   }
-  auto em_field{emfPtr()};
-
-  auto grid_box{nodeGridBox()};
-  auto grid_box_size{grid_box.size()};
-  auto x_range{xt::range(grid_box.origin().i(), grid_box.end().i())};
-  auto y_range{xt::range(grid_box.origin().j(), grid_box.end().j())};
-  auto z_range{xt::range(grid_box.origin().k(), grid_box.end().k())};
-  data() = xt::view(em_field->field(field()), x_range, y_range, z_range);
+
+  if (!_snapshot) {
+    auto em_field{emfPtr()};
+
+    auto grid_box{nodeGridBox()};
+    auto x_range{xt::range(grid_box.origin().i(), grid_box.end().i())};
+    auto y_range{xt::range(grid_box.origin().j(), grid_box.end().j())};
+    auto z_range{xt::range(grid_box.origin().k(), grid_box.end().k())};
+    data() = xt::view(em_field->field(field()), x_range, y_range, z_range);
+  }
+
+  _snapshot = false;
   gatherData();
   Monitor::output();
+
+  // gatherData() replaces the data by the global one on the root
+  if (_sharded && data().size() != nodeTask().xRange().size() *
+                                       nodeTask().yRange().size() *
+                                       nodeTask().zRange().size()) {
+    initShards(0);
+  }
+}
+
+auto FieldMonitor::initShards(std::size_t num_shards) -> void {
+  _sharded = true;
+  if (!valid()) {
+    return;
+  }
+
+  data() = xt::zeros<Real>({nodeTask().xRange().size(),
+                            nodeTask().yRange().size(),
+                            nodeTask().zRange().size()});
 }
 
+auto FieldMonitor::updateShard(std::size_t shard,
+                               const IndexTask& task) -> void {
+  if (!valid()) {
+    return;
+  }
+
+  auto t = taskIntersection(nodeTask(), task);
+  if (!t.has_value()) {
+    return;
+  }
+
+  const auto& f = emfPtr()->field(field());
+  const auto is = nodeTask().xRange().start();
+  const auto js = nodeTask().yRange().start();
+  const auto ks = nodeTask().zRange().start();
+  auto& d = data();
+  for (auto i{t->xRange().start()}; i < t->xRange().end(); ++i) {
+    for (auto j{t->yRange().start()}; j < t->yRange().end(); ++j) {
+      for (auto k{t->zRange().start()}; k < t->zRange().end(); ++k) {
+        d(i - is, j - js, k - ks) = f(i, j, k);
+      }
+    }
+  }
+}
+
+auto FieldMonitor::reduceShards() -> void { _snapshot = _sharded; }
+
 EMF::Field FieldMonitor::field() const { return _field; }
 
 auto FieldMonitor::initParallelizedConfig() -> void {
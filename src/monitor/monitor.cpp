@@ -3,12 +3,15 @@
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/parallel/mpi_support.h>
 #include <xfdtd/parallel/parallelized_config.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <algorithm>
 #include <filesystem>
 #include <xtensor/xio.hpp>
 #include <xtensor/xnpy.hpp>
 
+#include "monitor/async_output_writer.h"
+
 namespace xfdtd {
 
 Monitor::Monitor(std::unique_ptr<Shape> shape, std::string name,
@@ -50,11 +53,49 @@ void Monitor::output() {
   }
 
   auto out_file{out_dir / (name() + ".npy")};
+  if (_output_writer != nullptr) {
+    _output_writer->submit(out_file.string(), _data);
+    return;
+  }
+
   xt::dump_npy(out_file.string(), _data);
 }
 
+auto Monitor::setAsyncOutput(std::size_t queue_depth) -> void {
+  if (queue_depth == 0) {
+    _output_writer.reset();
+    return;
+  }
+
+  _output_writer = std::make_shared<AsyncOutputWriter>(queue_depth);
+}
+
+auto Monitor::flushOutput() -> void {
+  if (_output_writer != nullptr) {
+    _output_writer->flush();
+  }
+}
+
 void Monitor::initTimeDependentVariable() {}
 
+auto Monitor::shardable() const -> bool { return false; }
+
+auto Monitor::initShards(std::size_t num_shards) -> void {}
+
+auto Monitor::updateShard(std::size_t shard, const IndexTask& task) -> void {}
+
+auto Monitor::reduceShards() -> void { update(); }
+
+auto Monitor::saveState(Checkpoint& checkpoint,
+                        const std::string& prefix) const -> void {
+  checkpoint.save(prefix + "data", _data);
+}
+
+auto Monitor::loadState(const Checkpoint& checkpoint,
+                        const std::string& prefix) -> void {
+  checkpoint.load(prefix + "data", _data);
+}
+
 GridBox Monitor::globalGridBox() const { return _global_grid_box; }
 
 GridBox Monitor::nodeGridBox() const { return _node_grid_box; }
@@ -1,4 +1,5 @@
 #include <xfdtd/monitor/movie_monitor.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <iomanip>
 #include <memory>
@@ -35,6 +36,33 @@ void MovieMonitor::update() {
 
 void MovieMonitor::output() {}
 
+auto MovieMonitor::setAsyncOutput(std::size_t queue_depth) -> void {
+  frame()->setAsyncOutput(queue_depth);
+}
+
+auto MovieMonitor::flushOutput() -> void { frame()->flushOutput(); }
+
+auto MovieMonitor::initShards(std::size_t num_shards) -> void {
+  frame()->initShards(num_shards);
+}
+
+auto MovieMonitor::updateShard(std::size_t shard,
+                               const IndexTask& task) -> void {
+  if (_frame_count % _frame_interval == 0) {
+    frame()->updateShard(shard, task);
+  }
+}
+
+auto MovieMonitor::reduceShards() -> void {
+  if (_frame_count % _frame_interval == 0) {
+    frame()->setName(formatFrameCount(_frame_count));
+    frame()->reduceShards();
+    frame()->output();
+  }
+
+  _frame_count++;
+}
+
 auto MovieMonitor::initParallelizedConfig() -> void {
   frame()->initParallelizedConfig();
 }
@@ -74,4 +102,14 @@ std::string MovieMonitor::toString() const {
 
 auto MovieMonitor::valid() const -> bool { return frame()->valid(); }
 
+auto MovieMonitor::saveState(Checkpoint& checkpoint,
+                             const std::string& prefix) const -> void {
+  checkpoint.saveValue<Index>(prefix + "frame_count", _frame_count);
+}
+
+auto MovieMonitor::loadState(const Checkpoint& checkpoint,
+                             const std::string& prefix) -> void {
+  _frame_count = checkpoint.loadValue<Index>(prefix + "frame_count");
+}
+
 }  // namespace xfdtd
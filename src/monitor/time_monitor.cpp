@@ -1,6 +1,10 @@
+#include <xfdtd/common/constant.h>
 #include <xfdtd/monitor/time_monitor.h>
+#include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <utility>
+#include <xtensor.hpp>
 
 namespace xfdtd {
 
@@ -15,7 +19,13 @@ auto TimeMonitor::output() -> void {
 
   gatherData();
   auto temp = data();
-  data() = xt::stack(xt::xtuple(time(), data()));
+  if (keepTimeSeries()) {
+    data() = xt::stack(xt::xtuple(time(), data()));
+  } else {
+    Array1D<Real> re = xt::cast<Real>(xt::real(runningDFT()));
+    Array1D<Real> im = xt::cast<Real>(xt::imag(runningDFT()));
+    data() = xt::stack(xt::xtuple(dftFrequencies(), re, im));
+  }
   Monitor::output();
   data() = temp;
 }
@@ -24,10 +34,95 @@ auto TimeMonitor::toString() const -> std::string { return "TimeMonitor"; }
 
 auto TimeMonitor::time() const -> const Array1D<Real>& { return _time; }
 
+auto TimeMonitor::enableRunningDFT(Array1D<Real> frequencies,
+                                   bool keep_time_series) -> void {
+  _dft_frequencies = std::move(frequencies);
+  _keep_time_series = keep_time_series || _dft_frequencies.size() == 0;
+  initRunningDFT();
+}
+
+auto TimeMonitor::saveState(Checkpoint& checkpoint,
+                            const std::string& prefix) const -> void {
+  Monitor::saveState(checkpoint, prefix);
+  if (runningDFTEnabled()) {
+    checkpoint.save(prefix + "node_dft", _node_dft);
+    checkpoint.save(prefix + "dft_step", _dft_step);
+    checkpoint.save(prefix + "dft_kernel", _dft_kernel);
+    checkpoint.saveValue<Index>(prefix + "dft_next_step", _dft_next_step);
+  }
+}
+
+auto TimeMonitor::loadState(const Checkpoint& checkpoint,
+                            const std::string& prefix) -> void {
+  Monitor::loadState(checkpoint, prefix);
+  if (runningDFTEnabled()) {
+    checkpoint.load(prefix + "node_dft", _node_dft);
+    // The recursive kernel goes on as in the run that saved it
+    checkpoint.load(prefix + "dft_step", _dft_step);
+    checkpoint.load(prefix + "dft_kernel", _dft_kernel);
+    _dft_next_step = checkpoint.loadValue<Index>(prefix + "dft_next_step");
+  }
+}
+
 auto TimeMonitor::time() -> Array1D<Real>& { return _time; }
 
 auto TimeMonitor::setTime(Array1D<Real> time) -> void {
   _time = std::move(time);
 }
 
+auto TimeMonitor::initRunningDFT() -> void {
+  const auto n = _dft_frequencies.size();
+  _dft_step = xt::zeros<std::complex<AccReal>>({n});
+  _dft_kernel = xt::zeros<std::complex<AccReal>>({n});
+  _node_dft = xt::zeros<std::complex<AccReal>>({n});
+  _dft = xt::zeros<std::complex<AccReal>>({n});
+  _dft_next_step = 0;
+}
+
+auto TimeMonitor::accumulateDFT(Index t, Real value) -> void {
+  if (!runningDFTEnabled()) {
+    return;
+  }
+
+  // Exact kernel at the first step, after a jump of the time step and every
+  // `reseed` steps, so the phasor doesn't drift
+  constexpr Index reseed{1024};
+  const auto dt =
+      static_cast<AccReal>(calculationParamPtr()->timeParam()->dt());
+  if (t != _dft_next_step || t % reseed == 0) {
+    for (std::size_t n{0}; n < _dft_frequencies.size(); ++n) {
+      const auto omega = -2 * constant::ACC_PI * _dft_frequencies(n);
+      _dft_step(n) = std::exp(std::complex<AccReal>{0, omega * dt});
+      _dft_kernel(n) = std::exp(std::complex<AccReal>{
+          0, omega * static_cast<AccReal>(t + 1) * dt});
+    }
+  }
+
+  const auto x = static_cast<AccReal>(value) * dt;
+  for (std::size_t n{0}; n < _dft_frequencies.size(); ++n) {
+    _node_dft(n) += x * _dft_kernel(n);
+    _dft_kernel(n) *= _dft_step(n);
+  }
+  _dft_next_step = t + 1;
+}
+
+auto TimeMonitor::gatherDFT() -> void {
+  if (!runningDFTEnabled()) {
+    return;
+  }
+
+  if (monitorMpiConfig().size() <= 1) {
+    _dft = _node_dft;
+    return;
+  }
+
+  // Reduced in Real like the far field data
+  Array1D<std::complex<Real>> node_dft =
+      xt::cast<std::complex<Real>>(_node_dft);
+  Array1D<std::complex<Real>> dft = xt::zeros_like(node_dft);
+  MpiSupport::instance().reduceSum(monitorMpiConfig(), node_dft.data(),
+                                   dft.data(), dft.size());
+  _dft = xt::cast<std::complex<AccReal>>(dft);
+}
+
 }  // namespace xfdtd
@@ -3,6 +3,7 @@
 #include <xfdtd/monitor/monitor.h>
 #include <xfdtd/monitor/voltage_monitor.h>
 #include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 #include <xfdtd/util/transform.h>
 
 #include <sstream>
@@ -200,44 +201,98 @@ void VoltageMonitor::update() {
     return;
   }
 
-  auto emf{emfPtr()};
   auto t{calculationParamPtr()->timeParam()->currentTimeStep()};
+  record(t, integrate(nodeTask()));
+}
+
+auto VoltageMonitor::initShards(std::size_t num_shards) -> void {
+  _shard_sum.assign(num_shards, 0);
+}
+
+auto VoltageMonitor::updateShard(std::size_t shard,
+                                 const IndexTask& task) -> void {
+  if (!valid()) {
+    return;
+  }
+
+  auto t = taskIntersection(nodeTask(), task);
+  _shard_sum[shard] = t.has_value() ? integrate(*t) : 0;
+}
+
+auto VoltageMonitor::reduceShards() -> void {
+  if (!valid()) {
+    return;
+  }
+
+  auto t{calculationParamPtr()->timeParam()->currentTimeStep()};
+  Real sum{0};
+  for (const auto& s : _shard_sum) {
+    sum += s;
+  }
+
+  record(t, sum);
+}
+
+auto VoltageMonitor::record(Index t, Real value) -> void {
+  if (keepTimeSeries()) {
+    _node_data(t) += value;
+  }
+  accumulateDFT(t, value);
+}
+
+auto VoltageMonitor::integrate(const IndexTask& task) const -> Real {
+  auto emf{emfPtr()};
+  const auto is = task.xRange().start();
+  const auto ie = task.xRange().end();
+  const auto js = task.yRange().start();
+  const auto je = task.yRange().end();
+  const auto ks = task.zRange().start();
+  const auto ke = task.zRange().end();
+  Real sum{0};
 
   if (Axis::fromDirectionToXYZ(_direction) == Axis::XYZ::X) {
-    for (auto i{_is}; i < _ie; ++i) {
-      for (auto j{_js}; j < _je; ++j) {
-        for (auto k{_ks}; k < _ke; ++k) {
-          _node_data(t) += _coff(i - _is) * emf->ex()(i, j, k);
+    for (auto i{is}; i < ie; ++i) {
+      for (auto j{js}; j < je; ++j) {
+        for (auto k{ks}; k < ke; ++k) {
+          sum += _coff(i - _is) * emf->ex()(i, j, k);
         }
       }
     }
   }
 
   if (Axis::fromDirectionToXYZ(_direction) == Axis::XYZ::Y) {
-    for (auto i{_is}; i < _ie; ++i) {
-      for (auto j{_js}; j < _je; ++j) {
-        for (auto k{_ks}; k < _ke; ++k) {
-          _node_data(t) += _coff(j - _js) * emf->ey()(i, j, k);
+    for (auto i{is}; i < ie; ++i) {
+      for (auto j{js}; j < je; ++j) {
+        for (auto k{ks}; k < ke; ++k) {
+          sum += _coff(j - _js) * emf->ey()(i, j, k);
         }
       }
     }
   }
 
   if (Axis::fromDirectionToXYZ(_direction) == Axis::XYZ::Z) {
-    for (auto i{_is}; i < _ie; ++i) {
-      for (auto j{_js}; j < _je; ++j) {
-        for (auto k{_ks}; k < _ke; ++k) {
-          _node_data(t) += _coff(k - _ks) * emf->ez()(i, j, k);
+    for (auto i{is}; i < ie; ++i) {
+      for (auto j{js}; j < je; ++j) {
+        for (auto k{ks}; k < ke; ++k) {
+          sum += _coff(k - _ks) * emf->ez()(i, j, k);
         }
       }
     }
   }
+
+  return sum;
 }
 
 void VoltageMonitor::initTimeDependentVariable() {
   setTime(calculationParamPtr()->timeParam()->eTime());
-  _node_data = xt::zeros_like(time());
-  data() = xt::zeros_like(time());
+  initRunningDFT();
+  if (keepTimeSeries()) {
+    _node_data = xt::zeros_like(time());
+    data() = xt::zeros_like(time());
+  } else {
+    _node_data = xt::zeros<Real>({std::size_t{0}});
+    data() = xt::zeros<Real>({std::size_t{0}});
+  }
 }
 
 void VoltageMonitor::initParallelizedConfig() { makeMpiSubComm(); }
@@ -247,6 +302,11 @@ void VoltageMonitor::gatherData() {
     return;
   }
 
+  gatherDFT();
+  if (!keepTimeSeries()) {
+    return;
+  }
+
   if (monitorMpiConfig().size() <= 1) {
     data() = _node_data;
     return;
@@ -269,4 +329,16 @@ auto VoltageMonitor::toString() const -> std::string {
   return ss.str();
 }
 
+auto VoltageMonitor::saveState(Checkpoint& checkpoint,
+                               const std::string& prefix) const -> void {
+  TimeMonitor::saveState(checkpoint, prefix);
+  checkpoint.save(prefix + "node_data", _node_data);
+}
+
+auto VoltageMonitor::loadState(const Checkpoint& checkpoint,
+                               const std::string& prefix) -> void {
+  TimeMonitor::loadState(checkpoint, prefix);
+  checkpoint.load(prefix + "node_data", _node_data);
+}
+
 }  // namespace xfdtd
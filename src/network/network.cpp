@@ -29,12 +29,23 @@ void Network::setOutputDir(std::string output_dir) {
   _output_dir = std::move(output_dir);
 }
 
+void Network::enableRunningDFT(bool keep_time_series) {
+  _running_dft = true;
+  _keep_time_series = keep_time_series;
+}
+
 void Network::init(
     const std::shared_ptr<const GridSpace>& grid_space,
     const std::shared_ptr<const CalculationParam>& calculation_param,
     const std::shared_ptr<const EMF>& emf) {
   for (auto& port : _ports) {
     port->init(grid_space, calculation_param, emf);
+    if (_running_dft) {
+      port->currentMonitor()->enableRunningDFT(_frequencies,
+                                               _keep_time_series);
+      port->voltageMonitor()->enableRunningDFT(_frequencies,
+                                               _keep_time_series);
+    }
   }
 
   for (std::size_t i{0}; i < _ports.size(); ++i) {
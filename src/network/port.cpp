@@ -1,9 +1,11 @@
+#include <xfdtd/common/constant.h>
 #include <xfdtd/common/type_define.h>
 #include <xfdtd/network/port.h>
 #include <xfdtd/parallel/mpi_support.h>
 #include <xfdtd/util/dft.h>
 
 #include <complex>
+#include <cstddef>
 
 namespace xfdtd {
 
@@ -30,9 +32,9 @@ const std::shared_ptr<VoltageMonitor>& Port::voltageMonitor() const {
   return _voltage_monitor;
 }
 
-const Array1D<std::complex<Real>>& Port::a() const { return _a; }
+const Array1D<std::complex<AccReal>>& Port::a() const { return _a; }
 
-const Array1D<std::complex<Real>>& Port::b() const { return _b; }
+const Array1D<std::complex<AccReal>>& Port::b() const { return _b; }
 
 void Port::init(
     const std::shared_ptr<const GridSpace>& grid_space,
@@ -45,8 +47,17 @@ void Port::calculateSParameters(const Array1D<Real>& frequencies) {
   const auto& c_const = *_current_monitor;
   const auto& v_const = *_voltage_monitor;
 
-  Array1D<Real> current = xt::zeros_like(c_const.data());
-  Array1D<Real> voltage = xt::zeros_like(v_const.data());
+  // The monitors already hold the DFT at these frequencies
+  const auto running_dft = c_const.runningDFTEnabled() &&
+                           v_const.runningDFTEnabled() &&
+                           c_const.dftFrequencies() == frequencies &&
+                           v_const.dftFrequencies() == frequencies;
+  if (!running_dft &&
+      (!c_const.keepTimeSeries() || !v_const.keepTimeSeries())) {
+    throw XFDTDException(
+        "Port: Monitors keep no time series and their running DFT isn't at "
+        "the frequencies of the network.");
+  }
 
   /**
    * @brief Only root in the xfdtd comm can write data to file. First, let the
@@ -57,8 +68,9 @@ void Port::calculateSParameters(const Array1D<Real>& frequencies) {
    *
    */
   auto collect_func = [](const auto& const_monitor, auto& monitor, auto& data,
-                         const auto& tag) {
+                         const auto& tag, const auto& monitor_data) {
     auto& mpi_support = MpiSupport::instance();
+    const auto bytes = static_cast<int>(sizeof(*data.data()) * data.size());
 
     if (!const_monitor.valid()) {
       if (!mpi_support.isRoot()) {
@@ -72,14 +84,14 @@ void Port::calculateSParameters(const Array1D<Real>& frequencies) {
       }
 
       // xfdtd root is not in the monitor comm.
-      mpi_support.recv(mpi_support.config(), data.data(),
-                       sizeof(Real) * data.size(), MpiSupport::ANY_SOURCE, tag);
+      mpi_support.recv(mpi_support.config(), data.data(), bytes,
+                       MpiSupport::ANY_SOURCE, tag);
       return;
     }
 
     monitor.gatherData();
     if (const_monitor.monitorMpiConfig().isRoot()) {
-      data = monitor.data();
+      data = monitor_data(const_monitor);
     }
 
     if (mpi_support.size() <= 1) {
@@ -88,17 +100,16 @@ void Port::calculateSParameters(const Array1D<Real>& frequencies) {
 
     if (!mpi_support.isRoot() && const_monitor.monitorMpiConfig().isRoot()) {
       // monitor root send data to xfdtd root.
-      mpi_support.send(mpi_support.config(), data.data(),
-                       sizeof(Real) * data.size(), mpi_support.config().root(),
-                       tag);
+      mpi_support.send(mpi_support.config(), data.data(), bytes,
+                       mpi_support.config().root(), tag);
       return;
     }
 
     if (mpi_support.isRoot() && !const_monitor.monitorMpiConfig().isRoot()) {
       // xfdtd root is in the monitor comm, but not the root of the monitor
       // comm.
-      mpi_support.recv(mpi_support.config(), data.data(),
-                       sizeof(Real) * data.size(), MpiSupport::ANY_SOURCE, tag);
+      mpi_support.recv(mpi_support.config(), data.data(), bytes,
+                       MpiSupport::ANY_SOURCE, tag);
     }
 
     // 1. not root in the xfdtd comm and not root in the monitor comm.
@@ -106,27 +117,57 @@ void Port::calculateSParameters(const Array1D<Real>& frequencies) {
     // These two cases do not need to do anything.
   };
 
-  // multi-threading or single-threading
-  // std::vector<std::thread> collector;
+  auto dt{_dt};
+  // TODO(franzero): why -1.5*dt?
+  const auto current_shift = static_cast<Real>(-1.5 * dt);
+  Array1D<std::complex<AccReal>> i;
+  Array1D<std::complex<AccReal>> v;
+
+  if (running_dft) {
+    auto dft_of = [](const TimeMonitor& m) -> const auto& {
+      return m.runningDFT();
+    };
+    i = xt::zeros<std::complex<AccReal>>({frequencies.size()});
+    v = xt::zeros<std::complex<AccReal>>({frequencies.size()});
+    collect_func(c_const, *_current_monitor, i, CURRENT_TAG, dft_of);
+    collect_func(v_const, *_voltage_monitor, v, VOLTAGE_TAG, dft_of);
+
+    MpiSupport::instance().barrier();
+
+    if (!MpiSupport::instance().isRoot()) {
+      return;
+    }
+
+    // The running DFT has no time shift, apply the one of the current here
+    for (std::size_t n{0}; n < frequencies.size(); ++n) {
+      i(n) *= std::exp(std::complex<AccReal>{
+          0, -2 * constant::ACC_PI * frequencies(n) * current_shift});
+    }
+  } else {
+    auto data_of = [](const TimeMonitor& m) -> const auto& { return m.data(); };
+    Array1D<Real> current = xt::zeros_like(c_const.data());
+    Array1D<Real> voltage = xt::zeros_like(v_const.data());
+
+    // multi-threading or single-threading
+    // std::vector<std::thread> collector;
+
+    collect_func(c_const, *_current_monitor, current, CURRENT_TAG, data_of);
+    collect_func(v_const, *_voltage_monitor, voltage, VOLTAGE_TAG, data_of);
 
-  collect_func(c_const, *_current_monitor, current, CURRENT_TAG);
-  collect_func(v_const, *_voltage_monitor, voltage, VOLTAGE_TAG);
+    MpiSupport::instance().barrier();
 
-  MpiSupport::instance().barrier();
+    if (!MpiSupport::instance().isRoot()) {
+      return;
+    }
 
-  if (!MpiSupport::instance().isRoot()) {
-    return;
+    i = dft(current, dt, frequencies, current_shift);
+    v = dft(voltage, dt, frequencies);
   }
 
-  auto dt{_dt};
-  auto z{_impedance};
+  auto z{std::complex<AccReal>{_impedance}};
   auto k{std::sqrt(std::real(z))};
-  auto i{dft(current, dt, frequencies,
-             -1.5 * dt)};  // TODO(franzero): why -1.5*dt?
-  auto v{dft(voltage, dt, frequencies)};
-
-  _a = Real{0.5} * (v + z * i) / k;
-  _b = Real{0.5} * (v - std::conj(z) * i) / k;
+  _a = AccReal{0.5} * (v + z * i) / k;
+  _b = AccReal{0.5} * (v - std::conj(z) * i) / k;
 }
 
 }  // namespace xfdtd
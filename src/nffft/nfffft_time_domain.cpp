@@ -5,10 +5,13 @@
 #include <xfdtd/grid_space/grid_space.h>
 #include <xfdtd/nffft/nffft_time_domain.h>
 #include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
+#include <sstream>
+#include <vector>
 #include <xtensor.hpp>
 #include <xtensor/xnpy.hpp>
 
@@ -18,14 +21,42 @@ namespace xfdtd {
 
 NFFFTTimeDomain::NFFFTTimeDomain(Index distance_x, Index distance_y,
                                  Index distance_z, Real theta, Real phi)
-    : NFFFT{distance_x, distance_y, distance_z}, _theta{theta}, _phi{phi} {}
+    : NFFFTTimeDomain{distance_x, distance_y, distance_z, Array1D<Real>{theta},
+                      Array1D<Real>{phi}} {}
 
 NFFFTTimeDomain::NFFFTTimeDomain(Index distance_x, Index distance_y,
                                  Index distance_z, std::string_view output_dir,
                                  Real theta, Real phi)
+    : NFFFTTimeDomain{distance_x, distance_y, distance_z, output_dir,
+                      Array1D<Real>{theta}, Array1D<Real>{phi}} {}
+
+NFFFTTimeDomain::NFFFTTimeDomain(Index distance_x, Index distance_y,
+                                 Index distance_z, Array1D<Real> theta,
+                                 Array1D<Real> phi)
+    : NFFFT{distance_x, distance_y, distance_z},
+      _theta{std::move(theta)},
+      _phi{std::move(phi)} {
+  if (_theta.size() == 0 || _theta.size() != _phi.size()) {
+    std::stringstream ss;
+    ss << "NFFFTTimeDomain: theta and phi must have the same non-zero size, "
+       << "got " << _theta.size() << " and " << _phi.size();
+    throw XFDTDNFFFTTimeDomainException(ss.str());
+  }
+}
+
+NFFFTTimeDomain::NFFFTTimeDomain(Index distance_x, Index distance_y,
+                                 Index distance_z, std::string_view output_dir,
+                                 Array1D<Real> theta, Array1D<Real> phi)
     : NFFFT{distance_x, distance_y, distance_z, output_dir},
-      _theta{theta},
-      _phi{phi} {}
+      _theta{std::move(theta)},
+      _phi{std::move(phi)} {
+  if (_theta.size() == 0 || _theta.size() != _phi.size()) {
+    std::stringstream ss;
+    ss << "NFFFTTimeDomain: theta and phi must have the same non-zero size, "
+       << "got " << _theta.size() << " and " << _phi.size();
+    throw XFDTDNFFFTTimeDomainException(ss.str());
+  }
+}
 
 NFFFTTimeDomain::~NFFFTTimeDomain() = default;
 
@@ -49,21 +80,30 @@ auto NFFFTTimeDomain::init(
 }
 
 auto NFFFTTimeDomain::initTimeDependentVariable() -> void {
-  auto distance_range_e = distanceRange<EMF::Attribute::E>();
-  auto distance_range_h = distanceRange<EMF::Attribute::H>();
+  auto distance_range_e = std::vector<Range<Real>>{};
+  auto distance_range_h = std::vector<Range<Real>>{};
+  auto observation_direction = std::vector<Vector>{};
+  auto max_size_e = Real{0};
+  auto max_size_h = Real{0};
+  for (Index d{0}; d < numDirection(); ++d) {
+    distance_range_e.emplace_back(distanceRange<EMF::Attribute::E>(d));
+    distance_range_h.emplace_back(distanceRange<EMF::Attribute::H>(d));
+    observation_direction.emplace_back(observationDirection(d));
+    max_size_e = std::max(max_size_e, distance_range_e.back().size());
+    max_size_h = std::max(max_size_h, distance_range_h.back().size());
+  }
 
-  auto aux_e = (distance_range_e.size()) /
-               (constant::C_0 * calculationParam()->timeParam()->dt());
-  auto aux_h = (distance_range_h.size()) /
-               (constant::C_0 * calculationParam()->timeParam()->dt());
+  // every direction gets as many potentials as the longest one
+  auto aux_e =
+      max_size_e / (constant::C_0 * calculationParam()->timeParam()->dt());
+  auto aux_h =
+      max_size_h / (constant::C_0 * calculationParam()->timeParam()->dt());
 
   auto num_e = static_cast<Index>(std::ceil(aux_e)) +
                calculationParam()->timeParam()->size() + 4;  // why +4?
   auto num_h = static_cast<Index>(std::ceil(aux_h)) +
                calculationParam()->timeParam()->size() + 4;
 
-  auto observation_direction = observationDirection();
-
   _td_plane_xn->initForUpdate(num_e, num_h, distance_range_e, distance_range_h,
                               observation_direction);
   _td_plane_xp->initForUpdate(num_e, num_h, distance_range_e, distance_range_h,
@@ -94,24 +134,85 @@ auto NFFFTTimeDomain::update() -> void {
   _td_plane_zp->update<EMF::Attribute::H>();
 }
 
+auto NFFFTTimeDomain::initShards(std::size_t num_shards) -> void {
+  _td_plane_xn->initShards(num_shards);
+  _td_plane_xp->initShards(num_shards);
+  _td_plane_yn->initShards(num_shards);
+  _td_plane_yp->initShards(num_shards);
+  _td_plane_zn->initShards(num_shards);
+  _td_plane_zp->initShards(num_shards);
+}
+
+auto NFFFTTimeDomain::updateShard(std::size_t shard,
+                                  const IndexTask& task) -> void {
+  _td_plane_xn->update<EMF::Attribute::E>(shard, task);
+  _td_plane_xp->update<EMF::Attribute::E>(shard, task);
+  _td_plane_yn->update<EMF::Attribute::E>(shard, task);
+  _td_plane_yp->update<EMF::Attribute::E>(shard, task);
+  _td_plane_zn->update<EMF::Attribute::E>(shard, task);
+  _td_plane_zp->update<EMF::Attribute::E>(shard, task);
+
+  _td_plane_xn->update<EMF::Attribute::H>(shard, task);
+  _td_plane_xp->update<EMF::Attribute::H>(shard, task);
+  _td_plane_yn->update<EMF::Attribute::H>(shard, task);
+  _td_plane_yp->update<EMF::Attribute::H>(shard, task);
+  _td_plane_zn->update<EMF::Attribute::H>(shard, task);
+  _td_plane_zp->update<EMF::Attribute::H>(shard, task);
+}
+
+auto NFFFTTimeDomain::reduceShards() -> void {
+  _td_plane_xn->reduceShards();
+  _td_plane_xp->reduceShards();
+  _td_plane_yn->reduceShards();
+  _td_plane_yp->reduceShards();
+  _td_plane_zn->reduceShards();
+  _td_plane_zp->reduceShards();
+}
+
+auto NFFFTTimeDomain::saveState(Checkpoint& checkpoint,
+                                const std::string& prefix) const -> void {
+  _td_plane_xn->saveState(checkpoint, prefix + "xn/");
+  _td_plane_xp->saveState(checkpoint, prefix + "xp/");
+  _td_plane_yn->saveState(checkpoint, prefix + "yn/");
+  _td_plane_yp->saveState(checkpoint, prefix + "yp/");
+  _td_plane_zn->saveState(checkpoint, prefix + "zn/");
+  _td_plane_zp->saveState(checkpoint, prefix + "zp/");
+}
+
+auto NFFFTTimeDomain::loadState(const Checkpoint& checkpoint,
+                                const std::string& prefix) -> void {
+  _td_plane_xn->loadState(checkpoint, prefix + "xn/");
+  _td_plane_xp->loadState(checkpoint, prefix + "xp/");
+  _td_plane_yn->loadState(checkpoint, prefix + "yn/");
+  _td_plane_yp->loadState(checkpoint, prefix + "yp/");
+  _td_plane_zn->loadState(checkpoint, prefix + "zn/");
+  _td_plane_zp->loadState(checkpoint, prefix + "zp/");
+}
+
 auto NFFFTTimeDomain::processFarField() const -> void {
   if (!valid()) {
     return;
   }
 
-  auto node_w_theta = wx() * cosTheta() * cosPhi() +
-                      wy() * cosTheta() * sinPhi() - wz() * sinTheta();
-  auto node_w_phi = -wx() * sinPhi() + wy() * cosPhi();
-
-  auto node_u_theta = ux() * cosTheta() * cosPhi() +
-                      uy() * cosTheta() * sinPhi() - uz() * sinTheta();
-  auto node_u_phi = -ux() * sinPhi() + uy() * cosPhi();
-
+  // w_theta, w_phi, u_theta, u_phi of every direction, one after the other
   Array1D<Real> node_data;
-  node_data = xt::concatenate(xt::xtuple(node_data, node_w_theta));
-  node_data = xt::concatenate(xt::xtuple(node_data, node_w_phi));
-  node_data = xt::concatenate(xt::xtuple(node_data, node_u_theta));
-  node_data = xt::concatenate(xt::xtuple(node_data, node_u_phi));
+  auto append = [&node_data](const Array1D<Real>& value) {
+    node_data = xt::concatenate(xt::xtuple(node_data, value));
+  };
+  for (Index d{0}; d < numDirection(); ++d) {
+    append(wx(d) * cosTheta(d) * cosPhi(d) + wy(d) * cosTheta(d) * sinPhi(d) -
+           wz(d) * sinTheta(d));
+  }
+  for (Index d{0}; d < numDirection(); ++d) {
+    append(-wx(d) * sinPhi(d) + wy(d) * cosPhi(d));
+  }
+  for (Index d{0}; d < numDirection(); ++d) {
+    append(ux(d) * cosTheta(d) * cosPhi(d) + uy(d) * cosTheta(d) * sinPhi(d) -
+           uz(d) * sinTheta(d));
+  }
+  for (Index d{0}; d < numDirection(); ++d) {
+    append(-ux(d) * sinPhi(d) + uy(d) * cosPhi(d));
+  }
 
   auto nffft_gather_func = [this](const auto& send_data, auto&& recv_data) {
     if (this->nffftMPIConfig().size() <= 1) {
@@ -136,31 +237,32 @@ auto NFFFTTimeDomain::processFarField() const -> void {
     std::filesystem::create_directories(output_dir);
   }
 
-  auto&& w_theta = xt::view(data, xt::range(0, node_w_theta.size()));
-  auto&& w_phi = xt::view(
-      data,
-      xt::range(node_w_theta.size(), node_w_theta.size() + node_w_phi.size()));
-  auto&& u_theta = xt::view(
-      data,
-      xt::range(node_w_theta.size() + node_w_phi.size(),
-                node_w_theta.size() + node_w_phi.size() + node_u_theta.size()));
-  auto&& u_phi = xt::view(
-      data,
-      xt::range(node_w_theta.size() + node_w_phi.size() + node_u_theta.size(),
-                _));
-
-  xt::dump_npy((std::filesystem::path{output_dir} / "w_theta.npy").string(),
-               w_theta);
-  xt::dump_npy((std::filesystem::path{output_dir} / "w_phi.npy").string(),
-               w_phi);
-  xt::dump_npy((std::filesystem::path{output_dir} / "u_theta.npy").string(),
-               u_theta);
-  xt::dump_npy((std::filesystem::path{output_dir} / "u_phi.npy").string(),
-               u_phi);
+  const auto num_direction = numDirection();
+  const auto num_w = _td_plane_xn->_num_h;
+  const auto num_u = _td_plane_xn->_num_e;
+  auto dump = [&](const std::string& name, std::size_t start,
+                  std::size_t size) {
+    const auto path = (std::filesystem::path{output_dir} / name).string();
+    Array2D<Real> value = xt::zeros<Real>({num_direction, size});
+    std::copy(data.data() + start, data.data() + start + value.size(),
+              value.begin());
+    if (num_direction == 1) {
+      xt::dump_npy(path, xt::view(value, 0, xt::all()));
+      return;
+    }
+
+    xt::dump_npy(path, value);
+  };
+
+  dump("w_theta.npy", 0, num_w);
+  dump("w_phi.npy", num_direction * num_w, num_w);
+  dump("u_theta.npy", 2 * num_direction * num_w, num_u);
+  dump("u_phi.npy", num_direction * (2 * num_w + num_u), num_u);
 }
 
 template <Axis::Direction D, EMF::Attribute A, Axis::XYZ XYZ>
-auto NFFFTTimeDomain::equivalentSurfaceCurrent() const -> const Array1D<Real>& {
+auto NFFFTTimeDomain::equivalentSurfaceCurrent() const
+    -> const Array1D<AccReal>& {
   if constexpr (D == Axis::Direction::XN) {
     if constexpr (A == EMF::Attribute::E) {
       if constexpr (XYZ == Axis::XYZ::Y) {
@@ -412,7 +514,7 @@ auto NFFFTTimeDomain::fieldPrev() const -> const Array2D<Real>& {
 }
 
 template <EMF::Attribute attribute>
-auto NFFFTTimeDomain::distanceRange() const -> Range<Real> {
+auto NFFFTTimeDomain::distanceRange(Index direction) const -> Range<Real> {
   auto distance_range = [this](const auto& observer_direction,
                                const auto& global_task, Axis::XYZ xyz) {
     auto is = global_task.xRange().start();
@@ -459,7 +561,7 @@ auto NFFFTTimeDomain::distanceRange() const -> Range<Real> {
     return Range<Real>{min_dis, max_dis};
   };
 
-  auto observation_direction = observationDirection();
+  auto observation_direction = observationDirection(direction);
 
   auto range_xn = distance_range(observation_direction, globalTaskSurfaceXN(),
                                  Axis::XYZ::X);
@@ -480,121 +582,130 @@ auto NFFFTTimeDomain::distanceRange() const -> Range<Real> {
                     range_yp.end(), range_zn.end(), range_zp.end()})};
 }
 
-auto NFFFTTimeDomain::wx() const -> Array1D<Real> {
-  return _td_plane_zn->wa() + _td_plane_zp->wa() + _td_plane_yn->wb() +
-         _td_plane_yp->wb();
+auto NFFFTTimeDomain::wx(Index d) const -> Array1D<Real> {
+  return _td_plane_zn->wa(d) + _td_plane_zp->wa(d) + _td_plane_yn->wb(d) +
+         _td_plane_yp->wb(d);
 }
 
-auto NFFFTTimeDomain::wy() const -> Array1D<Real> {
-  return _td_plane_xn->wa() + _td_plane_xp->wa() + _td_plane_zn->wb() +
-         _td_plane_zp->wb();
+auto NFFFTTimeDomain::wy(Index d) const -> Array1D<Real> {
+  return _td_plane_xn->wa(d) + _td_plane_xp->wa(d) + _td_plane_zn->wb(d) +
+         _td_plane_zp->wb(d);
 }
 
-auto NFFFTTimeDomain::wz() const -> Array1D<Real> {
-  return _td_plane_xn->wb() + _td_plane_xp->wb() + _td_plane_yn->wa() +
-         _td_plane_yp->wa();
+auto NFFFTTimeDomain::wz(Index d) const -> Array1D<Real> {
+  return _td_plane_xn->wb(d) + _td_plane_xp->wb(d) + _td_plane_yn->wa(d) +
+         _td_plane_yp->wa(d);
 }
 
-auto NFFFTTimeDomain::ux() const -> Array1D<Real> {
-  return _td_plane_zn->ua() + _td_plane_zp->ua() + _td_plane_yn->ub() +
-         _td_plane_yp->ub();
+auto NFFFTTimeDomain::ux(Index d) const -> Array1D<Real> {
+  return _td_plane_zn->ua(d) + _td_plane_zp->ua(d) + _td_plane_yn->ub(d) +
+         _td_plane_yp->ub(d);
 }
 
-auto NFFFTTimeDomain::uy() const -> Array1D<Real> {
-  return _td_plane_xn->ua() + _td_plane_xp->ua() + _td_plane_zn->ub() +
-         _td_plane_zp->ub();
+auto NFFFTTimeDomain::uy(Index d) const -> Array1D<Real> {
+  return _td_plane_xn->ua(d) + _td_plane_xp->ua(d) + _td_plane_zn->ub(d) +
+         _td_plane_zp->ub(d);
 }
 
-auto NFFFTTimeDomain::uz() const -> Array1D<Real> {
-  return _td_plane_xn->ub() + _td_plane_xp->ub() + _td_plane_yn->ua() +
-         _td_plane_yp->ua();
+auto NFFFTTimeDomain::uz(Index d) const -> Array1D<Real> {
+  return _td_plane_xn->ub(d) + _td_plane_xp->ub(d) + _td_plane_yn->ua(d) +
+         _td_plane_yp->ua(d);
 }
 
-auto NFFFTTimeDomain::observationDirection() const -> Vector {
-  return Vector{sinTheta() * cosPhi(), sinTheta() * sinPhi(), cosTheta()};
+auto NFFFTTimeDomain::observationDirection(Index d) const -> Vector {
+  return Vector{sinTheta(d) * cosPhi(d), sinTheta(d) * sinPhi(d),
+                cosTheta(d)};
 }
 
-auto NFFFTTimeDomain::cosTheta() const -> Real { return std::cos(_theta); }
+auto NFFFTTimeDomain::cosTheta(Index d) const -> Real {
+  return std::cos(_theta(d));
+}
 
-auto NFFFTTimeDomain::sinTheta() const -> Real { return std::sin(_theta); }
+auto NFFFTTimeDomain::sinTheta(Index d) const -> Real {
+  return std::sin(_theta(d));
+}
 
-auto NFFFTTimeDomain::cosPhi() const -> Real { return std::cos(_phi); }
+auto NFFFTTimeDomain::cosPhi(Index d) const -> Real {
+  return std::cos(_phi(d));
+}
 
-auto NFFFTTimeDomain::sinPhi() const -> Real { return std::sin(_phi); }
+auto NFFFTTimeDomain::sinPhi(Index d) const -> Real {
+  return std::sin(_phi(d));
+}
 
 // explicit instantiation
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::E, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::E, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::H, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::H, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::E, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::E, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::H, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::H, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::E, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::E, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::H, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::H, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::E, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::E, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::H, Axis::XYZ::Z>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::H, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::E, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::E, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::H, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::H, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::E, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::E, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::H, Axis::XYZ::X>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 template auto NFFFTTimeDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::H, Axis::XYZ::Y>() const
-    -> const Array1D<Real>&;
+    -> const Array1D<AccReal>&;
 
 template auto NFFFTTimeDomain::fieldPrev<Axis::Direction::XN, EMF::Attribute::E,
                                          Axis::XYZ::Y>() const
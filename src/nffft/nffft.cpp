@@ -5,6 +5,7 @@
 #include <xfdtd/nffft/nffft.h>
 #include <xfdtd/parallel/mpi_config.h>
 #include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 #include <xfdtd/util/transform.h>
 
 #include <memory>
@@ -42,6 +43,20 @@ NFFFT::NFFFT(Index distance_x, Index distance_y, Index distance_z,
 
 NFFFT::~NFFFT() = default;
 
+auto NFFFT::shardable() const -> bool { return false; }
+
+auto NFFFT::initShards(std::size_t num_shards) -> void {}
+
+auto NFFFT::updateShard(std::size_t shard, const IndexTask& task) -> void {}
+
+auto NFFFT::reduceShards() -> void { update(); }
+
+auto NFFFT::saveState(Checkpoint& checkpoint,
+                      const std::string& prefix) const -> void {}
+
+auto NFFFT::loadState(const Checkpoint& checkpoint,
+                      const std::string& prefix) -> void {}
+
 auto NFFFT::valid() const -> bool {
   return _node_task_surface_xn.valid() || _node_task_surface_xp.valid() ||
          _node_task_surface_yn.valid() || _node_task_surface_yp.valid() ||
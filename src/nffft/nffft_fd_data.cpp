@@ -38,13 +38,13 @@ FDPlaneData::FDPlaneData(std::shared_ptr<const GridSpace> grid_space,
       throw XFDTDNFFFTException("FDPlaneData: Major axis size != 1");
     }
 
-    ja = xt::zeros<std::complex<Real>>(
+    ja = xt::zeros<std::complex<AccReal>>(
         {task.xRange().size(), task.yRange().size(), task.zRange().size()});
-    jb = xt::zeros<std::complex<Real>>(
+    jb = xt::zeros<std::complex<AccReal>>(
         {task.xRange().size(), task.yRange().size(), task.zRange().size()});
-    ma = xt::zeros<std::complex<Real>>(
+    ma = xt::zeros<std::complex<AccReal>>(
         {task.xRange().size(), task.yRange().size(), task.zRange().size()});
-    mb = xt::zeros<std::complex<Real>>(
+    mb = xt::zeros<std::complex<AccReal>>(
         {task.xRange().size(), task.yRange().size(), task.zRange().size()});
   };
 
@@ -63,16 +63,31 @@ FDPlaneData::FDPlaneData(std::shared_ptr<const GridSpace> grid_space,
 }
 
 auto FDPlaneData::initDFT(std::size_t total_time_step, Real dt) -> void {
-  _transform_e = xt::zeros<std::complex<Real>>({total_time_step});
-  _transform_h = xt::zeros<std::complex<Real>>({total_time_step});
+  _dt = dt;
+  _total_time_step = total_time_step;
+  _dft_rotation = std::exp(std::complex<AccReal>{
+      0, -2 * constant::ACC_PI * _freq * static_cast<AccReal>(dt)});
+  _dft_step = std::numeric_limits<std::size_t>::max();
+}
+
+auto FDPlaneData::transformE() const -> Array1D<std::complex<AccReal>> {
+  Array1D<std::complex<AccReal>> transform =
+      xt::zeros<std::complex<AccReal>>({_total_time_step});
+  for (std::size_t t{0}; t < _total_time_step; ++t) {
+    transform(t) = dftKernel(t + static_cast<AccReal>(1.0));
+  }
 
-  for (std::size_t t{0}; t < total_time_step; ++t) {
-    _transform_e(t) = dt * std::exp(-constant::II * static_cast<Real>(2.0) *
-                                    constant::PI * (_freq * (t + 1) * dt));
-    _transform_h(t) =
-        dt * std::exp(-constant::II * static_cast<Real>(2.0) * constant::PI *
-                      (_freq * (t + static_cast<Real>(0.5)) * dt));
+  return transform;
+}
+
+auto FDPlaneData::transformH() const -> Array1D<std::complex<AccReal>> {
+  Array1D<std::complex<AccReal>> transform =
+      xt::zeros<std::complex<AccReal>>({_total_time_step});
+  for (std::size_t t{0}; t < _total_time_step; ++t) {
+    transform(t) = dftKernel(t + static_cast<AccReal>(0.5));
   }
+
+  return transform;
 }
 
 auto FDPlaneData::frequency() const -> Real { return _freq; }
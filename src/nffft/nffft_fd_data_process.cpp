@@ -36,7 +36,7 @@ auto FDPlaneData::fTheta(const Array1D<Real>& theta, const Array1D<Real>& phi,
 }
 
 auto FDPlaneData::power() const -> Real {
-  std::vector<std::future<std::complex<Real>>> res;
+  std::vector<std::future<std::complex<AccReal>>> res;
   res.emplace_back(
       std::async(&FDPlaneData::calculatePower<Axis::Direction::XN>, this));
   res.emplace_back(
@@ -50,9 +50,10 @@ auto FDPlaneData::power() const -> Real {
   res.emplace_back(
       std::async(&FDPlaneData::calculatePower<Axis::Direction::ZP>, this));
 
-  return 0.5 * std::real(std::accumulate(
-                   res.begin(), res.end(), std::complex<Real>{0.0},
-                   [](const auto& a, auto&& b) { return a + b.get(); }));
+  return static_cast<Real>(
+      0.5 * std::real(std::accumulate(
+                res.begin(), res.end(), std::complex<AccReal>{0.0},
+                [](const auto& a, auto&& b) { return a + b.get(); })));
 }
 
 template <FDPlaneData::Potential p, transform::SCS scs>
@@ -143,9 +144,9 @@ auto FDPlaneData::calculatePotential(
         auto&& phase_shift = xt::exp(
             constant::II * wave_number *
             (r.x() * sin_t_cos_p + r.y() * sin_t_sin_p + r.z() * cos_t));
-        data += (a(i - is, j - js, k - ks) * transform_a +
-                 +b(i - is, j - js, k - ks) * transform_b) *
-                phase_shift * ds;
+        const auto a_ijk = std::complex<Real>{a(i - is, j - js, k - ks)};
+        const auto b_ijk = std::complex<Real>{b(i - is, j - js, k - ks)};
+        data += (a_ijk * transform_a + b_ijk * transform_b) * phase_shift * ds;
       }
     }
   }
@@ -154,7 +155,7 @@ auto FDPlaneData::calculatePotential(
 }
 
 template <Axis::Direction direction>
-auto FDPlaneData::calculatePower() const -> std::complex<Real> {
+auto FDPlaneData::calculatePower() const -> std::complex<AccReal> {
   const auto& task = this->task<direction>();
   if (!task.valid()) {
     return 0.0;
@@ -167,7 +168,7 @@ auto FDPlaneData::calculatePower() const -> std::complex<Real> {
   const auto je = task.yRange().end();
   const auto ke = task.zRange().end();
 
-  auto power = std::complex<Real>{0.0};
+  auto power = std::complex<AccReal>{0.0};
 
   auto [ja, jb] = surfaceJ<direction>();
   auto [ma, mb] = surfaceM<direction>();
@@ -176,8 +177,8 @@ auto FDPlaneData::calculatePower() const -> std::complex<Real> {
   for (auto i{is}; i < ie; ++i) {
     for (auto j{js}; j < je; ++j) {
       for (auto k{ks}; k < ke; ++k) {
-        const auto& ds =
-            this->ds<Axis::fromDirectionToXYZ<direction>()>(i, j, k);
+        const auto ds = static_cast<AccReal>(
+            this->ds<Axis::fromDirectionToXYZ<direction>()>(i, j, k));
         power += ds * (std::conj(ja(i - is, j - js, k - ks)) *
                            mb(i - is, j - js, k - ks) -
                        std::conj(jb(i - is, j - js, k - ks)) *
@@ -186,7 +187,8 @@ auto FDPlaneData::calculatePower() const -> std::complex<Real> {
     }
   }
 
-  constexpr Real negative = Axis::directionNegative<direction>() ? -1.0 : 1.0;
+  constexpr AccReal negative =
+      Axis::directionNegative<direction>() ? -1.0 : 1.0;
   return negative * power;
 }
 
@@ -1,122 +1,221 @@
+#include <xfdtd/common/constant.h>
+#include <xfdtd/simulation/checkpoint.h>
+
+#include <cmath>
+
 #include "nffft/interpolate_scheme.h"
 #include "nffft/nffft_fd_data.h"
 
 namespace xfdtd {
 
-auto FDPlaneData::update(std::size_t current_time_step) -> void {
-  calculateJ<Axis::Direction::XN>(current_time_step);
-  calculateJ<Axis::Direction::XP>(current_time_step);
-  calculateJ<Axis::Direction::YN>(current_time_step);
-  calculateJ<Axis::Direction::YP>(current_time_step);
-  calculateJ<Axis::Direction::ZN>(current_time_step);
-  calculateJ<Axis::Direction::ZP>(current_time_step);
-
-  calculateM<Axis::Direction::XN>(current_time_step);
-  calculateM<Axis::Direction::XP>(current_time_step);
-  calculateM<Axis::Direction::YN>(current_time_step);
-  calculateM<Axis::Direction::YP>(current_time_step);
-  calculateM<Axis::Direction::ZN>(current_time_step);
-  calculateM<Axis::Direction::ZP>(current_time_step);
+auto FDPlaneData::sample(const IndexTask& range,
+                         FDSurfaceSample& sample) const -> void {
+  sampleFace<Axis::Direction::XN>(range, sample);
+  sampleFace<Axis::Direction::XP>(range, sample);
+  sampleFace<Axis::Direction::YN>(range, sample);
+  sampleFace<Axis::Direction::YP>(range, sample);
+  sampleFace<Axis::Direction::ZN>(range, sample);
+  sampleFace<Axis::Direction::ZP>(range, sample);
+}
+
+auto FDPlaneData::accumulate(const FDSurfaceSample& sample) -> void {
+  accumulateFace<Axis::Direction::XN>(sample);
+  accumulateFace<Axis::Direction::XP>(sample);
+  accumulateFace<Axis::Direction::YN>(sample);
+  accumulateFace<Axis::Direction::YP>(sample);
+  accumulateFace<Axis::Direction::ZN>(sample);
+  accumulateFace<Axis::Direction::ZP>(sample);
+}
+
+auto FDPlaneData::seekDFT(std::size_t time_step) -> void {
+  if (time_step == _dft_step) {
+    return;
+  }
+
+  if (time_step == _dft_step + 1 && time_step % DFT_RESYNC_INTERVAL != 0) {
+    _dft_e *= _dft_rotation;
+    _dft_h *= _dft_rotation;
+    _dft_step = time_step;
+    return;
+  }
+
+  _dft_e = dftKernel(time_step + static_cast<AccReal>(1.0));
+  _dft_h = dftKernel(time_step + static_cast<AccReal>(0.5));
+  _dft_step = time_step;
+}
+
+// Calls f(name, array) for every surface current of `data`.
+template <typename D, typename F>
+static auto forEachSurfaceCurrent(D& data, F&& f) -> void {
+  f("jx_yn", data._jx_yn);
+  f("jx_yp", data._jx_yp);
+  f("jx_zn", data._jx_zn);
+  f("jx_zp", data._jx_zp);
+  f("jy_xn", data._jy_xn);
+  f("jy_xp", data._jy_xp);
+  f("jy_zn", data._jy_zn);
+  f("jy_zp", data._jy_zp);
+  f("jz_xn", data._jz_xn);
+  f("jz_xp", data._jz_xp);
+  f("jz_yn", data._jz_yn);
+  f("jz_yp", data._jz_yp);
+  f("mx_yn", data._mx_yn);
+  f("mx_yp", data._mx_yp);
+  f("mx_zn", data._mx_zn);
+  f("mx_zp", data._mx_zp);
+  f("my_xn", data._my_xn);
+  f("my_xp", data._my_xp);
+  f("my_zn", data._my_zn);
+  f("my_zp", data._my_zp);
+  f("mz_xn", data._mz_xn);
+  f("mz_xp", data._mz_xp);
+  f("mz_yn", data._mz_yn);
+  f("mz_yp", data._mz_yp);
+}
+
+auto FDPlaneData::saveState(Checkpoint& checkpoint,
+                            const std::string& prefix) const -> void {
+  forEachSurfaceCurrent(*this, [&](const char* name, const auto& arr) {
+    checkpoint.save(prefix + name, arr);
+  });
+
+  checkpoint.saveValue<Index>(prefix + "dft_step", _dft_step);
+  checkpoint.save(prefix + "dft_kernel",
+                  std::vector<std::complex<AccReal>>{_dft_e, _dft_h});
+}
+
+auto FDPlaneData::loadState(const Checkpoint& checkpoint,
+                            const std::string& prefix) -> void {
+  forEachSurfaceCurrent(*this, [&](const char* name, auto& arr) {
+    checkpoint.load(prefix + name, arr);
+  });
+
+  _dft_step = checkpoint.loadValue<Index>(prefix + "dft_step");
+  auto kernel = std::vector<std::complex<AccReal>>(2);
+  checkpoint.load(prefix + "dft_kernel", kernel);
+  _dft_e = kernel[0];
+  _dft_h = kernel[1];
+}
+
+auto FDPlaneData::dftKernel(AccReal t) const -> std::complex<AccReal> {
+  const auto dt = static_cast<AccReal>(_dt);
+  return dt * std::exp(std::complex<AccReal>{
+                  0, -2 * constant::ACC_PI * _freq * t * dt});
 }
 
 template <Axis::Direction direction>
-auto FDPlaneData::calculateM(std::size_t current_time_step) -> void {
+auto FDPlaneData::sampleFace(const IndexTask& range,
+                             FDSurfaceSample& sample) const -> void {
+  constexpr auto face = static_cast<std::size_t>(direction);
+  auto& sub = sample._range[face];
+  auto& ja = sample._ja[face];
+  auto& jb = sample._jb[face];
+  auto& ma = sample._ma[face];
+  auto& mb = sample._mb[face];
+
+  sub = {};
   const auto task = this->task<direction>();
-
   if (!task.valid()) {
     return;
   }
 
-  Real coff_ma = (Axis::directionPositive<direction>()) ? 1.0 : -1.0;
-  Real coff_mb = (Axis::directionPositive<direction>()) ? -1.0 : 1.0;
+  const auto r = taskIntersection(task, range);
+  if (!r.has_value()) {
+    return;
+  }
 
-  const auto is = task.xRange().start();
-  const auto js = task.yRange().start();
-  const auto ks = task.zRange().start();
-  const auto ie = task.xRange().end();
-  const auto je = task.yRange().end();
-  const auto ke = task.zRange().end();
+  sub = *r;
+  const auto n =
+      sub.xRange().size() * sub.yRange().size() * sub.zRange().size();
+  ja.resize(n);
+  jb.resize(n);
+  ma.resize(n);
+  mb.resize(n);
 
-  auto [ma, mb] = surfaceM<direction>();
+  constexpr Real coff_ja = (Axis::directionPositive<direction>()) ? -1.0 : 1.0;
+  constexpr Real coff_jb = (Axis::directionPositive<direction>()) ? 1.0 : -1.0;
+  constexpr Real coff_ma = (Axis::directionPositive<direction>()) ? 1.0 : -1.0;
+  constexpr Real coff_mb = (Axis::directionPositive<direction>()) ? -1.0 : 1.0;
 
   constexpr auto xyz = Axis::fromDirectionToXYZ<direction>();
   constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
   constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
 
-  constexpr auto attribute = EMF::Attribute::E;
-  constexpr auto filed_a =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_a));
-  constexpr auto filed_b =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_b));
+  constexpr auto h_a = EMF::attributeComponentToField(
+      EMF::Attribute::H, EMF::xYZToComponent(xyz_a));
+  constexpr auto h_b = EMF::attributeComponentToField(
+      EMF::Attribute::H, EMF::xYZToComponent(xyz_b));
+  constexpr auto e_a = EMF::attributeComponentToField(
+      EMF::Attribute::E, EMF::xYZToComponent(xyz_a));
+  constexpr auto e_b = EMF::attributeComponentToField(
+      EMF::Attribute::E, EMF::xYZToComponent(xyz_b));
 
   const auto emf = _emf.get();
-
-  const auto& ea = emf->field<filed_a>();
-  const auto& eb = emf->field<filed_b>();
-
-  for (auto i{is}; i < ie; ++i) {
-    for (auto j{js}; j < je; ++j) {
-      for (auto k{ks}; k < ke; ++k) {
-        ma(i - is, j - js, k - ks) +=
-            coff_ma *
-            interpolate::interpolateSurfaceCenter<xyz, filed_b>(eb, i, j, k) *
-            _transform_e(current_time_step);
-        mb(i - is, j - js, k - ks) +=
-            coff_mb *
-            interpolate::interpolateSurfaceCenter<xyz, filed_a>(ea, i, j, k) *
-            _transform_e(current_time_step);
+  const auto& ha = emf->field<h_a>();
+  const auto& hb = emf->field<h_b>();
+  const auto& ea = emf->field<e_a>();
+  const auto& eb = emf->field<e_b>();
+
+  std::size_t c{0};
+  for (auto i{sub.xRange().start()}; i < sub.xRange().end(); ++i) {
+    for (auto j{sub.yRange().start()}; j < sub.yRange().end(); ++j) {
+      for (auto k{sub.zRange().start()}; k < sub.zRange().end(); ++k) {
+        ja[c] = coff_ja *
+                interpolate::interpolateSurfaceCenter<xyz, h_b>(hb, i, j, k);
+        jb[c] = coff_jb *
+                interpolate::interpolateSurfaceCenter<xyz, h_a>(ha, i, j, k);
+        ma[c] = coff_ma *
+                interpolate::interpolateSurfaceCenter<xyz, e_b>(eb, i, j, k);
+        mb[c] = coff_mb *
+                interpolate::interpolateSurfaceCenter<xyz, e_a>(ea, i, j, k);
+        ++c;
       }
     }
   }
 }
 
 template <Axis::Direction direction>
-auto FDPlaneData::calculateJ(std::size_t current_time_step) -> void {
-  const auto task = this->task<direction>();
-
-  if (!task.valid()) {
+auto FDPlaneData::accumulateFace(const FDSurfaceSample& sample) -> void {
+  constexpr auto face = static_cast<std::size_t>(direction);
+  const auto& sub = sample._range[face];
+  if (!sub.valid()) {
     return;
   }
 
-  constexpr Real coff_ja = (Axis::directionPositive<direction>()) ? -1.0 : 1.0;
-  constexpr Real coff_jb = (Axis::directionPositive<direction>()) ? 1.0 : -1.0;
-
+  const auto task = this->task<direction>();
   const auto is = task.xRange().start();
   const auto js = task.yRange().start();
   const auto ks = task.zRange().start();
-  const auto ie = task.xRange().end();
-  const auto je = task.yRange().end();
-  const auto ke = task.zRange().end();
+  const auto nk = sub.zRange().size();
 
   auto [ja, jb] = surfaceJ<direction>();
+  auto [ma, mb] = surfaceM<direction>();
 
-  constexpr auto xyz = Axis::fromDirectionToXYZ<direction>();
-  constexpr auto xyz_a = Axis::tangentialAAxis<xyz>();
-  constexpr auto xyz_b = Axis::tangentialBAxis<xyz>();
-
-  constexpr auto attribute = EMF::Attribute::H;
-  constexpr auto filed_a =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_a));
-  constexpr auto filed_b =
-      EMF::attributeComponentToField(attribute, EMF::xYZToComponent(xyz_b));
-
-  const auto emf = _emf.get();
-
-  const auto& ha = emf->field<filed_a>();
-  const auto& hb = emf->field<filed_b>();
-
-  for (auto i{is}; i < ie; ++i) {
-    for (auto j{js}; j < je; ++j) {
-      for (auto k{ks}; k < ke; ++k) {
-        ja(i - is, j - js, k - ks) +=
-            coff_ja *
-            interpolate::interpolateSurfaceCenter<xyz, filed_b>(hb, i, j, k) *
-            _transform_h(current_time_step);
-        jb(i - is, j - js, k - ks) +=
-            coff_jb *
-            interpolate::interpolateSurfaceCenter<xyz, filed_a>(ha, i, j, k) *
-            _transform_h(current_time_step);
+  const auto* sja = sample._ja[face].data();
+  const auto* sjb = sample._jb[face].data();
+  const auto* sma = sample._ma[face].data();
+  const auto* smb = sample._mb[face].data();
+  const auto dft_e = _dft_e;
+  const auto dft_h = _dft_h;
+
+  for (auto i{sub.xRange().start()}; i < sub.xRange().end(); ++i) {
+    for (auto j{sub.yRange().start()}; j < sub.yRange().end(); ++j) {
+      const auto k0 = sub.zRange().start() - ks;
+      auto* row_ja = &ja(i - is, j - js, k0);
+      auto* row_jb = &jb(i - is, j - js, k0);
+      auto* row_ma = &ma(i - is, j - js, k0);
+      auto* row_mb = &mb(i - is, j - js, k0);
+      for (std::size_t k{0}; k < nk; ++k) {
+        row_ja[k] += dft_h * static_cast<AccReal>(sja[k]);
+        row_jb[k] += dft_h * static_cast<AccReal>(sjb[k]);
+        row_ma[k] += dft_e * static_cast<AccReal>(sma[k]);
+        row_mb[k] += dft_e * static_cast<AccReal>(smb[k]);
       }
+
+      sja += nk;
+      sjb += nk;
+      sma += nk;
+      smb += nk;
     }
   }
 }
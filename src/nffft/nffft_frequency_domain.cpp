@@ -1,11 +1,15 @@
 #include <xfdtd/nffft/nffft_frequency_domain.h>
 #include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/simulation/checkpoint.h>
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <iomanip>
 #include <xtensor.hpp>
 #include <xtensor/xnpy.hpp>
 
+#include "nffft/far_field_engine.h"
 #include "nffft/nffft_fd_data.h"
 
 namespace xfdtd {
@@ -37,18 +41,75 @@ void NFFFTFrequencyDomain::initTimeDependentVariable() {
   const auto total_time_step{calculationParam()->timeParam()->endTimeStep() -
                              calculationParam()->timeParam()->startTimeStep()};
   const auto dt{calculationParam()->timeParam()->dt()};
+  const auto start{calculationParam()->timeParam()->startTimeStep()};
   for (auto&& fd_data : _fd_plane_data) {
     fd_data.initDFT(total_time_step, dt);
+    fd_data.seekDFT(start);
   }
 }
 
 auto NFFFTFrequencyDomain::update() -> void {
+  if (_fd_plane_data.empty()) {
+    return;
+  }
+
   auto current_time_step = calculationParam()->timeParam()->currentTimeStep();
+  if (_surface_samples.empty()) {
+    _surface_samples.resize(1);
+  }
 
-  for (auto f{0}; f < _frequencies.size(); ++f) {
-    for (auto&& fd_data : _fd_plane_data) {
-      fd_data.update(current_time_step);
-    }
+  // Interpolate once, then let every frequency add the same samples.
+  auto& sample = _surface_samples.front();
+  const auto node = makeIndexTask(makeIndexRange(0, gridSpace()->sizeX() + 1),
+                                  makeIndexRange(0, gridSpace()->sizeY() + 1),
+                                  makeIndexRange(0, gridSpace()->sizeZ() + 1));
+  _fd_plane_data.front().sample(node, sample);
+  for (auto&& fd_data : _fd_plane_data) {
+    fd_data.seekDFT(current_time_step);
+    fd_data.accumulate(sample);
+    fd_data.seekDFT(current_time_step + 1);
+  }
+}
+
+auto NFFFTFrequencyDomain::initShards(std::size_t num_shards) -> void {
+  _surface_samples.clear();
+  _surface_samples.resize(num_shards);
+}
+
+auto NFFFTFrequencyDomain::updateShard(std::size_t shard,
+                                       const IndexTask& task) -> void {
+  if (_fd_plane_data.empty()) {
+    return;
+  }
+
+  // The kernels were moved to this step by the last reduceShards()
+  auto& sample = _surface_samples[shard];
+  _fd_plane_data.front().sample(task, sample);
+  for (auto&& fd_data : _fd_plane_data) {
+    fd_data.accumulate(sample);
+  }
+}
+
+auto NFFFTFrequencyDomain::reduceShards() -> void {
+  auto current_time_step = calculationParam()->timeParam()->currentTimeStep();
+  for (auto&& fd_data : _fd_plane_data) {
+    fd_data.seekDFT(current_time_step + 1);
+  }
+}
+
+auto NFFFTFrequencyDomain::saveState(Checkpoint& checkpoint,
+                                     const std::string& prefix) const -> void {
+  for (std::size_t i{0}; i < _fd_plane_data.size(); ++i) {
+    _fd_plane_data[i].saveState(checkpoint,
+                                prefix + "freq_" + std::to_string(i) + "/");
+  }
+}
+
+auto NFFFTFrequencyDomain::loadState(const Checkpoint& checkpoint,
+                                     const std::string& prefix) -> void {
+  for (std::size_t i{0}; i < _fd_plane_data.size(); ++i) {
+    _fd_plane_data[i].loadState(checkpoint,
+                                prefix + "freq_" + std::to_string(i) + "/");
   }
 }
 
@@ -185,6 +246,61 @@ auto NFFFTFrequencyDomain::processFarField(const Array1D<Real>& theta,
   }
 }
 
+auto NFFFTFrequencyDomain::processFarFieldPattern(
+    const Array1D<Real>& theta, const Array1D<Real>& phi,
+    const std::string& sub_dir, const Vector& origin,
+    std::size_t num_thread) const -> void {
+  if (!valid()) {
+    return;
+  }
+
+  const auto num_angle = theta.size() * phi.size();
+  if (num_angle == 0) {
+    throw XFDTDNFFFTFrequencyDomainException(
+        "processFarFieldPattern: theta and phi must not be empty");
+  }
+
+  const auto engine = FarFieldEngine{_fd_plane_data, origin};
+  const auto node_data = engine.evaluate(theta, phi, num_thread);
+
+  // One reduction per frequency keeps the count of a large pattern in an int
+  const auto block = FarFieldEngine::NUM_POTENTIAL * num_angle;
+  auto data = node_data;
+  if (nffftMPIConfig().size() > 1) {
+    for (std::size_t i{0}; i < _fd_plane_data.size(); ++i) {
+      MpiSupport::instance().reduceSum(
+          nffftMPIConfig(), node_data.data() + i * block,
+          data.data() + i * block, static_cast<int>(block));
+    }
+  }
+
+  if (!nffftMPIConfig().isRoot()) {
+    return;
+  }
+
+  const auto dir = std::filesystem::path{outputDir()} / sub_dir;
+  if (!std::filesystem::exists(dir)) {
+    std::filesystem::create_directories(dir);
+  }
+
+  constexpr std::array<const char*, FarFieldEngine::NUM_POTENTIAL> names{
+      "_a_theta.npy", "_f_phi.npy", "_a_phi.npy", "_f_theta.npy"};
+  for (std::size_t i{0}; i < _fd_plane_data.size(); ++i) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << _fd_plane_data[i].frequency() / 1e9 << "GHz";
+    const auto prefix_file_name = ss.str();
+
+    for (std::size_t p{0}; p < names.size(); ++p) {
+      const auto* begin = data.data() + i * block + p * num_angle;
+      Array2D<std::complex<Real>> pattern =
+          xt::zeros<std::complex<Real>>({theta.size(), phi.size()});
+      std::copy(begin, begin + num_angle, pattern.begin());
+      xt::dump_npy((dir / (prefix_file_name + names[p])).string(), pattern);
+    }
+  }
+}
+
 auto NFFFTFrequencyDomain::generateSurface() -> void {
   if (!valid()) {
     return;
@@ -200,7 +316,7 @@ auto NFFFTFrequencyDomain::generateSurface() -> void {
 
 template <Axis::Direction D, EMF::Attribute A, Axis::XYZ XYZ>
 auto NFFFTFrequencyDomain::equivalentSurfaceCurrent(Index freq_index) const
-    -> const Array3D<std::complex<Real>>& {
+    -> const Array3D<std::complex<AccReal>>& {
   const auto& fd_data = _fd_plane_data.at(freq_index);
   if constexpr (D == Axis::Direction::XN && A == EMF::Attribute::E &&
                 XYZ == Axis::XYZ::Y) {
@@ -281,87 +397,87 @@ auto NFFFTFrequencyDomain::equivalentSurfaceCurrent(Index freq_index) const
 }
 
 auto NFFFTFrequencyDomain::transformE(Index freq_index) const
-    -> const Array1D<std::complex<Real>>& {
-  return _fd_plane_data.at(freq_index)._transform_e;
+    -> Array1D<std::complex<AccReal>> {
+  return _fd_plane_data.at(freq_index).transformE();
 }
 
 auto NFFFTFrequencyDomain::transformH(Index freq_index) const
-    -> const Array1D<std::complex<Real>>& {
-  return _fd_plane_data.at(freq_index)._transform_h;
+    -> Array1D<std::complex<AccReal>> {
+  return _fd_plane_data.at(freq_index).transformH();
 }
 
 // explicit instantiation
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::E, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::E, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::E, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::E, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::E, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::E, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::E, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::E, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::E, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::E, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::E, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::E, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::H, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XN, EMF::Attribute::H, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::H, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::XP, EMF::Attribute::H, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::H, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YN, EMF::Attribute::H, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::H, Axis::XYZ::Z>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::YP, EMF::Attribute::H, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::H, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZN, EMF::Attribute::H, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::H, Axis::XYZ::X>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 template auto NFFFTFrequencyDomain::equivalentSurfaceCurrent<
     Axis::Direction::ZP, EMF::Attribute::H, Axis::XYZ::Y>(
-    Index freq_index) const -> const Array3D<std::complex<Real>>&;
+    Index freq_index) const -> const Array3D<std::complex<AccReal>>&;
 
 }  // namespace xfdtd
\ No newline at end of file
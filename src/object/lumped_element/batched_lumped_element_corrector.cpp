@@ -0,0 +1,135 @@
+#include "object/batched_lumped_element_corrector.h"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+namespace xfdtd {
+
+namespace {
+
+// Call func(global i, j, k, local i, j, k) for every node of the task
+template <typename F>
+auto forEachNode(const IndexTask& task, const IndexTask& local_task,
+                 F&& func) -> void {
+  const auto is = task.xRange().start();
+  const auto js = task.yRange().start();
+  const auto ks = task.zRange().start();
+  const auto local_is = local_task.xRange().start();
+  const auto local_js = local_task.yRange().start();
+  const auto local_ks = local_task.zRange().start();
+
+  for (Index i{0}; i < task.xRange().size(); ++i) {
+    for (Index j{0}; j < task.yRange().size(); ++j) {
+      for (Index k{0}; k < task.zRange().size(); ++k) {
+        func(i + is, j + js, k + ks, i + local_is, j + local_js,
+             k + local_ks);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+BatchedLumpedElementCorrector::BatchedLumpedElementCorrector(
+    std::shared_ptr<CalculationParam> calculation_param)
+    : _calculation_param{std::move(calculation_param)} {}
+
+auto BatchedLumpedElementCorrector::addSource(const IndexTask& task,
+                                              const IndexTask& local_task,
+                                              Array3D<Real>& e_field,
+                                              const Array3D<Real>& coeff,
+                                              const Array1D<Real>& waveform)
+    -> void {
+  const auto w = waveformIndex(waveform);
+  const auto f = fieldIndex(e_field);
+  _regions.emplace_back(task);
+  forEachNode(task, local_task,
+              [&](Index i, Index j, Index k, Index li, Index lj, Index lk) {
+                _source_field.emplace_back(f);
+                _source_offset.emplace_back(
+                    static_cast<std::size_t>(&e_field(i, j, k) -
+                                             e_field.data()));
+                _source_coeff.emplace_back(coeff(li, lj, lk));
+                _source_waveform.emplace_back(w);
+              });
+}
+
+auto BatchedLumpedElementCorrector::addInductor(
+    const IndexTask& task, const IndexTask& local_task, Array3D<Real>& e_field,
+    Array3D<Real>& j, const Array3D<Real>& cecjc, const Array3D<Real>& cjcec)
+    -> void {
+  const auto f = fieldIndex(e_field);
+  _regions.emplace_back(task);
+  forEachNode(task, local_task,
+              [&](Index i, Index jj, Index k, Index li, Index lj, Index lk) {
+                _inductor_field.emplace_back(f);
+                _inductor_offset.emplace_back(
+                    static_cast<std::size_t>(&e_field(i, jj, k) -
+                                             e_field.data()));
+                _inductor_j.emplace_back(&j(li, lj, lk));
+                _inductor_cecjc.emplace_back(cecjc(li, lj, lk));
+                _inductor_cjcec.emplace_back(cjcec(li, lj, lk));
+              });
+}
+
+auto BatchedLumpedElementCorrector::correctE() -> void {
+  const auto t = _calculation_param->timeParam()->currentTimeStep();
+  for (std::size_t w{0}; w < _waveforms.size(); ++w) {
+    _waveform_values[w] = (*_waveforms[w])(t);
+  }
+
+  // The fields may be reallocated after the cells were added (first touch
+  // does), so only their offsets are kept.
+  for (std::size_t f{0}; f < _fields.size(); ++f) {
+    _field_data[f] = _fields[f]->data();
+  }
+
+  const auto num_sources = _source_offset.size();
+  for (std::size_t n{0}; n < num_sources; ++n) {
+    _field_data[_source_field[n]][_source_offset[n]] +=
+        _source_coeff[n] * _waveform_values[_source_waveform[n]];
+  }
+
+  const auto num_inductors = _inductor_offset.size();
+  for (std::size_t n{0}; n < num_inductors; ++n) {
+    auto& e = _field_data[_inductor_field[n]][_inductor_offset[n]];
+    auto& j = *_inductor_j[n];
+    e += _inductor_cecjc[n] * j;
+    j += _inductor_cjcec[n] * e;
+  }
+}
+
+auto BatchedLumpedElementCorrector::toString() const -> std::string {
+  std::stringstream ss;
+  ss << "BatchedLumpedElementCorrector: " << _source_offset.size()
+     << " source cells, " << _inductor_offset.size() << " inductor cells, "
+     << _waveforms.size() << " waveforms";
+  return ss.str();
+}
+
+auto BatchedLumpedElementCorrector::waveformIndex(const Array1D<Real>& waveform)
+    -> std::uint32_t {
+  auto it = std::find(_waveforms.begin(), _waveforms.end(), &waveform);
+  if (it != _waveforms.end()) {
+    return static_cast<std::uint32_t>(it - _waveforms.begin());
+  }
+
+  _waveforms.emplace_back(&waveform);
+  _waveform_values.emplace_back(0);
+  return static_cast<std::uint32_t>(_waveforms.size() - 1);
+}
+
+auto BatchedLumpedElementCorrector::fieldIndex(Array3D<Real>& field)
+    -> std::uint8_t {
+  auto it = std::find(_fields.begin(), _fields.end(), &field);
+  if (it != _fields.end()) {
+    return static_cast<std::uint8_t>(it - _fields.begin());
+  }
+
+  _fields.emplace_back(&field);
+  _field_data.emplace_back(nullptr);
+  return static_cast<std::uint8_t>(_fields.size() - 1);
+}
+
+}  // namespace xfdtd
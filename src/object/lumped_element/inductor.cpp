@@ -1,4 +1,5 @@
 #include <xfdtd/object/lumped_element/inductor.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <memory>
 #include <xtensor.hpp>
@@ -134,4 +135,14 @@ std::unique_ptr<Corrector> Inductor::generateCorrector(
       fieldMainAxis(EMF::Attribute::E), _j, _cecjc, _cjcec);
 }
 
+auto Inductor::saveState(Checkpoint& checkpoint,
+                         const std::string& prefix) const -> void {
+  checkpoint.save(prefix + "j", _j);
+}
+
+auto Inductor::loadState(const Checkpoint& checkpoint,
+                         const std::string& prefix) -> void {
+  checkpoint.load(prefix + "j", _j);
+}
+
 }  // namespace xfdtd
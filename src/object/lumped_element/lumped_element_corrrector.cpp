@@ -3,6 +3,8 @@
 
 #include "object/lumped_element_corrector.h"
 
+#include "object/batched_lumped_element_corrector.h"
+
 namespace xfdtd {
 
 void VoltageSourceCorrector::correctE() {
@@ -22,6 +24,11 @@ void VoltageSourceCorrector::correctE() {
 
 void VoltageSourceCorrector::correctH() {}
 
+auto VoltageSourceCorrector::batch(BatchedLumpedElementCorrector& batch)
+    -> void {
+  batch.addSource(_task, _local_task, _e_field, _coeff_v, _waveform);
+}
+
 void CurrentSourceCorrector::correctE() {
   auto&& coeff_view = xt::view(
       _coeff_i,
@@ -39,6 +46,11 @@ void CurrentSourceCorrector::correctE() {
 
 void CurrentSourceCorrector::correctH() {}
 
+auto CurrentSourceCorrector::batch(BatchedLumpedElementCorrector& batch)
+    -> void {
+  batch.addSource(_task, _local_task, _e_field, _coeff_i, _waveform);
+}
+
 void InductorCorrector::correctE() {
   //   auto&& coeff_ecj = xt::view(
   //       _cecjc, xt::range(_local_task.xRange().start(),
@@ -100,4 +112,8 @@ void InductorCorrector::correctE() {
 
 void InductorCorrector::correctH() {}
 
+auto InductorCorrector::batch(BatchedLumpedElementCorrector& batch) -> void {
+  batch.addInductor(_task, _local_task, _e_field, _j, _cecjc, _cjcec);
+}
+
 }  // namespace xfdtd
@@ -4,6 +4,7 @@
 #include <xfdtd/material/dispersive_material.h>
 #include <xfdtd/object/object.h>
 #include <xfdtd/shape/shape.h>
+#include <xfdtd/simulation/checkpoint.h>
 
 #include <algorithm>
 #include <cstdlib>
@@ -14,6 +15,7 @@
 #include <utility>
 
 #include "corrector/corrector.h"
+#include "object/voxelizer.h"
 
 namespace xfdtd {
 
@@ -41,6 +43,8 @@ void Object::init(std::shared_ptr<const GridSpace> grid_space,
       _grid_space->getGridBoxWithoutCheck(_shape.get()));
   _global_grid_box =
       _grid_space->globalGridSpace()->getGridBoxWithoutCheck(shape().get());
+  _voxel_rows.clear();
+  _voxelized = false;
 }
 
 void Object::correctMaterialSpace(Index index) {
@@ -56,44 +60,30 @@ void Object::handleDispersion(
     return;
   }
 
-  auto nx = _grid_space->sizeX();
-  auto ny = _grid_space->sizeY();
-  auto nz = _grid_space->sizeZ();
-
   auto linear_dispersive_material =
       dynamic_cast<LinearDispersiveMaterial*>(_material.get());
+  const auto& grid_with_material = _grid_space->gridWithMaterial();
+  // Only the cells of the shape that no later object took over
+  auto correct = [linear_dispersive_material, &grid_with_material,
+                  &ade_method_storage, this](const VoxelRow& row) {
+    for (auto k = row._k_start; k < row._k_end; ++k) {
+      if (grid_with_material(row._i, row._j, k).materialIndex() !=
+          materialIndex()) {
+        continue;
+      }
+
+      ade_method_storage->correctCoeff(row._i, row._j, k,
+                                       *linear_dispersive_material,
+                                       _grid_space, _calculation_param);
+    }
+  };
+
+  const auto& rows = voxelRows();
   // if par_unseq is implemented, use it
 #ifdef XFDTD_CORE_PSTL_ENABLE
-  std::for_each(std::execution::par_unseq,
-                _grid_space->gridWithMaterial().begin(),
-                _grid_space->gridWithMaterial().end(),
-                [linear_dispersive_material, nx, ny, nz, ade_method_storage,
-                 grid_space = _grid_space,
-                 calculation_param = _calculation_param, this](auto&& grid) {
-                  auto material_index = grid.materialIndex();
-                  if (material_index != materialIndex()) {
-                    return;
-                  }
-
-                  ade_method_storage->correctCoeff(
-                      grid.i(), grid.j(), grid.k(), *linear_dispersive_material,
-                      grid_space, calculation_param);
-                });
+  std::for_each(std::execution::par_unseq, rows.begin(), rows.end(), correct);
 #else
-  std::for_each(_grid_space->gridWithMaterial().begin(),
-                _grid_space->gridWithMaterial().end(),
-                [linear_dispersive_material, nx, ny, nz, ade_method_storage,
-                 grid_space = _grid_space,
-                 calculation_param = _calculation_param, this](auto&& grid) {
-                  auto material_index = grid.materialIndex();
-                  if (material_index != materialIndex()) {
-                    return;
-                  }
-
-                  ade_method_storage->correctCoeff(
-                      grid.i(), grid.j(), grid.k(), *linear_dispersive_material,
-                      grid_space, calculation_param);
-                });
+  std::for_each(rows.begin(), rows.end(), correct);
 #endif
 }
 
@@ -131,80 +121,73 @@ void Object::defaultCorrectMaterialSpace(Index index) {
   auto& sigma_m_y{_calculation_param->materialParam()->sigmaMY()};
   auto& sigma_m_z{_calculation_param->materialParam()->sigmaMZ()};
 
-  // // remove const
+  // remove const
   auto g_variety = std::const_pointer_cast<GridSpace>(_grid_space);
-
-  auto nx = _grid_space->sizeX();
-  auto ny = _grid_space->sizeY();
-  auto nz = _grid_space->sizeZ();
+  auto& grid_with_material = g_variety->gridWithMaterial();
+  auto assign = [index, &grid_with_material, &eps_x, &eps_y, &eps_z, &mu_x,
+                 &mu_y, &mu_z, &sigma_e_x, &sigma_e_y, &sigma_e_z, &sigma_m_x,
+                 &sigma_m_y, &sigma_m_z, eps, mu, sigma_e,
+                 sigma_m](const VoxelRow& row) {
+    const auto i = row._i;
+    const auto j = row._j;
+    const auto n = row._k_end - row._k_start;
+    for (auto k = row._k_start; k < row._k_end; ++k) {
+      grid_with_material(i, j, k).setMaterialIndex(index);
+    }
+
+    // A row is contiguous in every array
+    auto fill = [i, j, k = row._k_start, n](auto& arr, Real value) {
+      auto* p = &arr(i, j, k);
+      std::fill(p, p + n, value);
+    };
+    fill(eps_x, eps);
+    fill(eps_y, eps);
+    fill(eps_z, eps);
+    fill(mu_x, mu);
+    fill(mu_y, mu);
+    fill(mu_z, mu);
+    fill(sigma_e_x, sigma_e);
+    fill(sigma_e_y, sigma_e);
+    fill(sigma_e_z, sigma_e);
+    fill(sigma_m_x, sigma_m);
+    fill(sigma_m_y, sigma_m);
+    fill(sigma_m_z, sigma_m);
+  };
+
+  const auto& rows = voxelRows();
 #ifdef XFDTD_CORE_PSTL_ENABLE
-  std::for_each(std::execution::par_unseq,
-                g_variety->gridWithMaterial().begin(),
-                g_variety->gridWithMaterial().end(),
-                [index, &grid_space = _grid_space, &shape = _shape, &eps_x,
-                 &eps_y, &eps_z, &mu_x, &mu_y, &mu_z, &sigma_e_x, &sigma_e_y,
-                 &sigma_e_z, &sigma_m_x, &sigma_m_y, &sigma_m_z, eps, mu,
-                 sigma_e, sigma_m](auto&& g) {
-                  if (!shape->isInside(grid_space->getGridCenterVector(g),
-                                       grid_space->eps())) {
-                    return;
-                  }
-                  g.setMaterialIndex(index);
-                  auto i = g.i();
-                  auto j = g.j();
-                  auto k = g.k();
-                  eps_x(i, j, k) = eps;
-                  eps_y(i, j, k) = eps;
-                  eps_z(i, j, k) = eps;
-                  mu_x(i, j, k) = mu;
-                  mu_y(i, j, k) = mu;
-                  mu_z(i, j, k) = mu;
-                  sigma_e_x(i, j, k) = sigma_e;
-                  sigma_e_y(i, j, k) = sigma_e;
-                  sigma_e_z(i, j, k) = sigma_e;
-                  sigma_m_x(i, j, k) = sigma_m;
-                  sigma_m_y(i, j, k) = sigma_m;
-                  sigma_m_z(i, j, k) = sigma_m;
-                });
+  std::for_each(std::execution::par_unseq, rows.begin(), rows.end(), assign);
 #else
-  std::for_each(g_variety->gridWithMaterial().begin(),
-                g_variety->gridWithMaterial().end(),
-                [index, &grid_space = _grid_space, &shape = _shape, &eps_x,
-                 &eps_y, &eps_z, &mu_x, &mu_y, &mu_z, &sigma_e_x, &sigma_e_y,
-                 &sigma_e_z, &sigma_m_x, &sigma_m_y, &sigma_m_z, eps, mu,
-                 sigma_e, sigma_m](auto&& g) {
-                  if (!shape->isInside(grid_space->getGridCenterVector(g),
-                                       grid_space->eps())) {
-                    return;
-                  }
-                  g.setMaterialIndex(index);
-                  auto i = g.i();
-                  auto j = g.j();
-                  auto k = g.k();
-                  eps_x(i, j, k) = eps;
-                  eps_y(i, j, k) = eps;
-                  eps_z(i, j, k) = eps;
-                  mu_x(i, j, k) = mu;
-                  mu_y(i, j, k) = mu;
-                  mu_z(i, j, k) = mu;
-                  sigma_e_x(i, j, k) = sigma_e;
-                  sigma_e_y(i, j, k) = sigma_e;
-                  sigma_e_z(i, j, k) = sigma_e;
-                  sigma_m_x(i, j, k) = sigma_m;
-                  sigma_m_y(i, j, k) = sigma_m;
-                  sigma_m_z(i, j, k) = sigma_m;
-                });
+  std::for_each(rows.begin(), rows.end(), assign);
 #endif
 }
 
 auto Object::materialIndex() const -> Index { return _material_index; }
 
+auto Object::voxelRows() -> const std::vector<VoxelRow>& {
+  if (!_voxelized) {
+    setVoxelRows(Voxelizer{_grid_space.get(), _shape.get()}.voxelize());
+  }
+  return _voxel_rows;
+}
+
+auto Object::setVoxelRows(std::vector<VoxelRow> rows) -> void {
+  _voxel_rows = std::move(rows);
+  _voxelized = true;
+}
+
 Shape* Object::shapePtr() { return _shape.get(); }
 
 Material* Object::materialPtr() { return _material.get(); }
 
 void Object::initTimeDependentVariable() {}
 
+auto Object::saveState(Checkpoint& checkpoint,
+                       const std::string& prefix) const -> void {}
+
+auto Object::loadState(const Checkpoint& checkpoint,
+                       const std::string& prefix) -> void {}
+
 const GridSpace* Object::gridSpacePtr() const { return _grid_space.get(); }
 
 CalculationParam* Object::calculationParamPtr() {
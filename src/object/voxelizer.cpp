@@ -0,0 +1,152 @@
+#include "object/voxelizer.h"
+
+#include <xfdtd/shape/cube.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace xfdtd {
+
+// Cells whose center lies in [start - eps, end + eps]
+static auto clip(const Array1D<Real>& h_node, Real start, Real end,
+                 Real eps) -> IndexRange {
+  auto first = std::lower_bound(h_node.begin(), h_node.end(), start - eps);
+  auto last = std::upper_bound(first, h_node.end(), end + eps);
+  return makeIndexRange(static_cast<Index>(first - h_node.begin()),
+                        static_cast<Index>(last - h_node.begin()));
+}
+
+Voxelizer::Voxelizer(const GridSpace* grid_space, const Shape* shape)
+    : _grid_space{grid_space}, _shape{shape}, _eps{grid_space->eps()} {
+  auto cube{shape->wrappedCube()};
+  _x_range = clip(grid_space->hNodeX(), cube->originX(), cube->endX(), _eps);
+  _y_range = clip(grid_space->hNodeY(), cube->originY(), cube->endY(), _eps);
+  _z_range = clip(grid_space->hNodeZ(), cube->originZ(), cube->endZ(), _eps);
+}
+
+auto Voxelizer::inside(Index i, Index j, Index k) const -> bool {
+  return _shape->isInside(_grid_space->hNodeX()(i), _grid_space->hNodeY()(j),
+                          _grid_space->hNodeZ()(k), _eps);
+}
+
+auto Voxelizer::voxelizePlane(Index i,
+                              std::vector<VoxelRow>& rows) const -> void {
+  const auto& h_node_x = _grid_space->hNodeX();
+  const auto& h_node_y = _grid_space->hNodeY();
+  const auto& h_node_z = _grid_space->hNodeZ();
+  const auto z_start = _z_range.start();
+  const auto z_end = _z_range.end();
+
+  for (auto j = _y_range.start(); j < _y_range.end(); ++j) {
+    Real start{0};
+    Real end{0};
+    if (!_shape->spanZ(h_node_x(i), h_node_y(j), _eps, start, end)) {
+      // No span, so the column may hold several runs of inside cells
+      auto k = z_start;
+      while (k < z_end) {
+        if (!inside(i, j, k)) {
+          ++k;
+          continue;
+        }
+
+        auto k_start = k;
+        while (k < z_end && inside(i, j, k)) {
+          ++k;
+        }
+        rows.emplace_back(VoxelRow{i, j, k_start, k});
+      }
+      continue;
+    }
+
+    if (end < start) {
+      continue;
+    }
+
+    // Start one cell outside the span at each end and move inwards until
+    // isInside() agrees, so the result doesn't depend on rounding in spanZ().
+    auto span = clip(h_node_z, start, end, _eps);
+    auto k_start = std::max(span.start(), z_start + 1) - 1;
+    auto k_end = std::min(span.end() + 1, z_end);
+    while (k_start < k_end && !inside(i, j, k_start)) {
+      ++k_start;
+    }
+    while (k_start < k_end && !inside(i, j, k_end - 1)) {
+      --k_end;
+    }
+
+    if (k_start < k_end) {
+      rows.emplace_back(VoxelRow{i, j, k_start, k_end});
+    }
+  }
+}
+
+auto Voxelizer::voxelize() const -> std::vector<VoxelRow> {
+  auto rows = std::vector<VoxelRow>{};
+  for (auto i = _x_range.start(); i < _x_range.end(); ++i) {
+    voxelizePlane(i, rows);
+  }
+  return rows;
+}
+
+auto voxelize(const GridSpace* grid_space,
+              const std::vector<const Shape*>& shapes,
+              std::size_t num_thread) -> std::vector<std::vector<VoxelRow>> {
+  struct Plane {
+    std::size_t _shape;
+    Index _i;
+  };
+
+  auto voxelizers = std::vector<Voxelizer>{};
+  auto planes = std::vector<Plane>{};
+  voxelizers.reserve(shapes.size());
+  for (std::size_t n{0}; n < shapes.size(); ++n) {
+    const auto& v = voxelizers.emplace_back(grid_space, shapes[n]);
+    for (auto i = v.xRange().start(); i < v.xRange().end(); ++i) {
+      planes.emplace_back(Plane{n, i});
+    }
+  }
+
+  auto plane_rows = std::vector<std::vector<VoxelRow>>(planes.size());
+  std::atomic<std::size_t> next{0};
+  std::mutex mutex;
+  std::exception_ptr exception;
+  auto work = [&]() {
+    try {
+      for (auto p = next++; p < planes.size(); p = next++) {
+        voxelizers[planes[p]._shape].voxelizePlane(planes[p]._i,
+                                                   plane_rows[p]);
+      }
+    } catch (...) {
+      std::scoped_lock lock{mutex};
+      if (!exception) {
+        exception = std::current_exception();
+      }
+      next = planes.size();
+    }
+  };
+
+  num_thread = std::max<std::size_t>(std::min(num_thread, planes.size()), 1);
+  auto threads = std::vector<std::thread>{};
+  for (std::size_t t{1}; t < num_thread; ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto&& t : threads) {
+    t.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  auto rows = std::vector<std::vector<VoxelRow>>(shapes.size());
+  for (std::size_t p{0}; p < planes.size(); ++p) {
+    auto& r = rows[planes[p]._shape];
+    r.insert(r.end(), plane_rows[p].begin(), plane_rows[p].end());
+  }
+  return rows;
+}
+
+}  // namespace xfdtd
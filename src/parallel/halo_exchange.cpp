@@ -0,0 +1,174 @@
+#include "parallel/halo_exchange.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace xfdtd {
+
+namespace {
+
+// The tags of MpiSupport are used by the strip 0, strip p adds p times this
+constexpr int NUM_EXCHANGE_TAGS{12};
+
+}  // namespace
+
+HaloExchange::HaloExchange(std::size_t piece, std::size_t num_pieces,
+                           const GridSpace& grid_space,
+                           std::shared_ptr<EMF> emf)
+    : _piece{piece}, _num_pieces{num_pieces}, _emf{std::move(emf)} {
+  const auto& mpi_support = MpiSupport::instance();
+  const auto nx = grid_space.sizeX();
+  const auto ny = grid_space.sizeY();
+  const auto nz = grid_space.sizeZ();
+  const auto global_grid_space = grid_space.globalGridSpace();
+  const auto box = grid_space.globalBox();
+
+  const auto hx_shape = std::array<std::size_t, 3>{nx + 1, ny, nz};
+  const auto hy_shape = std::array<std::size_t, 3>{nx, ny + 1, nz};
+  const auto hz_shape = std::array<std::size_t, 3>{nx, ny, nz + 1};
+
+  using C = EMF::Component;
+  using A = Axis::XYZ;
+  if (box.origin().i() != 0) {
+    addFace(C::Y, A::X, hy_shape, 1, 0, mpi_support.xPrev(),
+            MpiSupport::EXCHANGE_HY_X_SR_TAG, MpiSupport::EXCHANGE_HY_X_RS_TAG);
+    addFace(C::Z, A::X, hz_shape, 1, 0, mpi_support.xPrev(),
+            MpiSupport::EXCHANGE_HZ_X_SR_TAG, MpiSupport::EXCHANGE_HZ_X_RS_TAG);
+  }
+
+  if (box.end().i() != global_grid_space->sizeX()) {
+    addFace(C::Y, A::X, hy_shape, nx - 2, nx - 1, mpi_support.xNext(),
+            MpiSupport::EXCHANGE_HY_X_RS_TAG, MpiSupport::EXCHANGE_HY_X_SR_TAG);
+    addFace(C::Z, A::X, hz_shape, nx - 2, nx - 1, mpi_support.xNext(),
+            MpiSupport::EXCHANGE_HZ_X_RS_TAG, MpiSupport::EXCHANGE_HZ_X_SR_TAG);
+  }
+
+  if (box.origin().j() != 0) {
+    addFace(C::Z, A::Y, hz_shape, 1, 0, mpi_support.yPrev(),
+            MpiSupport::EXCHANGE_HZ_Y_SR_TAG, MpiSupport::EXCHANGE_HZ_Y_RS_TAG);
+    addFace(C::X, A::Y, hx_shape, 1, 0, mpi_support.yPrev(),
+            MpiSupport::EXCHANGE_HX_Y_SR_TAG, MpiSupport::EXCHANGE_HX_Y_RS_TAG);
+  }
+
+  if (box.end().j() != global_grid_space->sizeY()) {
+    addFace(C::Z, A::Y, hz_shape, ny - 2, ny - 1, mpi_support.yNext(),
+            MpiSupport::EXCHANGE_HZ_Y_RS_TAG, MpiSupport::EXCHANGE_HZ_Y_SR_TAG);
+    addFace(C::X, A::Y, hx_shape, ny - 2, ny - 1, mpi_support.yNext(),
+            MpiSupport::EXCHANGE_HX_Y_RS_TAG, MpiSupport::EXCHANGE_HX_Y_SR_TAG);
+  }
+
+  if (box.origin().k() != 0) {
+    addFace(C::X, A::Z, hx_shape, 1, 0, mpi_support.zPrev(),
+            MpiSupport::EXCHANGE_HX_Z_SR_TAG, MpiSupport::EXCHANGE_HX_Z_RS_TAG);
+    addFace(C::Y, A::Z, hy_shape, 1, 0, mpi_support.zPrev(),
+            MpiSupport::EXCHANGE_HY_Z_SR_TAG, MpiSupport::EXCHANGE_HY_Z_RS_TAG);
+  }
+
+  if (box.end().k() != global_grid_space->sizeZ()) {
+    addFace(C::X, A::Z, hx_shape, nz - 2, nz - 1, mpi_support.zNext(),
+            MpiSupport::EXCHANGE_HX_Z_RS_TAG, MpiSupport::EXCHANGE_HX_Z_SR_TAG);
+    addFace(C::Y, A::Z, hy_shape, nz - 2, nz - 1, mpi_support.zNext(),
+            MpiSupport::EXCHANGE_HY_Z_RS_TAG, MpiSupport::EXCHANGE_HY_Z_SR_TAG);
+  }
+}
+
+HaloExchange::~HaloExchange() { wait(); }
+
+auto HaloExchange::post() -> void {
+#if defined(XFDTD_CORE_WITH_MPI)
+  const auto comm = MpiSupport::instance().config().comm();
+  for (auto&& f : _faces) {
+    auto* data = field(f._component).data();
+    MPI_Request request;
+    MPI_Irecv(&data[f._recv.profile()._disp], 1, f._recv.block(), f._peer,
+              f._recv_tag, comm, &request);
+    _requests.emplace_back(request);
+    MPI_Isend(&data[f._send.profile()._disp], 1, f._send.block(), f._peer,
+              f._send_tag, comm, &request);
+    _requests.emplace_back(request);
+  }
+#endif
+}
+
+auto HaloExchange::wait() -> void {
+#if defined(XFDTD_CORE_WITH_MPI)
+  if (_requests.empty()) {
+    return;
+  }
+
+  std::vector<MPI_Status> statuses(_requests.size());
+  MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(),
+              statuses.data());
+  for (const auto& s : statuses) {
+    if (s.MPI_ERROR != MPI_SUCCESS) {
+      std::cerr << "HaloExchange::wait MPI_Waitall failed\n";
+      MpiSupport::instance().abort(s.MPI_ERROR);
+    }
+  }
+  _requests.clear();
+#endif
+}
+
+auto HaloExchange::field(EMF::Component c) -> Array3D<Real>& {
+  switch (c) {
+    case EMF::Component::X:
+      return _emf->hx();
+    case EMF::Component::Y:
+      return _emf->hy();
+    default:
+      return _emf->hz();
+  }
+}
+
+auto HaloExchange::addFace(EMF::Component component, Axis::XYZ axis,
+                           const std::array<std::size_t, 3>& shape,
+                           std::size_t send_plane, std::size_t recv_plane,
+                           int peer, int send_tag, int recv_tag) -> void {
+  // A face normal to x is cut along y, the others along x
+  const auto cut_axis = axis == Axis::XYZ::X ? 1 : 0;
+  const auto extent = shape[cut_axis];
+  const auto pieces = std::min(_num_pieces, extent);
+  if (pieces <= _piece) {
+    return;
+  }
+
+  const auto start = extent * _piece / pieces;
+  const auto end = extent * (_piece + 1) / pieces;
+  const auto sy = shape[1];
+  const auto sz = shape[2];
+
+  auto make_block = [&](std::size_t plane) {
+    MpiSupport::Block::Profile p;
+    p._stride_elem = static_cast<int>(sz);
+    p._stride_vec = static_cast<int>(sy * sz);
+    switch (axis) {
+      case Axis::XYZ::X:
+        p._nx = 1;
+        p._ny = static_cast<int>(end - start);
+        p._nz = static_cast<int>(sz);
+        p._disp = static_cast<int>(plane * sy * sz + start * sz);
+        break;
+      case Axis::XYZ::Y:
+        p._nx = static_cast<int>(end - start);
+        p._ny = 1;
+        p._nz = static_cast<int>(sz);
+        p._disp = static_cast<int>(start * sy * sz + plane * sz);
+        break;
+      default:
+        p._nx = static_cast<int>(end - start);
+        p._ny = static_cast<int>(sy);
+        p._nz = 1;
+        p._disp = static_cast<int>(start * sy * sz + plane);
+        break;
+    }
+    return MpiSupport::Block::make(p);
+  };
+
+  const auto tag_offset = NUM_EXCHANGE_TAGS * static_cast<int>(_piece);
+  _faces.emplace_back(Face{component, peer, send_tag + tag_offset,
+                           recv_tag + tag_offset, make_block(send_plane),
+                           make_block(recv_plane)});
+}
+
+}  // namespace xfdtd
@@ -19,12 +19,17 @@ namespace xfdtd {
 auto MpiSupport::init(int argc, char** argv) -> bool {
 #if defined(XFDTD_CORE_WITH_MPI)
   int flag;
+  int provided;
   MPI_Initialized(&flag);
   if (flag != 0) {
+    MPI_Query_thread(&provided);
+    thread_multiple = provided == MPI_THREAD_MULTIPLE;
     return true;
   }
 
-  flag = MPI_Init(&argc, &argv);
+  // Every thread of a domain may post its own part of the halo exchange
+  flag = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  thread_multiple = provided == MPI_THREAD_MULTIPLE;
   MPI_Comm_rank(MPI_COMM_WORLD, &global_rank);
   MPI_Comm_size(MPI_COMM_WORLD, &global_size);
   return flag == MPI_SUCCESS;
@@ -2,9 +2,18 @@
 #include <xfdtd/parallel/mpi_support.h>
 #include <xfdtd/parallel/parallelized_config.h>
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #if defined(XFDTD_CORE_WITH_MPI)
 #include <mpi.h>
@@ -12,6 +21,83 @@
 
 namespace xfdtd {
 
+namespace {
+
+/**
+ * @brief The CPUs this process may run on, from its affinity mask. Ranks on
+ * the same node started with the same mask split it evenly in rank order,
+ * ranks started with disjoint masks keep theirs.
+ */
+auto rankCpus() -> std::vector<int> {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+      if (CPU_ISSET(c, &mask)) {
+        cpus.emplace_back(c);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    cpus.resize(std::max(std::thread::hardware_concurrency(), 1U));
+    std::iota(cpus.begin(), cpus.end(), 0);
+  }
+
+#if defined(XFDTD_CORE_WITH_MPI)
+  int initialized{0};
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    return cpus;
+  }
+
+  MPI_Comm node;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &node);
+  int local_rank{0};
+  int local_size{1};
+  MPI_Comm_rank(node, &local_rank);
+  MPI_Comm_size(node, &local_size);
+
+  // how many ranks of the node may run on each CPU
+  int num_cpu{cpus.back() + 1};
+  MPI_Allreduce(MPI_IN_PLACE, &num_cpu, 1, MPI_INT, MPI_MAX, node);
+  auto users = std::vector<int>(num_cpu, 0);
+  for (auto c : cpus) {
+    users[c] = 1;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, users.data(), num_cpu, MPI_INT, MPI_SUM, node);
+  MPI_Comm_free(&node);
+
+  const auto shared = std::all_of(cpus.begin(), cpus.end(), [&](int c) {
+    return users[c] == local_size;
+  });
+  const auto disjoint = std::all_of(cpus.begin(), cpus.end(),
+                                    [&](int c) { return users[c] == 1; });
+  if (1 < local_size && shared) {
+    const auto chunk = cpus.size() / static_cast<std::size_t>(local_size);
+    if (chunk == 0) {
+      std::stringstream ss;
+      ss << local_size << " ranks share " << cpus.size() << " CPUs";
+      throw ParallelizedConfigException(ss.str());
+    }
+
+    const auto start = cpus.begin() + static_cast<long>(chunk) * local_rank;
+    cpus = std::vector<int>(start, start + static_cast<long>(chunk));
+  } else if (!disjoint) {
+    throw ParallelizedConfigException(
+        "Ranks on this node have overlapping but different CPU masks. Bind "
+        "them to disjoint CPUs or to the same set, or use setCpuList()");
+  }
+#endif
+
+  return cpus;
+}
+
+}  // namespace
+
 ParallelizedConfig::ParallelizedConfig(int num_x, int num_y, int num_z, int id,
                                        int size, int root)
     : _dims{num_x, num_y, num_z}, _id{id}, _size{size}, _root{root} {
@@ -111,11 +197,77 @@ auto ThreadConfig::numZ() const -> int { return ParallelizedConfig::numZ(); }
 
 auto ThreadConfig::setId(int id) -> void { ParallelizedConfig::setId(id); }
 
+auto ThreadConfig::affinity() const -> Affinity { return _affinity; }
+
+auto ThreadConfig::setAffinity(Affinity affinity) -> void {
+  if (affinity == Affinity::LIST && _cpu_list.empty()) {
+    throw ParallelizedConfigException("CPU list is empty");
+  }
+
+  _affinity = affinity;
+}
+
+auto ThreadConfig::setCpuList(std::vector<int> cpu_list) -> void {
+  if (cpu_list.size() < static_cast<std::size_t>(size())) {
+    throw ParallelizedConfigException(
+        "CPU list is shorter than the number of threads");
+  }
+
+  _cpu_list = std::move(cpu_list);
+  _affinity = Affinity::LIST;
+}
+
+auto ThreadConfig::cpuOf(int id) const -> int {
+  switch (_affinity) {
+    case Affinity::CLOSE:
+    case Affinity::SPREAD:
+      break;
+    case Affinity::LIST:
+      return _cpu_list[id];
+    default:
+      return -1;
+  }
+
+  // collective over the ranks of the node the first time
+  static const auto cpus = rankCpus();
+  const auto num_cpu = static_cast<long long>(cpus.size());
+  if (_affinity == Affinity::CLOSE) {
+    return cpus[id % num_cpu];
+  }
+  return cpus[(static_cast<long long>(id) * num_cpu / size()) % num_cpu];
+}
+
+auto ThreadConfig::firstTouch() const -> bool { return _first_touch; }
+
+auto ThreadConfig::setFirstTouch(bool first_touch) -> void {
+  _first_touch = first_touch;
+}
+
 auto ThreadConfig::toString() const -> std::string {
   std::stringstream ss;
   ss << "ThreadConfig Config:\n";
   ss << " Size: " << size() << "\n";
   ss << " Root: " << root() << "\n";
+  ss << " Affinity: ";
+  switch (_affinity) {
+    case Affinity::CLOSE:
+      ss << "close";
+      break;
+    case Affinity::SPREAD:
+      ss << "spread";
+      break;
+    case Affinity::LIST:
+      ss << "list";
+      for (const auto& c : _cpu_list) {
+        ss << " " << c;
+      }
+      break;
+    default:
+      ss << "none";
+      break;
+  }
+  ss << "\n";
+  ss << " First touch: " << std::boolalpha << _first_touch << "\n";
   return ss.str();
 }
 
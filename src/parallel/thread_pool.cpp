@@ -0,0 +1,106 @@
+#include "parallel/thread_pool.h"
+
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace xfdtd {
+
+auto pinCurrentThread(int cpu) -> void {
+  if (cpu < 0) {
+    return;
+  }
+
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  if (int rc = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+      rc != 0) {
+    std::stringstream ss;
+    ss << "Error calling pthread_setaffinity_np for CPU " << cpu << ": " << rc
+       << "\n";
+    std::cerr << ss.str();
+  }
+#endif
+}
+
+ThreadPool::ThreadPool(std::size_t size,
+                       const std::function<int(std::size_t)>& cpu_of) {
+  _workers.reserve(size);
+  for (std::size_t id = 0; id < size; ++id) {
+    _workers.emplace_back(&ThreadPool::work, this, id, cpu_of(id));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock{_mutex};
+    _stop = true;
+  }
+  _job_cv.notify_all();
+
+  for (auto& w : _workers) {
+    if (w.joinable()) {
+      w.join();
+    }
+  }
+}
+
+auto ThreadPool::run(const std::function<void(std::size_t)>& job) -> void {
+  std::unique_lock lock{_mutex};
+  _job = &job;
+  _pending = _workers.size();
+  _exception = nullptr;
+  ++_generation;
+  _job_cv.notify_all();
+
+  _done_cv.wait(lock, [this]() { return _pending == 0; });
+  _job = nullptr;
+
+  if (_exception) {
+    std::rethrow_exception(_exception);
+  }
+}
+
+auto ThreadPool::work(std::size_t id, int cpu) -> void {
+  pinCurrentThread(cpu);
+
+  std::size_t generation = 0;
+  while (true) {
+    const std::function<void(std::size_t)>* job = nullptr;
+    {
+      std::unique_lock lock{_mutex};
+      _job_cv.wait(lock,
+                   [&]() { return _stop || _generation != generation; });
+      if (_stop) {
+        return;
+      }
+
+      generation = _generation;
+      job = _job;
+    }
+
+    std::exception_ptr exception;
+    try {
+      (*job)(id);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    {
+      std::scoped_lock lock{_mutex};
+      if (exception && !_exception) {
+        _exception = exception;
+      }
+      --_pending;
+    }
+    _done_cv.notify_one();
+  }
+}
+
+}  // namespace xfdtd
@@ -76,6 +76,20 @@ std::unique_ptr<Cube> Cube::wrappedCube() const {
   return std::make_unique<Cube>(*this);
 }
 
+bool Cube::spanZ(Real x, Real y, Real eps, Real& start, Real& end) const {
+  if (floatCompare(originX(), x, FloatCompareOperator::LessEqual, eps) &&
+      floatCompare(x, endX(), FloatCompareOperator::LessEqual, eps) &&
+      floatCompare(originY(), y, FloatCompareOperator::LessEqual, eps) &&
+      floatCompare(y, endY(), FloatCompareOperator::LessEqual, eps)) {
+    start = originZ();
+    end = endZ();
+  } else {
+    start = std::numeric_limits<Real>::infinity();
+    end = -std::numeric_limits<Real>::infinity();
+  }
+  return true;
+}
+
 void Cube::updateEnd() {
   _end = _origin + _size;
   if (std::isnan(_end.x())) {
@@ -2,6 +2,8 @@
 #include <xfdtd/shape/cylinder.h>
 #include <xfdtd/shape/shape.h>
 
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -70,6 +72,46 @@ bool Cylinder::isInside(const Vector& vector, Real eps) const {
   return isInside(vector.x(), vector.y(), vector.z(), eps);
 }
 
+bool Cylinder::spanZ(Real x, Real y, Real eps, Real& start, Real& end) const {
+  start = std::numeric_limits<Real>::infinity();
+  end = -std::numeric_limits<Real>::infinity();
+
+  // A little wider than isInside(), the voxelizer checks the ends
+  auto r{radius() + eps};
+  auto h{height() / 2 + eps};
+  if (_axis == Axis::XYZ::Z) {
+    auto d2{(x - _center.x()) * (x - _center.x()) +
+            (y - _center.y()) * (y - _center.y())};
+    if (d2 <= r * r) {
+      start = _center.z() - h;
+      end = _center.z() + h;
+    }
+    return true;
+  }
+
+  // The axis lies in the xy plane: the line crosses the disk at the height
+  // along the axis and the circle in the other direction.
+  Real along{0};
+  Real across{0};
+  if (_axis == Axis::XYZ::X) {
+    along = x - _center.x();
+    across = y - _center.y();
+  } else if (_axis == Axis::XYZ::Y) {
+    along = y - _center.y();
+    across = x - _center.x();
+  } else {
+    throw XFDTDShapeFailToSupportException{"Cylinder axis is not supported"};
+  }
+  if (h < std::abs(along) || r < std::abs(across)) {
+    return true;
+  }
+
+  auto half{std::sqrt(r * r - across * across)};
+  start = _center.z() - half;
+  end = _center.z() + half;
+  return true;
+}
+
 std::unique_ptr<Cube> Cylinder::wrappedCube() const {
   auto size{radius() * 2};
 
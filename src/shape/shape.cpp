@@ -5,6 +5,10 @@ namespace xfdtd {
 
 std::string Shape::toString() const { return std::string{"Shape()"}; }
 
+bool Shape::spanZ(Real x, Real y, Real eps, Real& start, Real& end) const {
+  return false;
+}
+
 std::unique_ptr<Cube> Shape::makeWrappedCube(
     const std::vector<const Shape*>& shapes) {
   if (shapes.empty()) {
@@ -1,5 +1,8 @@
 #include <xfdtd/shape/sphere.h>
 
+#include <cmath>
+#include <limits>
+
 #include "util/float_compare.h"
 #include "xfdtd/coordinate_system/coordinate_system.h"
 #include "xfdtd/shape/cube.h"
@@ -36,6 +39,23 @@ std::unique_ptr<Cube> Sphere::wrappedCube() const {
                                 Vector{_radius * 2, _radius * 2, _radius * 2});
 }
 
+bool Sphere::spanZ(Real x, Real y, Real eps, Real& start, Real& end) const {
+  auto r{radius() + eps};
+  auto dx{x - centerX()};
+  auto dy{y - centerY()};
+  auto d2{dx * dx + dy * dy};
+  if (r * r < d2) {
+    start = std::numeric_limits<Real>::infinity();
+    end = -std::numeric_limits<Real>::infinity();
+    return true;
+  }
+
+  auto half{std::sqrt(r * r - d2)};
+  start = centerZ() - half;
+  end = centerZ() + half;
+  return true;
+}
+
 Vector Sphere::center() const { return _center; }
 
 Real Sphere::radius() const { return _radius; }
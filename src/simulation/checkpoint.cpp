@@ -0,0 +1,160 @@
+#include <xfdtd/simulation/checkpoint.h>
+
+#include <array>
+#include <fstream>
+
+namespace xfdtd {
+
+static constexpr std::array<char, 8> MAGIC{'X', 'F', 'D', 'T',
+                                           'D', 'C', 'K', 'P'};
+
+template <typename T>
+static auto put(std::ofstream& ofs, T value) -> void {
+  ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static auto get(std::ifstream& ifs) -> T {
+  T value{};
+  ifs.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+static auto pad(std::ofstream& ofs) -> void {
+  const auto pos = static_cast<std::size_t>(ofs.tellp());
+  const auto rem = pos % Checkpoint::ALIGNMENT;
+  if (rem != 0) {
+    const auto zeros = std::vector<char>(Checkpoint::ALIGNMENT - rem, 0);
+    ofs.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+  }
+}
+
+auto Checkpoint::entry(const std::string& name) const -> const Entry& {
+  auto it = _index.find(name);
+  if (it == _index.end()) {
+    std::stringstream ss;
+    ss << "Checkpoint has no entry " << name;
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  return _entries[it->second];
+}
+
+auto Checkpoint::add(Entry entry) -> void {
+  if (contains(entry._name)) {
+    std::stringstream ss;
+    ss << "Checkpoint entry " << entry._name << " is saved twice";
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  _index.emplace(entry._name, _entries.size());
+  _entries.emplace_back(std::move(entry));
+}
+
+auto Checkpoint::write(const std::string& path) const -> void {
+  std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+  if (!ofs) {
+    std::stringstream ss;
+    ss << "Can't open checkpoint file " << path;
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  ofs.write(MAGIC.data(), MAGIC.size());
+  put<std::uint32_t>(ofs, VERSION);
+  put<std::uint32_t>(ofs, sizeof(Real));
+  put<std::uint64_t>(ofs, _step);
+  put<std::uint64_t>(ofs, _entries.size());
+  const auto table_pos = ofs.tellp();
+  put<std::uint64_t>(ofs, 0);
+  pad(ofs);
+
+  auto offsets = std::vector<std::uint64_t>{};
+  offsets.reserve(_entries.size());
+  for (const auto& e : _entries) {
+    offsets.emplace_back(static_cast<std::uint64_t>(ofs.tellp()));
+    ofs.write(e._data.data(), static_cast<std::streamsize>(e._data.size()));
+    pad(ofs);
+  }
+
+  const auto table_offset = static_cast<std::uint64_t>(ofs.tellp());
+  for (std::size_t n{0}; n < _entries.size(); ++n) {
+    const auto& e = _entries[n];
+    put<std::uint32_t>(ofs, static_cast<std::uint32_t>(e._name.size()));
+    ofs.write(e._name.data(), static_cast<std::streamsize>(e._name.size()));
+    put<std::uint32_t>(ofs, static_cast<std::uint32_t>(e._type));
+    put<std::uint32_t>(ofs, static_cast<std::uint32_t>(e._shape.size()));
+    for (auto s : e._shape) {
+      put<std::uint64_t>(ofs, s);
+    }
+    put<std::uint64_t>(ofs, offsets[n]);
+    put<std::uint64_t>(ofs, e._data.size());
+  }
+
+  ofs.seekp(table_pos);
+  put<std::uint64_t>(ofs, table_offset);
+  ofs.flush();
+  if (!ofs) {
+    std::stringstream ss;
+    ss << "Failed to write checkpoint file " << path;
+    throw XFDTDCheckpointException{ss.str()};
+  }
+}
+
+auto Checkpoint::read(const std::string& path) -> Checkpoint {
+  std::ifstream ifs{path, std::ios::binary};
+  if (!ifs) {
+    std::stringstream ss;
+    ss << "Can't open checkpoint file " << path;
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  auto magic = std::array<char, 8>{};
+  ifs.read(magic.data(), magic.size());
+  const auto version = get<std::uint32_t>(ifs);
+  const auto real_size = get<std::uint32_t>(ifs);
+  if (!ifs || magic != MAGIC || version != VERSION ||
+      real_size != sizeof(Real)) {
+    std::stringstream ss;
+    ss << path << " isn't a checkpoint of this build (version " << version
+       << ", sizeof(Real) " << real_size << ")";
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  Checkpoint checkpoint;
+  checkpoint._step = get<std::uint64_t>(ifs);
+  const auto num_entry = get<std::uint64_t>(ifs);
+  const auto table_offset = get<std::uint64_t>(ifs);
+
+  ifs.seekg(static_cast<std::streamoff>(table_offset));
+  auto offsets = std::vector<std::uint64_t>(num_entry);
+  for (std::size_t n{0}; n < num_entry; ++n) {
+    Entry e;
+    e._name.resize(get<std::uint32_t>(ifs));
+    ifs.read(e._name.data(), static_cast<std::streamsize>(e._name.size()));
+    e._type = static_cast<Type>(get<std::uint32_t>(ifs));
+    e._shape.resize(get<std::uint32_t>(ifs));
+    for (auto& s : e._shape) {
+      s = get<std::uint64_t>(ifs);
+    }
+    offsets[n] = get<std::uint64_t>(ifs);
+    e._data.resize(get<std::uint64_t>(ifs));
+    checkpoint._entries.emplace_back(std::move(e));
+  }
+
+  for (std::size_t n{0}; n < num_entry; ++n) {
+    auto& e = checkpoint._entries[n];
+    ifs.seekg(static_cast<std::streamoff>(offsets[n]));
+    ifs.read(e._data.data(), static_cast<std::streamsize>(e._data.size()));
+    checkpoint._index.emplace(e._name, n);
+  }
+
+  if (!ifs) {
+    std::stringstream ss;
+    ss << "Checkpoint file " << path << " is truncated";
+    throw XFDTDCheckpointException{ss.str()};
+  }
+
+  return checkpoint;
+}
+
+}  // namespace xfdtd
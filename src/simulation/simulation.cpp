@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -25,16 +26,27 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <xtensor/xnpy.hpp>
 
+#include "boundary/fused_pml_corrector.h"
+#include "boundary/pml_corrector.h"
 #include "corrector/corrector.h"
 #include "domain/domain.h"
+#include "grid_space/subgrid_corrector.h"
+#include "object/batched_lumped_element_corrector.h"
+#include "object/lumped_element_corrector.h"
+#include "object/voxelizer.h"
+#include "parallel/halo_exchange.h"
+#include "parallel/thread_pool.h"
 #include "updator/ade_updator/debye_ade_updator.h"
 #include "updator/ade_updator/drude_ade_updator.h"
 #include "updator/ade_updator/m_lor_ade_updator.h"
+#include "updator/ade_updator/sparse_ade_updator.h"
 #include "updator/basic_updator.h"
+#include "updator/fused_sweep_updator.h"
 #include "updator/updator.h"
 #include "util/decompose_task.h"
 
@@ -80,6 +92,10 @@ void Simulation::addNetwork(std::shared_ptr<Network> network) {
   _networks.emplace_back(std::move(network));
 }
 
+auto Simulation::addSubgrid(std::shared_ptr<Subgrid> subgrid) -> void {
+  _subgrids.emplace_back(std::move(subgrid));
+}
+
 void Simulation::addNF2FF(std::shared_ptr<NFFFT> nffft) {
   _nfffts.emplace_back(std::move(nffft));
 }
@@ -271,6 +287,85 @@ auto Simulation::addDefaultVisitor() -> void {
   _visitors.emplace_back(std::make_shared<DefaultSimulationFlagVisitor>());
 }
 
+auto Simulation::enableGradedMesh(Real min_dx, Real min_dy, Real min_dz,
+                                  Real max_ratio) -> void {
+  if (max_ratio <= 1) {
+    throw XFDTDSimulationException("Growth ratio of graded mesh must be > 1");
+  }
+
+  _min_dx = min_dx;
+  _min_dy = min_dy;
+  _min_dz = min_dz;
+  _max_ratio = max_ratio;
+}
+
+auto Simulation::enableFusedSweep(Index tile_size) -> void {
+  if (tile_size == 0) {
+    throw XFDTDSimulationException("Tile size of the fused sweep is 0");
+  }
+
+  _fused_sweep_tile_size = tile_size;
+}
+
+auto Simulation::enableCoefficientCompression() -> void {
+  _coefficient_compression = true;
+}
+
+auto Simulation::enableSparseDispersion() -> void {
+  _sparse_dispersion = true;
+}
+
+auto Simulation::enableHaloOverlap() -> void { _halo_overlap = true; }
+
+auto Simulation::enableThreadedHaloExchange() -> void {
+  _threaded_halo_exchange = true;
+}
+
+auto Simulation::enableFusedPML() -> void { _fused_pml = true; }
+
+auto Simulation::enableBatchedLumpedElements() -> void {
+  _batched_lumped_elements = true;
+}
+
+auto Simulation::enableCostDecomposition(Real pml_cost, Real dispersive_cost,
+                                         Real surface_cost) -> void {
+  if (pml_cost < 0 || dispersive_cost < 0 || surface_cost < 0) {
+    throw XFDTDSimulationException("Decomposition cost must be non-negative");
+  }
+
+  _cost_decomposition = true;
+  _pml_cost = pml_cost;
+  _dispersive_cost = dispersive_cost;
+  _surface_cost = surface_cost;
+}
+
+auto Simulation::enableCheckpoint(std::string dir, Index interval) -> void {
+  _checkpoint_dir = std::move(dir);
+  _checkpoint_interval = interval;
+}
+
+auto Simulation::saveCheckpoint(const std::string& dir) -> void {
+  if (_thread_pool == nullptr) {
+    throw XFDTDSimulationException("Simulation is not initialized");
+  }
+
+  waitCheckpoint();
+  writeCheckpoint(captureCheckpoint(), dir);
+}
+
+auto Simulation::loadCheckpoint(const std::string& dir) -> void {
+  if (_thread_pool == nullptr) {
+    throw XFDTDSimulationException("Simulation is not initialized");
+  }
+
+  restoreCheckpoint(Checkpoint::read(checkpointPath(dir)));
+}
+
+auto Simulation::addProfileVisitor(
+    std::shared_ptr<SimulationProfileVisitor> visitor) -> void {
+  _profile_visitors.emplace_back(std::move(visitor));
+}
+
 const std::shared_ptr<CalculationParam>& Simulation::calculationParam() const {
   return _calculation_param;
 }
@@ -289,30 +384,36 @@ void Simulation::run(Index time_step) {
 }
 
 auto Simulation::run() -> void {
-  {
-    std::vector<std::thread> threads;
-    for (Index i = 1; i < _domains.size(); ++i) {
-      threads.emplace_back([&domain = _domains[i]]() { domain->run(); });
-    }
+  if (_thread_pool == nullptr) {
+    throw XFDTDSimulationException("Simulation is not initialized");
+  }
+  if (_abort) {
+    throw XFDTDSimulationException(
+        "A previous run failed, the simulation can't run again");
+  }
 
-    struct ThreadGuard {
-      ~ThreadGuard() {
-        for (auto& t : _threads) {
-          if (t.joinable()) {
-            t.join();
-          }
-        }
-      }
+  for (auto&& d : _domains) {
+    d->setAbort(&_abort);
+    d->setProfileVisitors(_profile_visitors);
+    d->setCheckpoint(_checkpoint_interval, [this]() { beginCheckpoint(); });
+  }
+
+  for (auto&& v : _profile_visitors) {
+    v->profileStart(myRank(), _domains.size());
+  }
 
-      std::vector<std::thread> _threads;
-      std::chrono::high_resolution_clock::time_point _start_time;
-    } tg{
-        ._threads = std::move(threads),
-    };
+  _thread_pool->run([this](std::size_t id) { _domains[id]->run(); });
 
-    _domains[0]->run();
+  for (auto&& v : _profile_visitors) {
+    v->profileEnd();
+  }
+
+  for (auto&& m : _monitors) {
+    m->flushOutput();
   }
 
+  waitCheckpoint();
+
   MpiSupport::instance().barrier();
 }
 
@@ -346,6 +447,14 @@ void Simulation::init() {
 
   generateFDTDUpdateCoefficient();
 
+  if (!_subgrids.empty() && (numNode() > 1 || _fused_sweep_tile_size != 0)) {
+    throw XFDTDSimulationException(
+        "Subgrids need a single MPI process and no fused sweep");
+  }
+  for (auto&& s : _subgrids) {
+    s->init(_grid_space, _calculation_param, _emf, _objects);
+  }
+
   // init monitor
   for (auto&& m : _monitors) {
     m->init(_grid_space, _calculation_param, _emf);
@@ -359,6 +468,18 @@ void Simulation::init() {
 
   generateDomain();
 
+  if (_coefficient_compression) {
+    compressCoefficient();
+  }
+
+  _thread_pool = std::make_unique<ThreadPool>(
+      _domains.size(), [this](std::size_t id) {
+        return _thread_config.cpuOf(static_cast<int>(id));
+      });
+  if (_thread_config.firstTouch() && 1 < _domains.size()) {
+    firstTouch();
+  }
+
   for (auto&& m : _monitors) {
     m->initParallelizedConfig();
   }
@@ -368,6 +489,18 @@ void Simulation::init() {
 
   MpiSupport::instance().generateSlice(
       _grid_space->sizeX(), _grid_space->sizeY(), _grid_space->sizeZ());
+
+  if (_threaded_halo_exchange && numNode() > 1 && 1 < _domains.size()) {
+    if (MpiSupport::threadMultiple()) {
+      for (auto&& d : _domains) {
+        d->setHaloExchange(std::make_unique<HaloExchange>(
+            d->id(), _domains.size(), *_grid_space, _emf));
+      }
+    } else if (MpiSupport::instance().isRoot()) {
+      std::cerr << "MPI_THREAD_MULTIPLE is not provided. The master thread of "
+                   "each node exchanges the H halo.\n";
+    }
+  }
 }
 
 auto Simulation::init(Index time_step) -> void {
@@ -386,6 +519,17 @@ auto Simulation::init(Index time_step) -> void {
   for (auto&& m : _monitors) {
     m->initTimeDependentVariable();
   }
+
+  for (auto&& n : _nfffts) {
+    if (n->shardable()) {
+      n->initShards(_domains.size());
+    }
+  }
+  for (auto&& m : _monitors) {
+    if (m->shardable()) {
+      m->initShards(_domains.size());
+    }
+  }
 }
 
 auto Simulation::sendFlag(SimulationInitFlag flag) -> void {
@@ -417,38 +561,48 @@ void Simulation::generateDomain() {
   //              makeRange<std::size_t>(0, _grid_space->sizeY()),
   //              makeRange<std::size_t>(0, _grid_space->sizeZ()))};
 
-  auto tasks = decomposeTask(problem, _thread_config.numX(),
-                             _thread_config.numY(), _thread_config.numZ());
-
-  // Corrector
-  /*  IMPORTANT: the corrector can't be parallelized in thread model, the
-  problem is here: tangential electric field in the thread edge is corrected by
-  two threads. Example: Divider type is X, the number of threads is 2, total nx
-  is 100. Thread 0 get [0, 50), and thread 1 get [50, 100). The tangential
-  electric field at x = 50 is corrected by both thread 0 and thread 1. Think
-  about the case pml. Ez(x = 50) is contain in pml of thread 0 and pml of
-  thread 1.
-  NOTE(franzero): If the corrector is parallelized, the corrector has to be
-  implemented that function correctEdge(). Just like updator, let thread 0 to
-  update 50, and thread 1 to update 51-100. I suggest that it's not necessary to
-  parallelize the corrector in the thread model, because the corrector is
-  usually much smaller than the problem size.
-  */
-  std::vector<std::unique_ptr<Corrector>> correctors;
-
-  for (auto&& o : _objects) {
-    auto c = o->generateCorrector(problem);
-    if (c == nullptr) {
-      continue;
-    }
-
-    correctors.emplace_back(std::move(c));
-  }
-
+  const auto nx = _thread_config.numX();
+  const auto ny = _thread_config.numY();
+  const auto nz = _thread_config.numZ();
+  auto tasks = _cost_decomposition
+                   ? decomposeTask(problem, nx, ny, nz,
+                                   decompositionWeights(problem))
+                   : decomposeTask(problem, nx, ny, nz);
+
+  // Object correctors are generated per task. A task owns the E nodes whose
+  // index is in [start, end) of its ranges, like the E update, so a node on the
+  // face between two tasks is corrected once, by the upper task. A corrector
+  // must only touch the nodes of the task it was generated for.
   bool master = true;
   Index id = {0};
+  std::vector<FusedSweepUpdator3D*> fused_updators;
   for (const auto& t : tasks) {
     auto updator = makeUpdator(t);
+    if (auto b = dynamic_cast<FusedSweepUpdator3D*>(updator.get());
+        b != nullptr) {
+      fused_updators.emplace_back(b);
+    }
+
+    std::vector<std::unique_ptr<Corrector>> correctors;
+    auto lumped_elements =
+        std::make_unique<BatchedLumpedElementCorrector>(_calculation_param);
+    for (auto&& o : _objects) {
+      auto c = o->generateCorrector(t);
+      if (c == nullptr) {
+        continue;
+      }
+
+      if (auto* l = dynamic_cast<LumpedElementCorrector*>(c.get());
+          _batched_lumped_elements && l != nullptr) {
+        lumped_elements->add(*l);
+        continue;
+      }
+
+      correctors.emplace_back(std::move(c));
+    }
+    if (!lumped_elements->empty()) {
+      correctors.emplace_back(std::move(lumped_elements));
+    }
 
     if (id == _thread_config.root()) {
       _domains.emplace_back(std::make_unique<Domain>(
@@ -462,11 +616,16 @@ void Simulation::generateDomain() {
       }
 
     } else {
-      _domains.emplace_back(
-          std::make_unique<Domain>(id, t, _grid_space, _calculation_param, _emf,
-                                   std::move(updator), _barrier, false));
+      // Every domain records its own part of the monitors, see
+      // Domain::record()
+      _domains.emplace_back(std::make_unique<Domain>(
+          id, t, _grid_space, _calculation_param, _emf, std::move(updator),
+          std::vector<std::shared_ptr<WaveformSource>>{},
+          std::move(correctors), _monitors, _nfffts, _barrier, false));
     }
 
+    _domains.back()->setHaloOverlap(_halo_overlap && numNode() > 1);
+
     for (auto&& w : _waveform_sources) {
       auto c = w->generateCorrector(t);
       if (c == nullptr) {
@@ -476,21 +635,161 @@ void Simulation::generateDomain() {
       _domains.back()->addCorrector(std::move(c));
     }
 
+    auto fused_pml = std::make_unique<FusedPMLCorrector>();
     for (auto&& b : _boundaries) {
       auto c = b->generateDomainCorrector(t);
       if (c == nullptr) {
         continue;
       }
 
+      if (auto p = dynamic_cast<PMLCorrectorBase*>(c.get());
+          _fused_pml && p != nullptr) {
+        fused_pml->add(*p);
+        continue;
+      }
+
       _domains.back()->addCorrector(std::move(c));
     }
 
+    if (!fused_pml->empty()) {
+      _domains.back()->addCorrector(std::move(fused_pml));
+    }
+
     ++id;
   }
 
   if (master) {
     throw XFDTDSimulationException("Master domain is not created");
   }
+
+  // A subgrid reads and writes coarse E across thread tasks, so it runs on the
+  // master after the other correctors of its domain. The other correctors run
+  // at the same time on other threads and must stay away from its cells.
+  for (auto&& s : _subgrids) {
+    const auto footprint = SubgridCorrector{s}.correctERegion()->front();
+    for (const auto& d : _domains) {
+      auto e = d->correctERegion();
+      auto h = d->correctHRegion();
+      if (!e.has_value() || !h.has_value()) {
+        std::stringstream ss;
+        ss << "Subgrid " << s->name()
+           << ": can't tell where the correctors of domain " << d->id()
+           << " act";
+        throw XFDTDSimulationException(ss.str());
+      }
+
+      e->insert(e->end(), h->begin(), h->end());
+      for (const auto& r : *e) {
+        if (intersected(r, footprint)) {
+          std::stringstream ss;
+          ss << "Subgrid " << s->name() << ": a corrector acts on "
+             << r.toString() << ", inside the subgrid box and its stencil "
+             << footprint.toString()
+             << ". Move the box away from sources, PML and TFSF.";
+          throw XFDTDSimulationException(ss.str());
+        }
+      }
+    }
+  }
+
+  for (auto&& d : _domains) {
+    if (!d->isMaster()) {
+      continue;
+    }
+
+    for (auto&& s : _subgrids) {
+      d->addCorrector(std::make_unique<SubgridCorrector>(s));
+    }
+  }
+
+  if (fused_updators.empty()) {
+    return;
+  }
+
+  // Every thread sweeps through the H region corrected by any domain.
+  std::vector<IndexTask> region;
+  for (const auto& d : _domains) {
+    auto r = d->correctHRegion();
+    if (!r.has_value()) {
+      return;
+    }
+
+    region.insert(region.end(), r->begin(), r->end());
+  }
+
+  for (auto&& b : fused_updators) {
+    b->setCorrectedRegion(region);
+  }
+}
+
+auto Simulation::decompositionWeights(const IndexTask& problem)
+    -> std::vector<TaskWeight<Index>> {
+  std::vector<TaskWeight<Index>> weights;
+  auto add_regions = [&weights](const Corrector* c, Real weight) {
+    if (c == nullptr || weight == 0) {
+      return;
+    }
+
+    auto regions = c->correctHRegion();
+    if (!regions.has_value()) {
+      return;
+    }
+
+    for (const auto& r : *regions) {
+      weights.emplace_back(TaskWeight<Index>{r, weight});
+    }
+  };
+
+  for (const auto& b : _boundaries) {
+    auto c = b->generateDomainCorrector(problem);
+    add_regions(c.get(), _pml_cost);
+  }
+  for (const auto& w : _waveform_sources) {
+    auto c = w->generateCorrector(problem);
+    add_regions(c.get(), _surface_cost);
+  }
+
+  if (_dispersive_cost != 0) {
+    for (const auto& o : _objects) {
+      if (o->material() == nullptr || !o->material()->dispersion() ||
+          std::dynamic_pointer_cast<PecPlane>(o) != nullptr) {
+        continue;
+      }
+
+      for (const auto& r : o->voxelRows()) {
+        weights.emplace_back(TaskWeight<Index>{
+            makeIndexTask(makeIndexRange(r._i, r._i + 1),
+                          makeIndexRange(r._j, r._j + 1),
+                          makeIndexRange(r._k_start, r._k_end)),
+            _dispersive_cost});
+      }
+    }
+  }
+
+  if (_surface_cost != 0) {
+    // Only the sharded ones are spread over the threads
+    for (const auto& m : _monitors) {
+      if (m->shardable() && m->nodeTask().valid()) {
+        weights.emplace_back(TaskWeight<Index>{m->nodeTask(), _surface_cost});
+      }
+    }
+    for (const auto& n : _nfffts) {
+      if (!n->shardable()) {
+        continue;
+      }
+
+      for (const auto& t :
+           {n->nodeTaskSurfaceXN(), n->nodeTaskSurfaceXP(),
+            n->nodeTaskSurfaceYN(), n->nodeTaskSurfaceYP(),
+            n->nodeTaskSurfaceZN(), n->nodeTaskSurfaceZP()}) {
+        if (t.valid()) {
+          weights.emplace_back(TaskWeight<Index>{t, _surface_cost});
+        }
+      }
+    }
+  }
+
+  return weights;
 }
 
 void Simulation::generateGridSpace() {
@@ -505,8 +804,14 @@ void Simulation::generateGridSpace() {
     boundaries.emplace_back(b.get());
   }
 
-  _global_grid_space = GridSpaceGenerator::generateUniformGridSpace(
-      shapes, boundaries, _dx, _dy, _dz);
+  if (_max_ratio != 0) {
+    _global_grid_space = GridSpaceGenerator::generateGradedGridSpace(
+        shapes, boundaries, _dx, _dy, _dz, _min_dx, _min_dy, _min_dz,
+        _max_ratio);
+  } else {
+    _global_grid_space = GridSpaceGenerator::generateUniformGridSpace(
+        shapes, boundaries, _dx, _dy, _dz);
+  }
 
   _global_grid_space->correctGridSpace();
 }
@@ -606,6 +911,24 @@ void Simulation::generateFDTDUpdateCoefficient() {
 }
 
 void Simulation::correctMaterialSpace() {
+  // Voxelize all objects together on every thread. The cells are still
+  // assigned object by object, so a later object overrides an earlier one.
+  auto voxelized = std::vector<Object*>{};
+  auto shapes = std::vector<const Shape*>{};
+  for (auto&& o : _objects) {
+    if (std::dynamic_pointer_cast<PecPlane>(o) != nullptr) {
+      continue;
+    }
+
+    voxelized.emplace_back(o.get());
+    shapes.emplace_back(o->shape().get());
+  }
+  auto rows = voxelize(_grid_space.get(), shapes,
+                       static_cast<std::size_t>(numThread()));
+  for (std::size_t n{0}; n < voxelized.size(); ++n) {
+    voxelized[n]->setVoxelRows(std::move(rows[n]));
+  }
+
   Index m_index = {0};
   for (auto&& o : _objects) {
     if (std::dynamic_pointer_cast<PecPlane>(o) != nullptr) {
@@ -651,6 +974,156 @@ void Simulation::correctUpdateCoefficient() {
   buildDispersiveSpace();
 }
 
+auto Simulation::compressCoefficient() -> void {
+  if (!_calculation_param->fdtdCoefficient()->compress()) {
+    std::stringstream ss;
+    ss << "Rank " << myRank()
+       << ": too many coefficient classes, keep the full coefficient grids\n";
+    std::cerr << ss.str();
+    return;
+  }
+
+  // Nothing reads the material grids after the coefficients are corrected.
+  _calculation_param->materialParam()->release();
+}
+
+auto Simulation::firstTouch() -> void {
+  // The arrays were written by this thread during init, so their pages live
+  // in its NUMA node. Copy every array into a fresh allocation slab by slab
+  // from the pinned workers; a page is placed where it is first written.
+  const auto nx = _grid_space->sizeX();
+  const auto ny = _grid_space->sizeY();
+  const auto nz = _grid_space->sizeZ();
+  auto touch = [&](auto& arr) {
+    if (arr.size() == 0) {
+      return;
+    }
+
+    auto fresh = std::decay_t<decltype(arr)>(arr.shape());
+    _thread_pool->run([&](std::size_t id) {
+      copyTaskSlab(fresh, arr, _domains[id]->task(), nx, ny, nz);
+    });
+    arr = std::move(fresh);
+  };
+
+  for (auto* f : {&_emf->ex(), &_emf->ey(), &_emf->ez(), &_emf->hx(),
+                  &_emf->hy(), &_emf->hz()}) {
+    touch(*f);
+  }
+  _calculation_param->fdtdCoefficient()->forEachGrid(touch);
+}
+
+auto Simulation::checkpointPath(const std::string& dir) const -> std::string {
+  return (std::filesystem::path{dir} /
+          ("rank_" + std::to_string(myRank()) + ".xckp"))
+      .string();
+}
+
+auto Simulation::captureCheckpoint() const -> Checkpoint {
+  Checkpoint checkpoint;
+  checkpoint.setStep(_calculation_param->timeParam()->currentTimeStep());
+  checkpoint.saveValue<Index>("num_rank", numNode());
+
+  checkpoint.save("emf/ex", _emf->ex());
+  checkpoint.save("emf/ey", _emf->ey());
+  checkpoint.save("emf/ez", _emf->ez());
+  checkpoint.save("emf/hx", _emf->hx());
+  checkpoint.save("emf/hy", _emf->hy());
+  checkpoint.save("emf/hz", _emf->hz());
+
+  for (std::size_t i{0}; i < _boundaries.size(); ++i) {
+    _boundaries[i]->saveState(checkpoint,
+                              "boundary/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _objects.size(); ++i) {
+    _objects[i]->saveState(checkpoint, "object/" + std::to_string(i) + "/");
+  }
+  if (_ade_method_storage != nullptr) {
+    _ade_method_storage->saveState(checkpoint, "ade/");
+  }
+  for (std::size_t i{0}; i < _monitors.size(); ++i) {
+    _monitors[i]->saveState(checkpoint, "monitor/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _nfffts.size(); ++i) {
+    _nfffts[i]->saveState(checkpoint, "nffft/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _subgrids.size(); ++i) {
+    _subgrids[i]->saveState(checkpoint,
+                            "subgrid/" + std::to_string(i) + "/");
+  }
+
+  return checkpoint;
+}
+
+auto Simulation::restoreCheckpoint(const Checkpoint& checkpoint) -> void {
+  if (checkpoint.loadValue<Index>("num_rank") !=
+      static_cast<Index>(numNode())) {
+    throw XFDTDSimulationException(
+        "Checkpoint was saved with a different number of ranks");
+  }
+
+  checkpoint.load("emf/ex", _emf->ex());
+  checkpoint.load("emf/ey", _emf->ey());
+  checkpoint.load("emf/ez", _emf->ez());
+  checkpoint.load("emf/hx", _emf->hx());
+  checkpoint.load("emf/hy", _emf->hy());
+  checkpoint.load("emf/hz", _emf->hz());
+
+  for (std::size_t i{0}; i < _boundaries.size(); ++i) {
+    _boundaries[i]->loadState(checkpoint,
+                              "boundary/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _objects.size(); ++i) {
+    _objects[i]->loadState(checkpoint, "object/" + std::to_string(i) + "/");
+  }
+  if (_ade_method_storage != nullptr) {
+    _ade_method_storage->loadState(checkpoint, "ade/");
+  }
+  for (std::size_t i{0}; i < _monitors.size(); ++i) {
+    _monitors[i]->loadState(checkpoint, "monitor/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _nfffts.size(); ++i) {
+    _nfffts[i]->loadState(checkpoint, "nffft/" + std::to_string(i) + "/");
+  }
+  for (std::size_t i{0}; i < _subgrids.size(); ++i) {
+    _subgrids[i]->loadState(checkpoint,
+                            "subgrid/" + std::to_string(i) + "/");
+  }
+
+  _calculation_param->timeParam()->setCurrentTimeStep(checkpoint.step());
+  // Sources that keep per step state (the on the fly TFSF line) catch up.
+  for (auto&& w : _waveform_sources) {
+    w->nextStep();
+  }
+}
+
+auto Simulation::writeCheckpoint(const Checkpoint& checkpoint,
+                                 const std::string& dir) const -> void {
+  std::filesystem::create_directories(dir);
+  // Write next to the old file and rename, so a crash while writing keeps the
+  // previous checkpoint.
+  const auto path = checkpointPath(dir);
+  checkpoint.write(path + ".tmp");
+  std::filesystem::rename(path + ".tmp", path);
+}
+
+auto Simulation::beginCheckpoint() -> void {
+  // Only one snapshot is kept in memory: a write still in flight finishes
+  // first.
+  waitCheckpoint();
+  _checkpoint_writing = std::async(
+      std::launch::async,
+      [this, checkpoint = captureCheckpoint()]() {
+        writeCheckpoint(checkpoint, _checkpoint_dir);
+      });
+}
+
+auto Simulation::waitCheckpoint() -> void {
+  if (_checkpoint_writing.valid()) {
+    _checkpoint_writing.get();
+  }
+}
+
 std::unique_ptr<TimeParam> Simulation::makeTimeParam() {
   auto time_param = std::make_unique<TimeParam>(_cfl);
   switch (_grid_space->dimension()) {
@@ -695,6 +1168,12 @@ std::unique_ptr<Updator> Simulation::makeUpdator(const IndexTask& task) {
   }
 
   if (!dispersion) {
+    if (_grid_space->dimension() == GridSpace::Dimension::THREE &&
+        _fused_sweep_tile_size != 0) {
+      return std::make_unique<FusedSweepUpdator3D>(
+          _grid_space, _calculation_param, _emf, task,
+          _fused_sweep_tile_size);
+    }
     if (_grid_space->dimension() == GridSpace::Dimension::THREE) {
       return std::make_unique<BasicUpdator3D>(_grid_space, _calculation_param,
                                               _emf, task);
@@ -712,6 +1191,11 @@ std::unique_ptr<Updator> Simulation::makeUpdator(const IndexTask& task) {
   // Contains linear dispersive material
   if (dispersion && _grid_space->dimension() == GridSpace::Dimension::THREE &&
       _ade_method_storage != nullptr) {
+    if (_ade_method_storage->sparse()) {
+      return std::make_unique<SparseADEUpdator3D>(
+          _grid_space, _calculation_param, _emf, task, _ade_method_storage);
+    }
+
     auto drude_ade_method_storage =
         std::dynamic_pointer_cast<DrudeADEMethodStorage>(_ade_method_storage);
     auto debye_ade_method_storage =
@@ -808,13 +1292,18 @@ auto Simulation::buildDispersiveSpace() -> void {
   auto is_only_debye = !is_drude && is_debye && !is_lor;
 
   std::shared_ptr<ADEMethodStorage> storage{};
+  const auto sparse = _sparse_dispersion &&
+                      _grid_space->dimension() == GridSpace::Dimension::THREE;
 
   if (is_only_drude) {
-    storage = std::make_shared<DrudeADEMethodStorage>(num_pole, nx, ny, nz);
+    storage =
+        std::make_shared<DrudeADEMethodStorage>(num_pole, nx, ny, nz, sparse);
   } else if (is_only_debye) {
-    storage = std::make_shared<DebyeADEMethodStorage>(num_pole, nx, ny, nz);
+    storage =
+        std::make_shared<DebyeADEMethodStorage>(num_pole, nx, ny, nz, sparse);
   } else {
-    storage = std::make_shared<MLorentzADEMethodStorage>(num_pole, nx, ny, nz);
+    storage = std::make_shared<MLorentzADEMethodStorage>(num_pole, nx, ny, nz,
+                                                         sparse);
   }
 
   if (storage == nullptr) {
@@ -825,6 +1314,28 @@ auto Simulation::buildDispersiveSpace() -> void {
     o->handleDispersion(storage);
   }
 
+  if (sparse) {
+    // The last object wins a node, so gather from the final material indices
+    // rather than from the objects.
+    const auto& materials = _calculation_param->materialParam()->materialArray();
+    const auto dt = _calculation_param->timeParam()->dt();
+    for (const auto& g : _grid_space->gridWithMaterial()) {
+      const auto index = g.materialIndex();
+      if (index >= materials.size() || !materials[index]->dispersion()) {
+        continue;
+      }
+
+      auto dispersive_material =
+          std::dynamic_pointer_cast<LinearDispersiveMaterial>(materials[index]);
+      if (dispersive_material == nullptr) {
+        continue;
+      }
+
+      storage->addSparseCell(g.i(), g.j(), g.k(), index, *dispersive_material,
+                             dt);
+    }
+  }
+
   _ade_method_storage = storage;
 }
 
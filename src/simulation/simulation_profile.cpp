@@ -0,0 +1,209 @@
+#include <xfdtd/simulation/simulation_profile.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace xfdtd {
+
+auto profilePhaseToString(ProfilePhase phase) -> std::string_view {
+  switch (phase) {
+    case ProfilePhase::UPDATE_H:
+      return "updateH";
+    case ProfilePhase::CORRECT_H:
+      return "correctH";
+    case ProfilePhase::EXCHANGE_H:
+      return "exchangeH";
+    case ProfilePhase::UPDATE_E:
+      return "updateE";
+    case ProfilePhase::CORRECT_E:
+      return "correctE";
+    case ProfilePhase::RECORD:
+      return "record";
+    case ProfilePhase::NEXT_STEP:
+      return "nextStep";
+    case ProfilePhase::BARRIER:
+      return "barrier";
+    default:
+      return "unknown";
+  }
+}
+
+static auto jsonEscape(std::string_view s) -> std::string {
+  std::string out;
+  out.reserve(s.size());
+  for (const auto c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+// Inside a quoted CSV field a quote is doubled, nothing else is escaped
+static auto csvEscape(std::string_view s) -> std::string {
+  std::string out;
+  out.reserve(s.size());
+  for (const auto c : s) {
+    if (c == '"') {
+      out += '"';
+    }
+    out += c;
+  }
+  return out;
+}
+
+static auto openFile(const std::string& path) -> std::ofstream {
+  std::ofstream ofs{path};
+  if (!ofs) {
+    std::stringstream ss;
+    ss << "StepProfiler: can't open " << path;
+    throw XFDTDProfileException{ss.str()};
+  }
+  return ofs;
+}
+
+StepProfiler::StepProfiler(Index trace_steps) : _trace_steps{trace_steps} {}
+
+auto StepProfiler::profileStart(int rank, std::size_t num_thread) -> void {
+  _rank = rank;
+  _origin = ProfileEvent::Clock::now();
+  _threads.assign(num_thread, ThreadData{});
+}
+
+auto StepProfiler::profileEvent(const ProfileEvent& event) -> void {
+  if (_threads.size() <= event._thread) {
+    return;
+  }
+
+  // Only this thread touches its data
+  auto& data = _threads[event._thread];
+  const auto seconds =
+      std::chrono::duration<double>(event._end - event._start).count();
+
+  auto it = std::find_if(data._entries.begin(), data._entries.end(),
+                         [&event](const Entry& e) {
+                           return e._phase == event._phase &&
+                                  e._name == event._name;
+                         });
+  if (it == data._entries.end()) {
+    data._entries.push_back(Entry{event._rank, event._thread, event._phase,
+                                  std::string{event._name}, 0, 0,
+                                  std::numeric_limits<double>::max(), 0});
+    it = data._entries.end() - 1;
+  }
+
+  ++it->_count;
+  it->_total += seconds;
+  it->_min = std::min(it->_min, seconds);
+  it->_max = std::max(it->_max, seconds);
+
+  if (!data._started) {
+    data._first_step = event._step;
+    data._started = true;
+  }
+
+  if (event._step < data._first_step + _trace_steps) {
+    const auto start = std::chrono::duration<double, std::micro>(
+                           event._start - _origin)
+                           .count();
+    const auto duration =
+        std::chrono::duration<double, std::micro>(event._end - event._start)
+            .count();
+    data._trace.push_back(
+        TraceEvent{event._phase, std::string{event._name}, start, duration});
+  }
+}
+
+auto StepProfiler::summary() const -> std::vector<Entry> {
+  std::vector<Entry> entries;
+  for (const auto& t : _threads) {
+    entries.insert(entries.end(), t._entries.begin(), t._entries.end());
+  }
+
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& a, const Entry& b) {
+                     if (a._thread != b._thread) {
+                       return a._thread < b._thread;
+                     }
+                     return a._phase < b._phase;
+                   });
+  return entries;
+}
+
+auto StepProfiler::toString() const -> std::string {
+  std::stringstream ss;
+  ss << "Profile of rank " << _rank << "\n";
+  ss << std::left << std::setw(8) << "thread" << std::setw(12) << "phase"
+     << std::setw(40) << "instance" << std::right << std::setw(10) << "count"
+     << std::setw(14) << "total(s)" << std::setw(14) << "mean(us)"
+     << std::setw(14) << "max(us)" << "\n";
+  for (const auto& e : summary()) {
+    const auto mean = e._count == 0 ? 0.0 : e._total / e._count;
+    ss << std::left << std::setw(8) << e._thread << std::setw(12)
+       << profilePhaseToString(e._phase) << std::setw(40)
+       << (e._name.empty() ? std::string{"-"} : e._name.substr(0, 39))
+       << std::right << std::setw(10) << e._count << std::setw(14)
+       << std::fixed << std::setprecision(6) << e._total << std::setw(14)
+       << std::setprecision(3) << mean * 1e6 << std::setw(14)
+       << e._max * 1e6 << "\n";
+  }
+  return ss.str();
+}
+
+auto StepProfiler::writeSummaryJson(const std::string& path) const -> void {
+  auto ofs = openFile(path);
+  ofs << std::setprecision(9);
+  ofs << "{\"rank\": " << _rank << ", \"entries\": [";
+  bool first = true;
+  for (const auto& e : summary()) {
+    ofs << (first ? "\n" : ",\n");
+    first = false;
+    ofs << "  {\"rank\": " << e._rank << ", \"thread\": " << e._thread
+        << ", \"phase\": \"" << profilePhaseToString(e._phase)
+        << "\", \"name\": \"" << jsonEscape(e._name) << "\", \"count\": "
+        << e._count << ", \"total\": " << e._total << ", \"min\": "
+        << (e._count == 0 ? 0.0 : e._min) << ", \"max\": " << e._max << "}";
+  }
+  ofs << "\n]}\n";
+}
+
+auto StepProfiler::writeSummaryCsv(const std::string& path) const -> void {
+  auto ofs = openFile(path);
+  ofs << std::setprecision(9);
+  ofs << "rank,thread,phase,name,count,total,min,max\n";
+  for (const auto& e : summary()) {
+    ofs << e._rank << "," << e._thread << "," << profilePhaseToString(e._phase)
+        << ",\"" << csvEscape(e._name) << "\"," << e._count << "," << e._total
+        << "," << (e._count == 0 ? 0.0 : e._min) << "," << e._max << "\n";
+  }
+}
+
+auto StepProfiler::writeChromeTrace(const std::string& path) const -> void {
+  auto ofs = openFile(path);
+  ofs << std::fixed << std::setprecision(3);
+  ofs << "{\"traceEvents\": [";
+  bool first = true;
+  for (std::size_t t{0}; t < _threads.size(); ++t) {
+    for (const auto& e : _threads[t]._trace) {
+      ofs << (first ? "\n" : ",\n");
+      first = false;
+      const auto phase = profilePhaseToString(e._phase);
+      ofs << "  {\"name\": \""
+          << (e._name.empty() ? std::string{phase} : jsonEscape(e._name))
+          << "\", \"cat\": \"" << phase << "\", \"ph\": \"X\", \"ts\": "
+          << e._start << ", \"dur\": " << e._duration << ", \"pid\": " << _rank
+          << ", \"tid\": " << t << "}";
+    }
+  }
+  ofs << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+}  // namespace xfdtd
@@ -0,0 +1,125 @@
+#include "updator/ade_updator/sparse_ade_updator.h"
+
+#include <sstream>
+
+namespace xfdtd {
+
+SparseADEUpdator3D::SparseADEUpdator3D(
+    std::shared_ptr<const GridSpace> grid_space,
+    std::shared_ptr<const CalculationParam> calculation_param,
+    std::shared_ptr<EMF> emf, IndexTask task,
+    std::shared_ptr<ADEMethodStorage> ade_method_storage)
+    : BasicUpdator3D{std::move(grid_space), std::move(calculation_param),
+                     std::move(emf), task},
+      _storage{std::move(ade_method_storage)} {
+  gatherCells<Axis::XYZ::X>();
+  gatherCells<Axis::XYZ::Y>();
+  gatherCells<Axis::XYZ::Z>();
+}
+
+std::string SparseADEUpdator3D::toString() const {
+  std::stringstream ss;
+  ss << BasicUpdator3D::toString() << "\n";
+  ss << "Sparse ADE cells: " << _cells[0].size() << " " << _cells[1].size()
+     << " " << _cells[2].size();
+  return ss.str();
+}
+
+auto SparseADEUpdator3D::updateERegion(const IndexTask& task) -> void {
+  beforeYee<Axis::XYZ::X>(task);
+  beforeYee<Axis::XYZ::Y>(task);
+  beforeYee<Axis::XYZ::Z>(task);
+
+  BasicUpdator3D::updateERegion(task);
+
+  afterYee<Axis::XYZ::X>(task);
+  afterYee<Axis::XYZ::Y>(task);
+  afterYee<Axis::XYZ::Z>(task);
+}
+
+static auto contains(const IndexTask& task, Index i, Index j, Index k) {
+  auto in = [](const IndexRange& range, Index n) {
+    return range.start() <= n && n < range.end();
+  };
+
+  return in(task.xRange(), i) && in(task.yRange(), j) && in(task.zRange(), k);
+}
+
+template <Axis::XYZ xyz>
+auto SparseADEUpdator3D::gatherCells() -> void {
+  const auto& cells = _storage->sparseCells<xyz>();
+  auto& owned = _cells[static_cast<std::size_t>(xyz)];
+  const auto task = this->task();
+
+  owned.clear();
+  for (std::size_t c{0}; c < cells.size(); ++c) {
+    if (contains(task, cells._i[c], cells._j[c], cells._k[c])) {
+      owned.emplace_back(c);
+    }
+  }
+}
+
+template <Axis::XYZ xyz>
+auto SparseADEUpdator3D::beforeYee(const IndexTask& task) -> void {
+  const auto num_pole = static_cast<std::size_t>(_storage->numPole());
+  const auto& table = _storage->sparseCoeff();
+  auto& cells = _storage->sparseCells<xyz>();
+  const auto& field = _emf->field<EMF::Attribute::E, xyz>();
+
+  for (const auto c : _cells[static_cast<std::size_t>(xyz)]) {
+    if (!contains(task, cells._i[c], cells._j[c], cells._k[c])) {
+      continue;
+    }
+
+    const auto& coeff = table[cells._material[c]];
+    const auto* j = &cells._j_pole[c * num_pole];
+    const auto* j_prev = &cells._j_pole_prev[c * num_pole];
+
+    Real j_sum{0};
+    for (std::size_t p{0}; p < num_pole; ++p) {
+      j_sum += coeff._coeff_j_sum_j[p] * j[p] +
+               coeff._coeff_j_sum_j_p[p] * j_prev[p];
+    }
+
+    cells._e_cur[c] = field(cells._i[c], cells._j[c], cells._k[c]);
+    cells._e_extra[c] = coeff._coeff_e_e_p * cells._e_prev[c] +
+                        coeff._coeff_e_j_sum * j_sum;
+  }
+}
+
+template <Axis::XYZ xyz>
+auto SparseADEUpdator3D::afterYee(const IndexTask& task) -> void {
+  const auto num_pole = static_cast<std::size_t>(_storage->numPole());
+  const auto& table = _storage->sparseCoeff();
+  auto& cells = _storage->sparseCells<xyz>();
+  auto& field = _emf->field<EMF::Attribute::E, xyz>();
+
+  for (const auto c : _cells[static_cast<std::size_t>(xyz)]) {
+    if (!contains(task, cells._i[c], cells._j[c], cells._k[c])) {
+      continue;
+    }
+
+    const auto& coeff = table[cells._material[c]];
+    auto* j = &cells._j_pole[c * num_pole];
+    auto* j_prev = &cells._j_pole_prev[c * num_pole];
+
+    auto& e = field(cells._i[c], cells._j[c], cells._k[c]);
+    e += cells._e_extra[c];
+
+    const auto e_next = e;
+    const auto e_cur = cells._e_cur[c];
+    const auto e_prev = cells._e_prev[c];
+    for (std::size_t p{0}; p < num_pole; ++p) {
+      const auto j_next =
+          coeff._coeff_j_e_n[p] * e_next + coeff._coeff_j_e[p] * e_cur +
+          coeff._coeff_j_e_p[p] * e_prev + coeff._coeff_j_j[p] * j[p] +
+          coeff._coeff_j_j_p[p] * j_prev[p];
+      j_prev[p] = j[p];
+      j[p] = j_next;
+    }
+
+    cells._e_prev[c] = e_cur;
+  }
+}
+
+}  // namespace xfdtd
@@ -93,14 +93,15 @@ void BasicUpdatorTEM::updateE() {
   const auto ks = task().zRange().start() == 0 ? 1 : task().zRange().start();
   const auto ke = basic::GridStructure::exFDTDUpdateZEnd(task().zRange().end());
 
-  const auto& cexe{_calculation_param->fdtdCoefficient()->cexe()};
-  const auto& cexhy{_calculation_param->fdtdCoefficient()->cexhy()};
+  const auto& coefficient{*_calculation_param->fdtdCoefficient()};
 
   const auto& hy{_emf->hy()};
   auto& ex{_emf->ex()};
 
   for (std::size_t k{ks}; k < ke; ++k) {
-    ex(0, 0, k) = eNext(cexe(0, 0, k), ex(0, 0, k), cexhy(0, 0, k), hy(0, 0, k),
+    const auto cf =
+        coefficient.at<EMF::Attribute::E, Axis::XYZ::X>(0, 0, k);
+    ex(0, 0, k) = eNext(cf._c, ex(0, 0, k), cf._c_a, hy(0, 0, k),
                         hy(0, 0, k - 1), static_cast<Real>(0.0),
                         static_cast<Real>(0.0), static_cast<Real>(0.0));
   }
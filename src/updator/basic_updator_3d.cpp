@@ -35,9 +35,24 @@ std::string BasicUpdator3D::toString() const {
   return ss.str();
 }
 
-void BasicUpdator3D::updateE() {
-  const auto task = this->task();
+void BasicUpdator3D::updateE() { updateERegion(task()); }
 
+auto BasicUpdator3D::updateEInterior(const IndexTask& interior) -> void {
+  const auto region = taskIntersection(task(), interior);
+  if (!region.has_value()) {
+    return;
+  }
+
+  updateERegion(*region);
+}
+
+auto BasicUpdator3D::updateERim(const IndexTask& interior) -> void {
+  for (const auto& region : taskDifference(task(), interior)) {
+    updateERegion(region);
+  }
+}
+
+auto BasicUpdator3D::updateERegion(const IndexTask& task) -> void {
   auto is = basic::GridStructure::exFDTDUpdateXStart(task.xRange().start());
   auto ie = basic::GridStructure::exFDTDUpdateXEnd(task.xRange().end());
   auto js = task.yRange().start() == 0 ? 1 : task.yRange().start();
@@ -0,0 +1,236 @@
+#include "updator/fused_sweep_updator.h"
+
+#include <xfdtd/util/fdtd_basic.h>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "updator/update_kernel.h"
+
+namespace xfdtd {
+
+FusedSweepUpdator3D::FusedSweepUpdator3D(
+    std::shared_ptr<const GridSpace> grid_space,
+    std::shared_ptr<const CalculationParam> calculation_param,
+    std::shared_ptr<EMF> emf, IndexTask task, Index tile_size)
+    : BasicUpdator3D(std::move(grid_space), std::move(calculation_param),
+                     std::move(emf), task),
+      _tile_size{tile_size == 0 ? Index{1} : tile_size} {}
+
+std::string FusedSweepUpdator3D::toString() const {
+  std::stringstream ss;
+  ss << BasicUpdator3D::toString() << "\n";
+  ss << "Fused sweep: " << (_fused ? "on" : "off")
+     << " tile size: " << _tile_size;
+  return ss.str();
+}
+
+template <Axis::XYZ xyz>
+auto FusedSweepUpdator3D::eUpdateTask() const -> IndexTask {
+  // Same ranges as BasicUpdator3D::updateE
+  const auto x_range = task().xRange();
+  const auto y_range = task().yRange();
+  const auto z_range = task().zRange();
+  auto skip_zero = [](const IndexRange& range) {
+    return makeIndexRange(range.start() == 0 ? 1 : range.start(), range.end());
+  };
+
+  if constexpr (xyz == Axis::XYZ::X) {
+    return makeIndexTask(x_range, skip_zero(y_range), skip_zero(z_range));
+  } else if constexpr (xyz == Axis::XYZ::Y) {
+    return makeIndexTask(skip_zero(x_range), y_range, skip_zero(z_range));
+  } else {
+    return makeIndexTask(skip_zero(x_range), skip_zero(y_range), z_range);
+  }
+}
+
+template <Axis::XYZ xyz>
+auto FusedSweepUpdator3D::buildRows(
+    const std::vector<IndexTask>& excluded) -> void {
+  auto& rows = _rows[kernel::axisIndex<xyz>()];
+  rows._task = eUpdateTask<xyz>();
+  rows._row_offset.clear();
+  rows._segments.clear();
+
+  const auto& t = rows._task;
+  const auto ks = t.zRange().start();
+  const auto ke = t.zRange().end();
+
+  std::vector<std::pair<Index, Index>> holes;
+  rows._row_offset.emplace_back(0);
+  for (Index i = t.xRange().start(); i < t.xRange().end(); ++i) {
+    for (Index j = t.yRange().start(); j < t.yRange().end(); ++j) {
+      holes.clear();
+      for (const auto& b : excluded) {
+        if (i < b.xRange().start() || b.xRange().end() <= i ||
+            j < b.yRange().start() || b.yRange().end() <= j) {
+          continue;
+        }
+
+        auto s = std::max(ks, b.zRange().start());
+        auto e = std::min(ke, b.zRange().end());
+        if (s < e) {
+          holes.emplace_back(s, e);
+        }
+      }
+
+      std::sort(holes.begin(), holes.end());
+      auto k = ks;
+      for (const auto& [s, e] : holes) {
+        if (e <= k) {
+          continue;
+        }
+
+        if (k < s) {
+          rows._segments.push_back({k, s, true});
+        }
+
+        rows._segments.push_back({std::max(k, s), e, false});
+        k = e;
+      }
+
+      if (k < ke) {
+        rows._segments.push_back({k, ke, true});
+      }
+
+      rows._row_offset.emplace_back(rows._segments.size());
+    }
+  }
+}
+
+auto FusedSweepUpdator3D::setCorrectedRegion(
+    const std::vector<IndexTask>& region) -> void {
+  std::vector<IndexTask> excluded;
+  excluded.reserve(region.size() + 3);
+
+  // E reads H at the node itself and the previous node, and correctH() may
+  // read E at the next node. One cell around the region is enough.
+  auto dilate = [](const IndexRange& range) {
+    return makeIndexRange(range.start() == 0 ? 0 : range.start() - 1,
+                          range.end() + 1);
+  };
+  for (const auto& r : region) {
+    excluded.emplace_back(
+        makeIndexTask(dilate(r.xRange()), dilate(r.yRange()),
+                      dilate(r.zRange())));
+  }
+
+  // The first slab of the task reads H updated by another thread, and that
+  // thread reads E of this slab in its own updateH().
+  const auto x_range = task().xRange();
+  const auto y_range = task().yRange();
+  const auto z_range = task().zRange();
+  const auto whole_x = makeIndexRange(x_range.start(), x_range.end() + 1);
+  const auto whole_y = makeIndexRange(y_range.start(), y_range.end() + 1);
+  const auto whole_z = makeIndexRange(z_range.start(), z_range.end() + 1);
+  if (x_range.start() != 0) {
+    excluded.emplace_back(makeIndexTask(
+        makeIndexRange(x_range.start(), x_range.start() + 1), whole_y,
+        whole_z));
+  }
+  if (y_range.start() != 0) {
+    excluded.emplace_back(makeIndexTask(
+        whole_x, makeIndexRange(y_range.start(), y_range.start() + 1),
+        whole_z));
+  }
+  if (z_range.start() != 0) {
+    excluded.emplace_back(makeIndexTask(
+        whole_x, whole_y,
+        makeIndexRange(z_range.start(), z_range.start() + 1)));
+  }
+
+  buildRows<Axis::XYZ::X>(excluded);
+  buildRows<Axis::XYZ::Y>(excluded);
+  buildRows<Axis::XYZ::Z>(excluded);
+  _fused = true;
+}
+
+template <Axis::XYZ xyz>
+auto FusedSweepUpdator3D::updateERow(Index i, Index j,
+                                           bool fused) -> void {
+  const auto& rows = _rows[kernel::axisIndex<xyz>()];
+  const auto& t = rows._task;
+  if (i < t.xRange().start() || t.xRange().end() <= i ||
+      j < t.yRange().start() || t.yRange().end() <= j) {
+    return;
+  }
+
+  const auto r = (i - t.xRange().start()) * t.yRange().size() +
+                 (j - t.yRange().start());
+  for (auto s = rows._row_offset[r]; s < rows._row_offset[r + 1]; ++s) {
+    const auto& seg = rows._segments[s];
+    if (seg._fused != fused) {
+      continue;
+    }
+
+    kernel::update<EMF::Attribute::E, xyz>(
+        *_emf, *_calculation_param->fdtdCoefficient(), i, i + 1, j, j + 1,
+        seg._start, seg._end);
+  }
+}
+
+void FusedSweepUpdator3D::updateH() {
+  if (!_fused) {
+    BasicUpdator3D::updateH();
+    return;
+  }
+
+  const auto task = this->task();
+  const auto is = basic::GridStructure::hFDTDUpdateXStart(task.xRange().start());
+  const auto ie = basic::GridStructure::hFDTDUpdateXEnd(task.xRange().end());
+  const auto js = basic::GridStructure::hFDTDUpdateYStart(task.yRange().start());
+  const auto je = basic::GridStructure::hFDTDUpdateYEnd(task.yRange().end());
+  const auto ks = basic::GridStructure::hFDTDUpdateZStart(task.zRange().start());
+  const auto ke = basic::GridStructure::hFDTDUpdateZEnd(task.zRange().end());
+
+  auto& coefficient = *_calculation_param->fdtdCoefficient();
+
+  // Tiles are swept in increasing j and every tile in increasing i, so H at
+  // (i - 1) and (j - 1) is already new when E at (i, j) is advanced, and E at
+  // (i + 1) and (j + 1) is still old when H at (i, j) reads it.
+  for (Index jb = js; jb < je; jb += _tile_size) {
+    const auto jt = std::min(jb + _tile_size, je);
+    for (Index i = is; i < ie; ++i) {
+      kernel::update<EMF::Attribute::H, Axis::XYZ::X>(*_emf, coefficient, i,
+                                                      i + 1, jb, jt, ks, ke);
+      kernel::update<EMF::Attribute::H, Axis::XYZ::Y>(*_emf, coefficient, i,
+                                                      i + 1, jb, jt, ks, ke);
+      kernel::update<EMF::Attribute::H, Axis::XYZ::Z>(*_emf, coefficient, i,
+                                                      i + 1, jb, jt, ks, ke);
+
+      for (Index j = jb; j < jt; ++j) {
+        updateERow<Axis::XYZ::X>(i, j, true);
+        updateERow<Axis::XYZ::Y>(i, j, true);
+        updateERow<Axis::XYZ::Z>(i, j, true);
+      }
+    }
+  }
+}
+
+void FusedSweepUpdator3D::updateE() {
+  if (!_fused) {
+    BasicUpdator3D::updateE();
+    return;
+  }
+
+  auto update_deferred = [](const IndexTask& t, auto&& f) {
+    for (Index i = t.xRange().start(); i < t.xRange().end(); ++i) {
+      for (Index j = t.yRange().start(); j < t.yRange().end(); ++j) {
+        f(i, j);
+      }
+    }
+  };
+
+  update_deferred(_rows[0]._task, [this](Index i, Index j) {
+    updateERow<Axis::XYZ::X>(i, j, false);
+  });
+  update_deferred(_rows[1]._task, [this](Index i, Index j) {
+    updateERow<Axis::XYZ::Y>(i, j, false);
+  });
+  update_deferred(_rows[2]._task, [this](Index i, Index j) {
+    updateERow<Axis::XYZ::Z>(i, j, false);
+  });
+}
+
+}  // namespace xfdtd
@@ -12,15 +12,14 @@ MLorentzUpdator::MLorentzUpdator(
     : BasicUpdator3D(grid_space, calculation_param, emf, task),
       _m_lor_ade_method_storage{m_lor_ade_method_storage} {}
 
-auto MLorentzUpdator::updateE() -> void {
-  this->updateE<Axis::XYZ::X>();
-  this->updateE<Axis::XYZ::Y>();
-  this->updateE<Axis::XYZ::Z>();
+auto MLorentzUpdator::updateERegion(const IndexTask& task) -> void {
+  this->updateE<Axis::XYZ::X>(task);
+  this->updateE<Axis::XYZ::Y>(task);
+  this->updateE<Axis::XYZ::Z>(task);
 }
 
 template <Axis::XYZ xyz>
-auto MLorentzUpdator::updateE() -> void {
-  const auto task = this->task();
+auto MLorentzUpdator::updateE(const IndexTask& task) -> void {
   const auto& update_coefficient = this->calculationParam()->fdtdCoefficient();
   auto&& emf = this->emf();
 
@@ -29,11 +28,6 @@ auto MLorentzUpdator::updateE() -> void {
   constexpr auto xzy_a = Axis::tangentialAAxis<xyz>();  // !
   constexpr auto xzy_b = Axis::tangentialBAxis<xyz>();
 
-  const auto& cfcf = update_coefficient->coeff<attribute, xyz>();
-  const auto& cf_a =
-      update_coefficient->coeff<attribute, xyz, dual_attribute, xzy_a>();
-  const auto& cf_b =
-      update_coefficient->coeff<attribute, xyz, dual_attribute, xzy_b>();
 
   auto&& field = emf->field<attribute, xyz>();
   const auto& field_a = emf->field<dual_attribute, xzy_a>();
@@ -75,12 +69,14 @@ auto MLorentzUpdator::updateE() -> void {
         const auto e_prev = ePrevious<xyz>(i, j, k);
         const auto coeff_e_e_p = coeffEPrev(i, j, k);
 
+        const auto cf = update_coefficient->at<attribute, xyz>(i, j, k);
+
         const auto e_cur = field(i, j, k);
         field(i, j, k) =
             coeff_e_e_p * e_prev +
-            eNext(cfcf(i, j, k), field(i, j, k), cf_a(i, j, k),
-                  field_a(i, j, k), field_a(i_a, j_a, k_a), cf_b(i, j, k),
-                  field_b(i, j, k), field_b(i_b, j_b, k_b)) +
+            eNext(cf._c, field(i, j, k), cf._c_a, field_a(i, j, k),
+                  field_a(i_a, j_a, k_a), cf._c_b, field_b(i, j, k),
+                  field_b(i_b, j_b, k_b)) +
             coeff_e_j_sum(i, j, k) * j_sum;
         updateJ<xyz>(i, j, k, field(i, j, k), e_cur);
 
@@ -149,9 +145,12 @@ auto MLorentzUpdator::coeffEPrev(Index i, Index j, Index k) const -> Real {
 }
 
 // explicit instantiation
-template auto MLorentzUpdator::updateE<Axis::XYZ::X>() -> void;
-template auto MLorentzUpdator::updateE<Axis::XYZ::Y>() -> void;
-template auto MLorentzUpdator::updateE<Axis::XYZ::Z>() -> void;
+template auto MLorentzUpdator::updateE<Axis::XYZ::X>(const IndexTask& task)
+    -> void;
+template auto MLorentzUpdator::updateE<Axis::XYZ::Y>(const IndexTask& task)
+    -> void;
+template auto MLorentzUpdator::updateE<Axis::XYZ::Z>(const IndexTask& task)
+    -> void;
 
 template auto MLorentzUpdator::calculateJSum<Axis::XYZ::X>(Index i, Index j,
                                                            Index k) -> Real;
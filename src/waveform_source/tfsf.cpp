@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <xtensor/xview.hpp>
 
 #include "xfdtd/common/type_define.h"
 #include "xfdtd/coordinate_system/coordinate_system.h"
@@ -37,44 +38,93 @@ void TFSF::initTimeDependentVariable() {
   waveform()->init(calculationParamPtr()->timeParam()->eTime() -
                    calculationParamPtr()->timeParam()->dt());
 
-  auto fdtd_1d = [](auto&& e, auto&& h, const auto ceie, const auto ceih,
-                    const auto chih, const auto chie, const auto abc_coeff_0,
-                    const auto abc_coeff_1, const auto& source) {
-    const auto nt = h.shape()[0];
-    const auto nl = h.shape()[1];
+  const auto nt = calculationParamPtr()->timeParam()->size();
+  const auto rows = _incident_on_the_fly ? Index{1} : nt;
+  _e_inc = xt::zeros<Real>({rows, _auxiliary_size});
+  _h_inc = xt::zeros<Real>({rows, _auxiliary_size - 1});
 
-    e(0, 0) = source(0);
-    for (Index l = 1; l < nl; ++l) {
-      h(0, l) = chih * h(0, l) + chie * (e(0, l + 1) - e(0, l));
-    }
+  resetIncidentLine();
+  xt::row(_e_inc, 0) = _e_line;
+  xt::row(_h_inc, 0) = _h_line;
+  if (_incident_on_the_fly) {
+    return;
+  }
 
-    for (Index t = 1; t < nt; ++t) {
-      for (Index l = 1; l < nl; ++l) {
-        e(t, 0) = source(t);
-        e(t, l) = ceie * e(t - 1, l) + ceih * (h(t - 1, l) - h(t - 1, l - 1));
-      }
-
-      // abc
-      Real e_l_prev_t_prev_prev = (t < 2) ? 0.0 : e(t - 2, nl - 1);
-      Real e_l_t_prev_prev = (t < 2) ? 0.0 : e(t - 2, nl);
-      e(t, nl) = -e_l_prev_t_prev_prev +
-                 abc_coeff_0 * (e(t, nl - 1) + e_l_t_prev_prev) +
-                 abc_coeff_1 * (e(t - 1, nl) + e(t - 1, nl - 1));
-
-      for (Index l = 0; l < nl; ++l) {
-        h(t, l) = chih * h(t - 1, l) + chie * (e(t, l + 1) - e(t, l));
-      }
-    }
-  };
+  for (Index t = 1; t < nt; ++t) {
+    advanceIncidentLine();
+    xt::row(_e_inc, t) = _e_line;
+    xt::row(_h_inc, t) = _h_line;
+  }
+}
+
+void TFSF::nextStep() {
+  if (!_incident_on_the_fly) {
+    return;
+  }
+
+  const auto t = calculationParamPtr()->timeParam()->currentTimeStep();
+  if (calculationParamPtr()->timeParam()->endTimeStep() <= t) {
+    return;
+  }
+
+  if (t < _incident_step) {
+    resetIncidentLine();
+  }
+
+  while (_incident_step < t) {
+    advanceIncidentLine();
+  }
 
-  _e_inc = xt::zeros<Real>(
-      {calculationParamPtr()->timeParam()->size(), _auxiliary_size});
+  xt::row(_e_inc, 0) = _e_line;
+  xt::row(_h_inc, 0) = _h_line;
+}
+
+auto TFSF::setIncidentOnTheFly(bool on_the_fly) -> void {
+  _incident_on_the_fly = on_the_fly;
+}
+
+auto TFSF::incidentOnTheFly() const -> bool { return _incident_on_the_fly; }
+
+auto TFSF::resetIncidentLine() -> void {
+  const auto& source = waveform()->value();
+  const auto nl = _auxiliary_size - 1;
+
+  _e_line = xt::zeros<Real>({_auxiliary_size});
+  _h_line = xt::zeros<Real>({nl});
+  _e_end_prev = {};
+  _e_end_prev_prev = {};
+  _incident_step = 0;
+
+  _e_line(0) = source(0);
+  for (Index l = 1; l < nl; ++l) {
+    _h_line(l) = _chih * _h_line(l) + _chiei * (_e_line(l + 1) - _e_line(l));
+  }
+}
 
-  _h_inc = xt::zeros<Real>(
-      {calculationParamPtr()->timeParam()->size(), _auxiliary_size - 1});
+auto TFSF::advanceIncidentLine() -> void {
+  // The 1D auxiliary grid, updated in place from step t - 1 to t.
+  const auto& source = waveform()->value();
+  const auto nl = _auxiliary_size - 1;
+  auto& e = _e_line;
+  auto& h = _h_line;
 
-  fdtd_1d(_e_inc, _h_inc, _ceie, _ceihi, _chih, _chiei, _abc_coff_0,
-          _abc_coff_1, waveform()->value());
+  ++_incident_step;
+  _e_end_prev_prev = _e_end_prev;
+  _e_end_prev = {e(nl - 1), e(nl)};
+
+  e(0) = source(_incident_step);
+  for (Index l = 1; l < nl; ++l) {
+    e(l) = _ceie * e(l) + _ceihi * (h(l) - h(l - 1));
+  }
+
+  // abc
+  e(nl) = -_e_end_prev_prev[0] +
+          _abc_coff_0 * (e(nl - 1) + _e_end_prev_prev[1]) +
+          _abc_coff_1 * (_e_end_prev[1] + _e_end_prev[0]);
+
+  for (Index l = 0; l < nl; ++l) {
+    h(l) = _chih * h(l) + _chiei * (e(l + 1) - e(l));
+  }
 }
 
 std::size_t TFSF::x() const { return _x; }
@@ -44,7 +44,7 @@ auto TFSF1D::generateCorrector(const IndexTask &task)
     return nullptr;
   }
 
-  return std::make_unique<TFSF1DCorrector>(
+  auto corrector = std::make_unique<TFSF1DCorrector>(
       intersection_task.value(), nodeTask(), globalTask(), gridSpace().get(),
       calculationParam().get(), emf().get(), &waveform()->value(),
       gridSpace()->globalBox().origin().k(), &_projection_x_int,
@@ -53,6 +53,9 @@ auto TFSF1D::generateCorrector(const IndexTask &task)
       cay(), cby(), caz(), cbz(), _transform_e.x(), _transform_e.y(),
       _transform_e.z(), _transform_h.x(), _transform_h.y(), _transform_h.z(),
       _forward);
+
+  corrector->setIncidentOnTheFly(incidentOnTheFly());
+  return corrector;
 }
 
 }  // namespace xfdtd
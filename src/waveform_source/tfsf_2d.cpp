@@ -39,7 +39,7 @@ std::unique_ptr<Corrector> TFSF2D::generateCorrector(const IndexTask &task) {
     return nullptr;
   }
 
-  return std::make_unique<TFSF2DCorrector>(
+  auto corrector = std::make_unique<TFSF2DCorrector>(
       intersection_task.value(), nodeTask(), globalTask(),
       gridSpace().get(), calculationParam().get(), emf().get(),
       &waveform()->value(), gridSpace()->globalBox().origin().i(),
@@ -48,6 +48,9 @@ std::unique_ptr<Corrector> TFSF2D::generateCorrector(const IndexTask &task) {
       &_projection_y_half, &_projection_z_half, &_e_inc, &_h_inc, cax(), cbx(),
       cay(), cby(), caz(), cbz(), _transform_e.x(), _transform_e.y(),
       _transform_e.z(), _transform_h.x(), _transform_h.y(), _transform_h.z());
+
+  corrector->setIncidentOnTheFly(incidentOnTheFly());
+  return corrector;
 }
 
 }  // namespace xfdtd
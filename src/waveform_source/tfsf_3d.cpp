@@ -32,7 +32,7 @@ std::unique_ptr<Corrector> TFSF3D::generateCorrector(const IndexTask& task) {
     return nullptr;
   }
 
-  return std::make_unique<TFSF3DCorrector>(
+  auto corrector = std::make_unique<TFSF3DCorrector>(
       intersection_task.value(), nodeTask(), globalTask(), gridSpace().get(),
       calculationParam().get(), emf().get(), &waveform()->value(),
       gridSpace()->globalBox().origin().i(),
@@ -42,6 +42,9 @@ std::unique_ptr<Corrector> TFSF3D::generateCorrector(const IndexTask& task) {
       &_projection_y_half, &_projection_z_half, &_e_inc, &_h_inc, cax(), cbx(),
       cay(), cby(), caz(), cbz(), _transform_e.x(), _transform_e.y(),
       _transform_e.z(), _transform_h.x(), _transform_h.y(), _transform_h.z());
+
+  corrector->setIncidentOnTheFly(incidentOnTheFly());
+  return corrector;
 }
 
 }  // namespace xfdtd
@@ -10,9 +10,76 @@ namespace xfdtd {
 
 std::string TFSFCorrector::toString() const {
   std::stringstream ss;
+  ss << "TFSFCorrector: " << task().toString();
   return ss.str();
 }
 
+auto TFSFCorrector::correctHRegion() const
+    -> std::optional<std::vector<IndexTask>> {
+  // task is in global index. H is corrected at c - 1 in the negative face and
+  // at c in the positive face.
+  auto to_node = [](Index v, Index offset) {
+    return v < offset ? Index{0} : v - offset;
+  };
+  auto prev = [](Index v) { return v == 0 ? Index{0} : v - 1; };
+
+  const auto is = to_node(task().xRange().start(), _node_offset_i);
+  const auto js = to_node(task().yRange().start(), _node_offset_j);
+  const auto ks = to_node(task().zRange().start(), _node_offset_k);
+  const auto ie = to_node(task().xRange().end(), _node_offset_i) + 1;
+  const auto je = to_node(task().yRange().end(), _node_offset_j) + 1;
+  const auto ke = to_node(task().zRange().end(), _node_offset_k) + 1;
+
+  auto region = std::vector<IndexTask>{};
+  if (_xn) {
+    region.emplace_back(makeIndexTask(makeIndexRange(prev(is), is + 1),
+                                      makeIndexRange(js, je),
+                                      makeIndexRange(ks, ke)));
+  }
+  if (_xp) {
+    region.emplace_back(makeIndexTask(makeIndexRange(ie - 1, ie),
+                                      makeIndexRange(js, je),
+                                      makeIndexRange(ks, ke)));
+  }
+  if (_yn) {
+    region.emplace_back(makeIndexTask(makeIndexRange(is, ie),
+                                      makeIndexRange(prev(js), js + 1),
+                                      makeIndexRange(ks, ke)));
+  }
+  if (_yp) {
+    region.emplace_back(makeIndexTask(makeIndexRange(is, ie),
+                                      makeIndexRange(je - 1, je),
+                                      makeIndexRange(ks, ke)));
+  }
+  if (_zn) {
+    region.emplace_back(makeIndexTask(makeIndexRange(is, ie),
+                                      makeIndexRange(js, je),
+                                      makeIndexRange(prev(ks), ks + 1)));
+  }
+  if (_zp) {
+    region.emplace_back(makeIndexTask(makeIndexRange(is, ie),
+                                      makeIndexRange(js, je),
+                                      makeIndexRange(ke - 1, ke)));
+  }
+
+  return region;
+}
+
+auto TFSFCorrector::correctERegion() const
+    -> std::optional<std::vector<IndexTask>> {
+  // E is corrected next to the H slabs, grow them by one node on every side
+  auto region = correctHRegion();
+  auto prev = [](Index v) { return v == 0 ? Index{0} : v - 1; };
+  for (auto&& r : *region) {
+    r = makeIndexTask(
+        makeIndexRange(prev(r.xRange().start()), r.xRange().end() + 1),
+        makeIndexRange(prev(r.yRange().start()), r.yRange().end() + 1),
+        makeIndexRange(prev(r.zRange().start()), r.zRange().end() + 1));
+  }
+
+  return region;
+}
+
 Real TFSFCorrector::exInc(Index t, Index i, Index j, Index k) const {
   i = i - globalStartI() + 1;
   j = j - globalStartJ();
@@ -8,6 +8,8 @@ namespace xfdtd {
 WaveformSource::WaveformSource(std::unique_ptr<Waveform> waveform)
     : _waveform{std::move(waveform)} {}
 
+void WaveformSource::nextStep() {}
+
 const std::unique_ptr<Waveform> &WaveformSource::waveform() {
   return _waveform;
 }
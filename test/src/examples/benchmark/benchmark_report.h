@@ -0,0 +1,230 @@
+#ifndef __XFDTD_EXAMPLE_BENCHMARK_REPORT_H__
+#define __XFDTD_EXAMPLE_BENCHMARK_REPORT_H__
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xfdtd::benchmark {
+
+/**
+ * @brief One measurement: `_steps` calls (or time steps) that update `_cells`
+ * cells each.
+ *
+ * `_bytes_per_cell` is the compulsory memory traffic of the kernel per cell:
+ * every array it reads counts once, every array it writes twice, neighbours
+ * are assumed to come from cache. 0 if the kernel has no model.
+ */
+struct Result {
+  std::string _name;
+  std::string _config;
+  std::size_t _cells{0};
+  std::size_t _workers{1};
+  std::size_t _steps{0};
+  double _seconds{0};
+  double _bytes_per_cell{0};
+  double _efficiency{1};
+
+  auto mCellsPerSecond() const {
+    return static_cast<double>(_cells) * static_cast<double>(_steps) /
+           _seconds / 1e6;
+  }
+
+  auto gBytesPerSecond() const {
+    return mCellsPerSecond() * _bytes_per_cell / 1e3;
+  }
+
+  auto key() const { return _name + " " + _config; }
+};
+
+/**
+ * @brief Smallest time of `samples` runs of `repeat` calls of `func`, after
+ * one call to warm up the caches.
+ */
+template <typename F>
+inline auto bestOf(std::size_t samples, std::size_t repeat, F&& func)
+    -> double {
+  func();
+  auto best = std::numeric_limits<double>::max();
+  for (std::size_t s = 0; s < samples; ++s) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repeat; ++r) {
+      func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - start).count());
+  }
+  return best;
+}
+
+/**
+ * @brief A CSV field, quoted when it holds a comma or a quote.
+ */
+inline auto csvField(const std::string& s) -> std::string {
+  if (s.find_first_of(",\"\n") == std::string::npos) {
+    return s;
+  }
+
+  std::string out{"\""};
+  for (auto c : s) {
+    if (c == '"') {
+      out += '"';
+    }
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+/**
+ * @brief Split a CSV line written by Report::writeCsv.
+ */
+inline auto splitCsv(const std::string& line) -> std::vector<std::string> {
+  std::vector<std::string> cols(1);
+  bool quoted{false};
+  for (std::size_t i = 0; i < line.size(); ++i) {
+    const auto c = line[i];
+    if (quoted) {
+      if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+        cols.back() += '"';
+        ++i;
+      } else if (c == '"') {
+        quoted = false;
+      } else {
+        cols.back() += c;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == ',') {
+      cols.emplace_back();
+    } else {
+      cols.back() += c;
+    }
+  }
+  return cols;
+}
+
+/**
+ * @brief Collects the results, prints them as a table and writes them as CSV.
+ *
+ * The scaling efficiency of a result is its throughput per worker over the
+ * throughput per worker of the first result with the same name, so a sweep
+ * should start with the smallest layout.
+ */
+class Report {
+ public:
+  static constexpr std::string_view CSV_HEADER =
+      "name,config,cells,workers,steps,seconds,mcells_per_s,bytes_per_cell,"
+      "gb_per_s,efficiency";
+
+  auto add(Result result) -> void {
+    const auto per_worker =
+        result.mCellsPerSecond() / static_cast<double>(result._workers);
+    auto it = _reference.find(result._name);
+    if (it == _reference.end()) {
+      _reference.emplace(result._name, per_worker);
+      result._efficiency = 1;
+    } else {
+      result._efficiency = per_worker / it->second;
+    }
+
+    print(std::cout, result);
+    _results.emplace_back(std::move(result));
+  }
+
+  auto results() const -> const std::vector<Result>& { return _results; }
+
+  static auto printHeader(std::ostream& os) -> void {
+    os << std::left << std::setw(28) << "name" << std::setw(20) << "config"
+       << std::right << std::setw(12) << "cells" << std::setw(12) << "MCells/s"
+       << std::setw(12) << "bytes/cell" << std::setw(10) << "GB/s"
+       << std::setw(12) << "efficiency" << '\n';
+  }
+
+  static auto print(std::ostream& os, const Result& r) -> void {
+    os << std::left << std::setw(28) << r._name << std::setw(20) << r._config
+       << std::right << std::setw(12) << r._cells << std::setw(12)
+       << std::fixed << std::setprecision(2) << r.mCellsPerSecond();
+    if (r._bytes_per_cell == 0) {
+      os << std::setw(12) << "-" << std::setw(10) << "-";
+    } else {
+      os << std::setw(12) << std::setprecision(1) << r._bytes_per_cell
+         << std::setw(10) << std::setprecision(2) << r.gBytesPerSecond();
+    }
+    os << std::setw(12) << std::setprecision(3) << r._efficiency << '\n';
+    os.unsetf(std::ios::floatfield);
+  }
+
+  auto writeCsv(const std::string& path) const -> void {
+    std::ofstream ofs{path};
+    ofs << CSV_HEADER << '\n';
+    ofs << std::setprecision(9);
+    for (const auto& r : _results) {
+      ofs << csvField(r._name) << ',' << csvField(r._config) << ','
+          << r._cells << ','
+          << r._workers << ',' << r._steps << ',' << r._seconds << ','
+          << r.mCellsPerSecond() << ',' << r._bytes_per_cell << ','
+          << r.gBytesPerSecond() << ',' << r._efficiency << '\n';
+    }
+  }
+
+  /**
+   * @brief Compare with the CSV of an earlier run. A result whose MCells/s
+   * dropped by more than `tolerance` (relative) is reported on `os`.
+   *
+   * @return the number of regressions.
+   * @throw std::runtime_error if the baseline can't be read.
+   */
+  auto compare(const std::string& baseline_path, double tolerance,
+               std::ostream& os) const -> std::size_t {
+    std::ifstream ifs{baseline_path};
+    if (!ifs) {
+      throw std::runtime_error("Can't open baseline " + baseline_path);
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    std::getline(ifs, line);
+    while (std::getline(ifs, line)) {
+      const auto cols = splitCsv(line);
+      if (cols.size() < 7) {
+        continue;
+      }
+      baseline[cols[0] + " " + cols[1]] = std::stod(cols[6]);
+    }
+
+    std::size_t regressions{0};
+    for (const auto& r : _results) {
+      auto it = baseline.find(r.key());
+      if (it == baseline.end()) {
+        continue;
+      }
+
+      const auto ratio = r.mCellsPerSecond() / it->second;
+      if (ratio < 1 - tolerance) {
+        os << "Regression: " << r.key() << " " << it->second << " -> "
+           << r.mCellsPerSecond() << " MCells/s\n";
+        ++regressions;
+      }
+    }
+    return regressions;
+  }
+
+ private:
+  std::vector<Result> _results;
+  std::map<std::string, double> _reference;
+};
+
+}  // namespace xfdtd::benchmark
+
+#endif  // __XFDTD_EXAMPLE_BENCHMARK_REPORT_H__
@@ -0,0 +1,377 @@
+#include <xfdtd/boundary/pml.h>
+#include <xfdtd/common/constant.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/coordinate_system/coordinate_system.h>
+#include <xfdtd/electromagnetic_field/electromagnetic_field.h>
+#include <xfdtd/material/ade_method/debye_ade_method.h>
+#include <xfdtd/material/ade_method/drude_ade_method.h>
+#include <xfdtd/material/ade_method/m_lor_ade_method.h>
+#include <xfdtd/material/dispersive_material.h>
+#include <xfdtd/material/material.h>
+#include <xfdtd/nffft/nffft_frequency_domain.h>
+#include <xfdtd/nffft/nffft_time_domain.h>
+#include <xfdtd/object/object.h>
+#include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/shape/cube.h>
+#include <xfdtd/simulation/simulation.h>
+#include <xfdtd/waveform/waveform.h>
+#include <xfdtd/waveform_source/tfsf_3d.h>
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <xtensor/xbuilder.hpp>
+
+#include "../argparse.hpp"
+#include "benchmark_report.h"
+#include "boundary/fused_pml_corrector.h"
+#include "boundary/pml_corrector.h"
+#include "corrector/corrector.h"
+#include "updator/ade_updator/debye_ade_updator.h"
+#include "updator/ade_updator/drude_ade_updator.h"
+#include "updator/ade_updator/m_lor_ade_updator.h"
+#include "updator/update_scheme.h"
+
+// Microbenchmarks of the update kernels on a cube of n^3 cells. Every kernel
+// is called on the data of an initialized simulation, without the rest of the
+// time step around it.
+
+namespace {
+
+using xfdtd::Index;
+using xfdtd::Real;
+using xfdtd::benchmark::Report;
+using xfdtd::benchmark::Result;
+
+constexpr Index PML_THICKNESS{8};
+constexpr Index TFSF_DISTANCE{12};
+constexpr Index NFFFT_DISTANCE{10};
+constexpr Real DL{5e-3};
+
+struct Options {
+  Index _n;
+  std::size_t _samples;
+  std::size_t _repeat;
+};
+
+auto makeSimulation(Index n, std::shared_ptr<xfdtd::Material> material)
+    -> std::unique_ptr<xfdtd::Simulation> {
+  const auto l = static_cast<Real>(n) * DL;
+  auto s = std::make_unique<xfdtd::Simulation>(DL, DL, DL, 0.9,
+                                               xfdtd::ThreadConfig{1, 1, 1});
+  s->addObject(std::make_shared<xfdtd::Object>(
+      "domain",
+      std::make_unique<xfdtd::Cube>(xfdtd::Vector{-l / 2, -l / 2, -l / 2},
+                                    xfdtd::Vector{l, l, l}),
+      xfdtd::Material::createAir()));
+  if (material != nullptr) {
+    const auto inner = l - 2 * static_cast<Real>(PML_THICKNESS) * DL;
+    s->addObject(std::make_shared<xfdtd::Object>(
+        "dispersive",
+        std::make_unique<xfdtd::Cube>(
+            xfdtd::Vector{-inner / 2, -inner / 2, -inner / 2},
+            xfdtd::Vector{inner, inner, inner}),
+        std::move(material)));
+  }
+
+  for (auto d : {xfdtd::Axis::Direction::XN, xfdtd::Axis::Direction::XP,
+                 xfdtd::Axis::Direction::YN, xfdtd::Axis::Direction::YP,
+                 xfdtd::Axis::Direction::ZN, xfdtd::Axis::Direction::ZP}) {
+    s->addBoundary(std::make_shared<xfdtd::PML>(PML_THICKNESS, d));
+  }
+  return s;
+}
+
+auto nodeTask(const xfdtd::Simulation& s) {
+  const auto& g = s.gridSpace();
+  return xfdtd::makeIndexTask(xfdtd::makeIndexRange(0, g->sizeX()),
+                              xfdtd::makeIndexRange(0, g->sizeY()),
+                              xfdtd::makeIndexRange(0, g->sizeZ()));
+}
+
+// Cells on the faces of the box `distance` cells inside the grid
+auto surfaceCells(Index n, Index distance) -> std::size_t {
+  const auto m = n - 2 * distance;
+  return 6 * m * m;
+}
+
+template <xfdtd::EMF::Attribute attribute, xfdtd::Axis::XYZ xyz>
+auto benchYee(xfdtd::Simulation& s, const Options& o, Report& report) {
+  auto& emf = *s.emf();
+  auto& coeff = *s.calculationParam()->fdtdCoefficient();
+  // E on the inner nodes, H everywhere: inside the bounds of every component
+  const Index start = attribute == xfdtd::EMF::Attribute::E ? 1 : 0;
+  const auto nx = s.gridSpace()->sizeX();
+  const auto ny = s.gridSpace()->sizeY();
+  const auto nz = s.gridSpace()->sizeZ();
+
+  Result r;
+  r._name = std::string{"update<"} +
+            (attribute == xfdtd::EMF::Attribute::E ? "E:" : "H:") +
+            xfdtd::Axis::toString(xyz) + ">";
+  r._config = "n=" + std::to_string(o._n);
+  r._cells = (nx - start) * (ny - start) * (nz - start);
+  r._steps = o._repeat;
+  // field read and written, three coefficients, two dual fields
+  r._bytes_per_cell = 7.0 * sizeof(Real);
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat, [&]() {
+    xfdtd::update<attribute, xyz>(emf, coeff, start, nx, start, ny, start, nz);
+  });
+  report.add(r);
+}
+
+auto benchYee(xfdtd::Simulation& s, const Options& o, Report& report) {
+  using xfdtd::Axis;
+  using xfdtd::EMF;
+  benchYee<EMF::Attribute::E, Axis::XYZ::X>(s, o, report);
+  benchYee<EMF::Attribute::E, Axis::XYZ::Y>(s, o, report);
+  benchYee<EMF::Attribute::E, Axis::XYZ::Z>(s, o, report);
+  benchYee<EMF::Attribute::H, Axis::XYZ::X>(s, o, report);
+  benchYee<EMF::Attribute::H, Axis::XYZ::Y>(s, o, report);
+  benchYee<EMF::Attribute::H, Axis::XYZ::Z>(s, o, report);
+}
+
+auto benchPML(xfdtd::Simulation& s, const Options& o, Report& report) {
+  std::vector<std::unique_ptr<xfdtd::Corrector>> correctors;
+  auto fused = std::make_unique<xfdtd::FusedPMLCorrector>();
+  std::size_t cells{0};
+  for (auto&& b : s.boundaries()) {
+    auto c = b->generateDomainCorrector(nodeTask(s));
+    auto p = dynamic_cast<xfdtd::PMLCorrectorBase*>(c.get());
+    if (p == nullptr) {
+      continue;
+    }
+
+    for (auto a : {xfdtd::EMF::Attribute::E, xfdtd::EMF::Attribute::H}) {
+      for (const auto& t : p->terms(a)) {
+        cells += t._task.xRange().size() * t._task.yRange().size() *
+                 t._task.zRange().size();
+      }
+    }
+    fused->add(*p);
+    correctors.emplace_back(std::move(c));
+  }
+
+  // One psi term per cell: field and psi read and written, c_psi, dual field
+  Result r;
+  r._config = "n=" + std::to_string(o._n);
+  r._cells = cells;
+  r._steps = o._repeat;
+  r._bytes_per_cell = 6.0 * sizeof(Real);
+
+  r._name = "correctPML";
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat, [&]() {
+    for (auto&& c : correctors) {
+      c->correctE();
+      c->correctH();
+    }
+  });
+  report.add(r);
+
+  r._name = "FusedPMLCorrector";
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat, [&]() {
+    fused->correctE();
+    fused->correctH();
+  });
+  report.add(r);
+}
+
+auto benchTFSF(const Options& o, Report& report) {
+  auto s = makeSimulation(o._n, nullptr);
+  auto tfsf = std::make_shared<xfdtd::TFSF3D>(
+      TFSF_DISTANCE, TFSF_DISTANCE, TFSF_DISTANCE, 0, 0, 0,
+      xfdtd::Waveform::gaussian(20 * DL / 6e8, 90 * DL / 6e8));
+  s->addWaveformSource(tfsf);
+  s->init(o._repeat);
+
+  auto c = tfsf->generateCorrector(nodeTask(*s));
+  Result r;
+  r._name = "TFSFCorrector";
+  r._config = "n=" + std::to_string(o._n);
+  r._cells = surfaceCells(o._n, TFSF_DISTANCE);
+  r._steps = o._repeat;
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat, [&]() {
+    c->correctE();
+    c->correctH();
+  });
+  report.add(r);
+}
+
+template <typename U, typename S>
+auto benchADE(std::string name, std::shared_ptr<xfdtd::Material> material,
+              const Options& o, Report& report) {
+  auto s = makeSimulation(o._n, std::move(material));
+  s->init(o._repeat);
+
+  auto storage = std::dynamic_pointer_cast<S>(s->aDEMethodStorage());
+  if (storage == nullptr) {
+    std::cerr << name << ": no ADE storage, skipped\n";
+    return;
+  }
+
+  auto updator = U{s->gridSpace(), s->calculationParam(), s->emf(),
+                   nodeTask(*s), storage};
+  // the updator runs on the whole node, PML included
+  const auto& g = *s->gridSpace();
+  Result r;
+  r._name = std::move(name);
+  r._config = "n=" + std::to_string(o._n);
+  r._cells = g.sizeX() * g.sizeY() * g.sizeZ();
+  r._steps = o._repeat;
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat,
+                                        [&]() { updator.updateE(); });
+  report.add(r);
+}
+
+auto benchADE(const Options& o, Report& report) {
+  using xfdtd::Array1D;
+  constexpr auto pi = xfdtd::constant::PI;
+
+  benchADE<xfdtd::DrudeADEUpdator3D, xfdtd::DrudeADEMethodStorage>(
+      "DrudeADEUpdator3D",
+      xfdtd::DrudeMedium::makeDrudeMedium("drude", 4, Array1D<Real>{pi * 1e9},
+                                          Array1D<Real>{pi * 1.2e9}),
+      o, report);
+
+  benchADE<xfdtd::DebyeADEUpdator3D, xfdtd::DebyeADEMethodStorage>(
+      "DebyeADEUpdator3D",
+      xfdtd::DebyeMedium::makeDebyeMedium("debye", 2, Array1D<Real>{7},
+                                          Array1D<Real>{2e-9 / (2 * pi)}),
+      o, report);
+
+  const auto omega_p = Array1D<Real>{2 * pi * 2e9};
+  const auto nv = Array1D<Real>{pi * 2e9};
+  benchADE<xfdtd::MLorentzUpdator, xfdtd::MLorentzADEMethodStorage>(
+      "MLorentzUpdator",
+      xfdtd::MLorentzMaterial::makeMLorentz(
+          "lorentz", 2, Array1D<Real>{3 * omega_p * omega_p},
+          Array1D<Real>{0}, omega_p * omega_p, 2 * nv, Array1D<Real>{1}),
+      o, report);
+}
+
+auto benchNFFFT(const Options& o, Report& report) {
+  auto s = makeSimulation(o._n, nullptr);
+  xfdtd::Array1D<Real> freq = xt::linspace<Real>(1e9, 3e9, 8);
+  auto fd = std::make_shared<xfdtd::NFFFTFrequencyDomain>(
+      NFFFT_DISTANCE, NFFFT_DISTANCE, NFFFT_DISTANCE, freq);
+  auto td = std::make_shared<xfdtd::NFFFTTimeDomain>(
+      NFFFT_DISTANCE, NFFFT_DISTANCE, NFFFT_DISTANCE, 0, 0);
+  xfdtd::Array1D<Real> theta = xt::linspace<Real>(0, xfdtd::constant::PI, 16);
+  xfdtd::Array1D<Real> phi = xt::zeros<Real>({theta.size()});
+  auto td_multi = std::make_shared<xfdtd::NFFFTTimeDomain>(
+      NFFFT_DISTANCE, NFFFT_DISTANCE, NFFFT_DISTANCE, theta, phi);
+  s->addNF2FF(fd);
+  s->addNF2FF(td);
+  s->addNF2FF(td_multi);
+  s->init(o._repeat + 1);
+
+  Result r;
+  r._config = "n=" + std::to_string(o._n);
+  r._cells = surfaceCells(o._n, NFFFT_DISTANCE);
+  r._steps = o._repeat;
+
+  r._name = "FDPlaneData::update";
+  r._config += " f=" + std::to_string(freq.size());
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat,
+                                        [&]() { fd->update(); });
+  report.add(r);
+
+  r._name = "TDPlaneData::update";
+  r._config = "n=" + std::to_string(o._n);
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat,
+                                        [&]() { td->update(); });
+  report.add(r);
+
+  r._config += " d=" + std::to_string(theta.size());
+  r._seconds = xfdtd::benchmark::bestOf(o._samples, o._repeat,
+                                        [&]() { td_multi->update(); });
+  report.add(r);
+}
+
+auto kernelBenchmark(int argc, char* argv[]) -> int {
+  auto program = argparse::ArgumentParser("kernel_benchmark");
+  program.add_argument("-n", "--size")
+      .help("Number of cells along each axis")
+      .default_value(64)
+      .scan<'d', int>();
+
+  program.add_argument("-s", "--samples")
+      .help("Number of timed samples, the fastest is reported")
+      .default_value(3)
+      .scan<'d', int>();
+
+  program.add_argument("-r", "--repeat")
+      .help("Number of calls in a sample")
+      .default_value(10)
+      .scan<'d', int>();
+
+  program.add_argument("-o", "--output")
+      .help("Write the results to this CSV file")
+      .default_value(std::string{});
+
+  program.add_argument("-b", "--baseline")
+      .help("Compare with the CSV of an earlier run")
+      .default_value(std::string{});
+
+  program.add_argument("--tolerance")
+      .help("Relative slowdown reported as a regression")
+      .default_value(0.1)
+      .scan<'g', double>();
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::stringstream ss;
+    ss << err.what() << '\n';
+    ss << program << '\n';
+    std::cerr << ss.str();
+    return 1;
+  }
+
+  const auto n = program.get<int>("-n");
+  if (n <= static_cast<int>(2 * TFSF_DISTANCE)) {
+    std::cerr << "The size must be larger than " << 2 * TFSF_DISTANCE << '\n';
+    return 1;
+  }
+
+  const auto o = Options{static_cast<Index>(n),
+                         static_cast<std::size_t>(program.get<int>("-s")),
+                         static_cast<std::size_t>(program.get<int>("-r"))};
+
+  Report report;
+  Report::printHeader(std::cout);
+  {
+    auto s = makeSimulation(o._n, nullptr);
+    s->init(o._repeat);
+    benchYee(*s, o, report);
+    benchPML(*s, o, report);
+  }
+  benchTFSF(o, report);
+  benchADE(o, report);
+  benchNFFFT(o, report);
+
+  if (const auto output = program.get<std::string>("-o"); !output.empty()) {
+    report.writeCsv(output);
+  }
+  if (const auto baseline = program.get<std::string>("-b"); !baseline.empty()) {
+    try {
+      if (report.compare(baseline, program.get<double>("--tolerance"),
+                         std::cout) != 0) {
+        return 2;
+      }
+    } catch (const std::runtime_error& err) {
+      std::cerr << err.what() << '\n';
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  xfdtd::MpiSupport::init(argc, argv);
+  return kernelBenchmark(argc, argv);
+}
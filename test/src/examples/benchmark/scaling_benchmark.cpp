@@ -0,0 +1,287 @@
+#include <xfdtd/boundary/pml.h>
+#include <xfdtd/common/constant.h>
+#include <xfdtd/common/type_define.h>
+#include <xfdtd/coordinate_system/coordinate_system.h>
+#include <xfdtd/exception/exception.h>
+#include <xfdtd/material/dispersive_material.h>
+#include <xfdtd/material/material.h>
+#include <xfdtd/nffft/nffft_frequency_domain.h>
+#include <xfdtd/object/object.h>
+#include <xfdtd/parallel/mpi_support.h>
+#include <xfdtd/parallel/parallelized_config.h>
+#include <xfdtd/shape/cube.h>
+#include <xfdtd/simulation/simulation.h>
+#include <xfdtd/waveform/waveform.h>
+#include <xfdtd/waveform_source/tfsf_3d.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <xtensor/xbuilder.hpp>
+
+#include "../argparse.hpp"
+#include "benchmark_report.h"
+
+// End to end time steps over a sweep of scenarios, grid sizes and thread
+// layouts. The MPI layout is fixed per run (-m_c): run the benchmark once per
+// layout and compare the CSV files, the `workers` column holds ranks times
+// threads.
+
+namespace {
+
+using xfdtd::Index;
+using xfdtd::Real;
+using xfdtd::benchmark::Report;
+using xfdtd::benchmark::Result;
+
+constexpr Index PML_THICKNESS{8};
+constexpr Index TFSF_DISTANCE{12};
+constexpr Index NFFFT_DISTANCE{10};
+constexpr Real DL{5e-3};
+
+struct Setup {
+  std::string _scenario;
+  Index _n;
+  std::array<int, 3> _threads;
+  bool _fused_pml;
+  Index _tile_size;
+};
+
+auto parseLayout(const std::string& s) -> std::array<int, 3> {
+  std::array<int, 3> layout{1, 1, 1};
+  std::stringstream ss{s};
+  std::string v;
+  for (auto&& l : layout) {
+    if (!std::getline(ss, v, 'x')) {
+      break;
+    }
+    l = std::stoi(v);
+  }
+  return layout;
+}
+
+auto makeSimulation(const Setup& setup) -> std::unique_ptr<xfdtd::Simulation> {
+  const auto l = static_cast<Real>(setup._n) * DL;
+  auto s = std::make_unique<xfdtd::Simulation>(
+      DL, DL, DL, 0.9,
+      xfdtd::ThreadConfig{setup._threads[0], setup._threads[1],
+                          setup._threads[2]});
+  s->addObject(std::make_shared<xfdtd::Object>(
+      "domain",
+      std::make_unique<xfdtd::Cube>(xfdtd::Vector{-l / 2, -l / 2, -l / 2},
+                                    xfdtd::Vector{l, l, l}),
+      xfdtd::Material::createAir()));
+
+  const auto& scenario = setup._scenario;
+  if (scenario == "air") {
+    return s;
+  }
+
+  for (auto d : {xfdtd::Axis::Direction::XN, xfdtd::Axis::Direction::XP,
+                 xfdtd::Axis::Direction::YN, xfdtd::Axis::Direction::YP,
+                 xfdtd::Axis::Direction::ZN, xfdtd::Axis::Direction::ZP}) {
+    s->addBoundary(std::make_shared<xfdtd::PML>(PML_THICKNESS, d));
+  }
+  if (setup._fused_pml) {
+    s->enableFusedPML();
+  }
+
+  if (scenario == "scatter" || scenario == "drude") {
+    const auto r = l / 8;
+    std::shared_ptr<xfdtd::Material> material;
+    if (scenario == "scatter") {
+      material = std::make_shared<xfdtd::Material>(
+          "dielectric", xfdtd::ElectroMagneticProperty{4, 1, 0, 0});
+    } else {
+      constexpr auto pi = xfdtd::constant::PI;
+      material = xfdtd::DrudeMedium::makeDrudeMedium(
+          "drude", 4, xfdtd::Array1D<Real>{pi * 1e9},
+          xfdtd::Array1D<Real>{pi * 1.2e9});
+    }
+    s->addObject(std::make_shared<xfdtd::Object>(
+        "scatterer",
+        std::make_unique<xfdtd::Cube>(xfdtd::Vector{-r, -r, -r},
+                                      xfdtd::Vector{2 * r, 2 * r, 2 * r}),
+        material));
+
+    s->addWaveformSource(std::make_shared<xfdtd::TFSF3D>(
+        TFSF_DISTANCE, TFSF_DISTANCE, TFSF_DISTANCE, 0, 0, 0,
+        xfdtd::Waveform::gaussian(20 * DL / 6e8, 90 * DL / 6e8)));
+    xfdtd::Array1D<Real> freq = xt::linspace<Real>(1e9, 3e9, 8);
+    s->addNF2FF(std::make_shared<xfdtd::NFFFTFrequencyDomain>(
+        NFFFT_DISTANCE, NFFFT_DISTANCE, NFFFT_DISTANCE, freq));
+  }
+
+  if (setup._tile_size != 0 && scenario != "drude") {
+    s->enableFusedSweep(setup._tile_size);
+  }
+  return s;
+}
+
+auto configString(const Setup& setup) -> std::string {
+  const auto& mpi = xfdtd::MpiSupport::instance();
+  std::stringstream ss;
+  ss << "t" << setup._threads[0] << "x" << setup._threads[1] << "x"
+     << setup._threads[2] << " r" << mpi.size();
+  if (setup._fused_pml) {
+    ss << " fused";
+  }
+  if (setup._tile_size != 0) {
+    ss << " tile" << setup._tile_size;
+  }
+  return ss.str();
+}
+
+auto run(const Setup& setup, Index steps) -> std::optional<Result> {
+  auto& mpi = xfdtd::MpiSupport::instance();
+  auto s = makeSimulation(setup);
+  try {
+    s->init(steps);
+  } catch (const xfdtd::XFDTDException& e) {
+    if (mpi.isRoot()) {
+      std::cerr << setup._scenario << " " << configString(setup)
+                << " skipped: " << e.what() << '\n';
+    }
+    return std::nullopt;
+  }
+
+  mpi.barrier();
+  const auto start = std::chrono::steady_clock::now();
+  s->run();
+  mpi.barrier();
+  const auto end = std::chrono::steady_clock::now();
+
+  const auto& g = s->gridSpace()->globalGridSpace();
+  Result r;
+  r._name = setup._scenario + " n=" + std::to_string(setup._n);
+  r._config = configString(setup);
+  r._cells = g->sizeX() * g->sizeY() * g->sizeZ();
+  r._workers = static_cast<std::size_t>(s->numThread() * s->numNode());
+  r._steps = steps;
+  r._seconds = std::chrono::duration<double>(end - start).count();
+  // Yee update: per component the field read and written, three coefficients
+  // and two dual fields
+  r._bytes_per_cell = 6 * 7.0 * sizeof(Real);
+  return r;
+}
+
+auto scalingBenchmark(int argc, char* argv[]) -> int {
+  auto program = argparse::ArgumentParser("scaling_benchmark");
+  program.add_argument("-t", "--time_steps")
+      .help("Number of time steps")
+      .default_value(100)
+      .scan<'d', int>();
+
+  program.add_argument("--scenarios")
+      .help("air, pml, scatter (dielectric, TFSF, NF2FF) or drude")
+      .default_value(std::vector<std::string>{"air", "pml", "scatter"})
+      .nargs(argparse::nargs_pattern::at_least_one);
+
+  program.add_argument("-n", "--sizes")
+      .help("Number of cells along each axis")
+      .default_value(std::vector<int>{48, 96})
+      .nargs(argparse::nargs_pattern::at_least_one)
+      .scan<'d', int>();
+
+  program.add_argument("-t_c", "--thread_configs")
+      .help("Thread layouts, as NXxNYxNZ")
+      .default_value(std::vector<std::string>{"1x1x1", "2x1x1"})
+      .nargs(argparse::nargs_pattern::at_least_one);
+
+  program.add_argument("-m_c", "--mpi_config")
+      .help("MPI configuration")
+      .default_value(std::vector<int>{1, 1, 1})
+      .nargs(3)
+      .scan<'d', int>();
+
+  program.add_argument("--fused_pml")
+      .help("Enable the fused PML corrector")
+      .default_value(false)
+      .implicit_value(true);
+
+  program.add_argument("--tile_size")
+      .help("Enable the fused H and E sweep with this tile size")
+      .default_value(0)
+      .scan<'d', int>();
+
+  program.add_argument("-o", "--output")
+      .help("Write the results to this CSV file")
+      .default_value(std::string{});
+
+  program.add_argument("-b", "--baseline")
+      .help("Compare with the CSV of an earlier run")
+      .default_value(std::string{});
+
+  program.add_argument("--tolerance")
+      .help("Relative slowdown reported as a regression")
+      .default_value(0.1)
+      .scan<'g', double>();
+
+  auto& mpi = xfdtd::MpiSupport::instance();
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::stringstream ss;
+    ss << err.what() << '\n';
+    ss << program << '\n';
+    std::cerr << ss.str();
+    mpi.abort(1);
+  }
+
+  const auto steps = static_cast<Index>(program.get<int>("-t"));
+  const auto mpi_config = program.get<std::vector<int>>("-m_c");
+  xfdtd::MpiSupport::setMpiParallelDim(mpi_config[0], mpi_config[1],
+                                       mpi_config[2]);
+
+  Report report;
+  if (mpi.isRoot()) {
+    Report::printHeader(std::cout);
+  }
+  for (const auto& scenario :
+       program.get<std::vector<std::string>>("--scenarios")) {
+    for (auto n : program.get<std::vector<int>>("-n")) {
+      for (const auto& t :
+           program.get<std::vector<std::string>>("--thread_configs")) {
+        const auto setup =
+            Setup{scenario, static_cast<Index>(n), parseLayout(t),
+                  program.get<bool>("--fused_pml"),
+                  static_cast<Index>(program.get<int>("--tile_size"))};
+        auto r = run(setup, steps);
+        if (r.has_value() && mpi.isRoot()) {
+          report.add(std::move(*r));
+        }
+      }
+    }
+  }
+
+  if (!mpi.isRoot()) {
+    return 0;
+  }
+  if (const auto output = program.get<std::string>("-o"); !output.empty()) {
+    report.writeCsv(output);
+  }
+  if (const auto baseline = program.get<std::string>("-b"); !baseline.empty()) {
+    try {
+      if (report.compare(baseline, program.get<double>("--tolerance"),
+                         std::cout) != 0) {
+        return 2;
+      }
+    } catch (const std::runtime_error& err) {
+      std::cerr << err.what() << '\n';
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  xfdtd::MpiSupport::init(argc, argv);
+  return scalingBenchmark(argc, argv);
+}
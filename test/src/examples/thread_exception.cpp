@@ -0,0 +1,65 @@
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "xfdtd/coordinate_system/coordinate_system.h"
+#include "xfdtd/material/material.h"
+#include "xfdtd/object/object.h"
+#include "xfdtd/parallel/mpi_support.h"
+#include "xfdtd/parallel/parallelized_config.h"
+#include "xfdtd/shape/cube.h"
+#include "xfdtd/simulation/simulation.h"
+#include "xfdtd/simulation/simulation_flag.h"
+
+// An exception thrown in one domain must reach the caller of run(): the other
+// threads leave the barrier instead of waiting for the failed one forever.
+
+constexpr static xfdtd::Real SIZE{1e-3};
+constexpr static xfdtd::Index FAIL_STEP{3};
+
+// Flag visitors are called by the master domain only
+class FailingVisitor : public xfdtd::SimulationFlagVisitor {
+ public:
+  auto initStep(xfdtd::SimulationInitFlag flag) -> void override {}
+
+  auto iteratorStep(xfdtd::SimulationIteratorFlag flag, xfdtd::Index cur,
+                    xfdtd::Index start, xfdtd::Index end) -> void override {
+    if (flag == xfdtd::SimulationIteratorFlag::NextStep && cur == FAIL_STEP) {
+      throw std::runtime_error("failing visitor");
+    }
+  }
+};
+
+auto threadException() -> int {
+  auto domain{std::make_shared<xfdtd::Object>(
+      "domain",
+      std::make_unique<xfdtd::Cube>(
+          xfdtd::Vector{-10 * SIZE, -10 * SIZE, -10 * SIZE},
+          xfdtd::Vector{20 * SIZE, 20 * SIZE, 20 * SIZE}),
+      xfdtd::Material::createAir())};
+
+  auto simulation{
+      xfdtd::Simulation{SIZE, SIZE, SIZE, 0.98, xfdtd::ThreadConfig{4, 1, 1}}};
+  simulation.addObject(domain);
+  simulation.addVisitor(std::make_shared<FailingVisitor>());
+
+  try {
+    simulation.run(10);
+  } catch (const std::runtime_error& e) {
+    if (std::string{e.what()} != "failing visitor") {
+      std::cerr << "Unexpected exception: " << e.what() << '\n';
+      return 1;
+    }
+
+    return 0;
+  }
+
+  std::cerr << "run() returned without the exception of the visitor\n";
+  return 1;
+}
+
+int main(int argc, char* argv[]) {
+  xfdtd::MpiSupport::init(argc, argv);
+  return threadException();
+}